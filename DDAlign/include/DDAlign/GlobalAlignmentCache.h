@@ -34,6 +34,13 @@ namespace dd4hep {
      *  Internaly the instances are fragmented to subdetectors defined
      *  by the next-to-top level detector elements.
      *
+     *  In bulk mode an alignment stack is applied in phases: the affected
+     *  physical nodes are selected with sorted lookups, shared parent
+     *  matrices are reset only once, the alignments are applied ordered by
+     *  the depth of the placement path and the overlap checks (which require
+     *  the voxels of the mother volume to be rebuilt) are deferred until
+     *  the complete stack is applied. The time spent in each phase is reported.
+     *
      *  \author   M.Frank
      *  \version  1.0
      *  \ingroup  DD4HEP_ALIGN
@@ -48,6 +55,17 @@ namespace dd4hep {
       typedef Stack::StackEntry                           Entry;
       typedef std::map<unsigned int, TGeoPhysicalNode*>   Cache;
       typedef std::map<std::string,GlobalAlignmentCache*> SubdetectorAlignments;
+      typedef std::vector<std::pair<TGeoPhysicalNode*,double> > OverlapChecks;
+
+      /// Time spent in the phases of the bulk application [seconds]
+      /**
+       *  \version  1.0
+       *  \ingroup  DD4HEP_ALIGN
+       */
+      class BulkTimer  {
+      public:
+        double select = 0e0, reset = 0e0, align = 0e0, check = 0e0, refresh = 0e0, update = 0e0;
+      };
 
     protected:
       Detector&       m_detDesc;
@@ -64,6 +82,10 @@ namespace dd4hep {
       int         m_refCount;
       /// Flag to indicate the top instance
       bool        m_top;
+      /// Flag to apply alignment stacks in bulk mode
+      bool        m_bulk;
+      /// Bulk mode: overlap checks deferred until the complete stack is applied
+      OverlapChecks m_overlapChecks;
 
     protected:
       /// Default constructor initializing variables
@@ -78,6 +100,10 @@ namespace dd4hep {
       void apply(GlobalAlignmentStack& stack);
       /// Apply a vector of SD entries of ordered alignments to the geometry structure
       void apply(const std::vector<Entry*> &changes);
+      /// Bulk mode: Apply a vector of SD entries of ordered alignments to the geometry structure
+      void apply(const std::vector<Entry*> &changes, BulkTimer& timer);
+      /// Bulk mode: Execute the deferred overlap checks of this section
+      void checkOverlaps();
       /// Add a new entry to the cache. The key is the placement path
       bool insert(GlobalAlignment alignment);
 
@@ -92,6 +118,10 @@ namespace dd4hep {
       int release();
       /// Access the section name
       const std::string& name() const   {   return m_sdPath;  }
+      /// Access the bulk mode flag
+      bool bulkMode() const             {   return m_bulk;    }
+      /// Enable or disable the bulk application of alignment stacks
+      void setBulkMode(bool value)      {   m_bulk = value;   }
       /// Close existing transaction stack and apply all alignments
       void commit(GlobalAlignmentStack& stack);
       /// Retrieve the cache section corresponding to the path of an entry.
@@ -44,6 +44,8 @@ namespace dd4hep {
       GlobalAlignmentOperator(GlobalAlignmentCache& c, Nodes& n) : cache(c), nodes(n) {}
       /// Insert alignment entry
       void insert(GlobalAlignment alignment)  const;
+      /// Access the overlap checks deferred by the bulk mode
+      GlobalAlignmentCache::OverlapChecks& overlapChecks()  const;
     };
 
     /// Select alignment operations according to certain criteria
@@ -95,6 +97,7 @@ namespace dd4hep {
       class node_print;
       class node_reset;
       class node_align;
+      class node_align_deferred;
       class node_delete;
     }
 
@@ -104,6 +107,7 @@ namespace dd4hep {
     template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_delete>::operator()(Nodes::value_type& n)  const;
     template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_reset>::operator() (Nodes::value_type& n)  const;
     template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align>::operator() (Nodes::value_type& n)  const;
+    template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align_deferred>::operator() (Nodes::value_type& n)  const;
   }       /* End namespace align                    */
 }         /* End namespace dd4hep                        */
 #endif    /* DD4HEP_ALIGNMENT_GLOBALALIGNMENTOPERATORS_H */
@@ -20,6 +20,13 @@
 
 // ROOT include files
 #include "TGeoManager.h"
+#include "TGeoPhysicalNode.h"
+#include "TGeoVoxelFinder.h"
+#include "TTimeStamp.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <set>
 
 using namespace std;
 using namespace dd4hep;
@@ -39,9 +46,66 @@ DetElement _detector(DetElement child)   {
   throw runtime_error("dd4hep: DetElement cannot determine detector parent [Invalid handle]");
 }
 
+namespace {
+
+  /// Time difference in seconds since the start time stamp
+  double elapsed(const TTimeStamp& start)   {
+    TTimeStamp now;
+    return now.AsDouble() - start.AsDouble();
+  }
+
+  /// Number of levels of a placement path
+  size_t path_depth(const string& path)   {
+    return count(path.begin(), path.end(), '/');
+  }
+
+  /// Bulk mode: reset a physical node to the original matrices (see node_reset)
+  /** Intermediate matrices shared by several nodes are only restored once.
+   */
+  void reset_node(const GlobalAlignmentCache& cache, TGeoPhysicalNode* p,
+                  map<string,TGeoPhysicalNode*>& lookups, set<TGeoMatrix*>& restored)
+  {
+    string np;
+    if ( p->IsAligned() )   {
+      for (Int_t i=0, nLvl=p->GetLevel(); i<=nLvl; i++) {
+        TGeoNode* node = p->GetNode(i);
+        TGeoMatrix* mm = node->GetMatrix();  // Node's relative matrix
+        np += string("/")+node->GetName();
+        if ( !mm->IsIdentity() && i > 0 )  {    // Ignore the 'world', is identity anyhow
+          map<string,TGeoPhysicalNode*>::const_iterator j = lookups.find(np);
+          if ( j == lookups.end() )
+            j = lookups.insert(make_pair(np,cache.get(np).ptr())).first;
+          GlobalAlignment a((*j).second);
+          if ( a.isValid() )  {
+            printout(DEBUG,"GlobalAlignmentActor<reset>","Correct path:%s leaf:%s",p->GetName(),np.c_str());
+            TGeoHMatrix* glob = p->GetMatrix(i-1);
+            if ( i!=nLvl )   {
+              if ( restored.insert(mm).second )
+                *mm = *(a->GetOriginalMatrix());
+            }
+            else  {
+              TGeoHMatrix* hm = dynamic_cast<TGeoHMatrix*>(mm);
+              TGeoMatrix*  org = p->GetOriginalMatrix();
+              if ( hm && org )  {
+                hm->SetTranslation(org->GetTranslation());
+                hm->SetRotation(org->GetRotationMatrix());
+              }
+              else  {
+                printout(ALWAYS,"GlobalAlignmentActor<reset>",
+                         "Invalid operation: %p %p", (void*)hm, (void*)org);
+              }
+            }
+            *glob *= *mm;
+          }
+        }
+      }
+    }
+  }
+}
+
 /// Default constructor
 GlobalAlignmentCache::GlobalAlignmentCache(Detector& description, const string& sdPath, bool top)
-  : m_detDesc(description), m_sdPath(sdPath), m_sdPathLen(sdPath.length()), m_refCount(1), m_top(top)
+  : m_detDesc(description), m_sdPath(sdPath), m_sdPathLen(sdPath.length()), m_refCount(1), m_top(top), m_bulk(false)
 {
 }
 
@@ -93,7 +157,7 @@ bool GlobalAlignmentCache::insert(GlobalAlignment alignment)  {
   TGeoPhysicalNode* pn = alignment.ptr();
   unsigned int index = detail::hash32(pn->GetName()+m_sdPathLen);
   Cache::const_iterator i = m_cache.find(index);
-  printout(ALWAYS,"GlobalAlignmentCache","Section: %s adding entry: %s",
+  printout(m_bulk ? DEBUG : ALWAYS,"GlobalAlignmentCache","Section: %s adding entry: %s",
            name().c_str(),alignment->GetName());
   if ( i == m_cache.end() )   {
     m_cache[index] = pn;
@@ -199,17 +263,39 @@ void GlobalAlignmentCache::apply(GlobalAlignmentStack& stack)    {
       detelt_updates.insert(make_pair(e->detector.path(),e->detector));
     }
   }
+  BulkTimer  timer;
+  TTimeStamp start;
+  size_t     num_entries = 0;
+  vector<GlobalAlignmentCache*> sections;
   for(sd_entries_t::iterator i=all.begin(); i!=all.end(); ++i)  {
     DetElement det((*i).first);
     GlobalAlignmentCache* sd_cache = subdetectorAlignments(det.placement().name());
-    sd_cache->apply( (*i).second );
+    num_entries += (*i).second.size();
+    if ( m_bulk )  {
+      sd_cache->m_bulk = true;
+      sd_cache->apply( (*i).second, timer );
+      sections.push_back(sd_cache);
+    }
+    else  {
+      sd_cache->apply( (*i).second );
+    }
     (*i).second.clear();
   }
+  if ( m_bulk )  {
+    // All alignments are applied: now the overlap checks can be executed
+    start.Set();
+    for(GlobalAlignmentCache* sd_cache : sections)
+      sd_cache->checkOverlaps();
+    timer.check = elapsed(start);
+  }
 
   printout(INFO,"GlobalAlignmentCache","Alignments were applied. Refreshing physical nodes....");
+  start.Set();
   mgr.GetCurrentNavigator()->ResetAll();
   mgr.GetCurrentNavigator()->BuildCache();
   mgr.RefreshPhysicalNodes();
+  timer.refresh = elapsed(start);
+  start.Set();
 
   // Provide update callback for every detector element with a changed placement
   for(DetElementUpdates::iterator i=detelt_updates.begin(); i!=detelt_updates.end(); ++i)  {
@@ -234,6 +320,14 @@ void GlobalAlignmentCache::apply(GlobalAlignmentStack& stack)    {
     printout(DEBUG,"GlobalAlignmentCache","+++ Trigger placement update for %s [0]",elt.path().c_str());
     elt->update(DetElement::PLACEMENT_CHANGED|DetElement::PLACEMENT_DETECTOR,elt.ptr());
   }
+  if ( m_bulk )  {
+    timer.update = elapsed(start);
+    printout(INFO,"GlobalAlignmentCache",
+             "Bulk application of %ld entries in %ld section(s) [seconds]: Select:%.4f Reset:%.4f "
+             "Align:%.4f Check:%.4f Refresh:%.4f Update:%.4f",
+             num_entries, sections.size(), timer.select, timer.reset,
+             timer.align, timer.check, timer.refresh, timer.update);
+  }
 }
 
 /// Apply a vector of SD entries of ordered alignments to the geometry structure
@@ -249,3 +343,106 @@ void GlobalAlignmentCache::apply(const vector<Entry*>& changes)   {
   for_each(nodes.begin(),nodes.end(),GlobalAlignmentActor<node_align>(*this,nodes));
   for_each(nodes.begin(),nodes.end(),GlobalAlignmentActor<node_delete>(*this,nodes));
 }
+
+/// Bulk mode: Apply a vector of SD entries of ordered alignments to the geometry structure
+void GlobalAlignmentCache::apply(const vector<Entry*>& changes, BulkTimer& timer)   {
+  typedef map<string,pair<TGeoPhysicalNode*,Entry*> > Nodes;
+  typedef vector<pair<string,TGeoPhysicalNode*> >      Sorted;
+  TTimeStamp start;
+  Sorted     sorted;
+  Nodes      nodes;
+
+  // Select the nodes to be reset. Sorted by path the children of a node follow their parent:
+  // for every entry a binary search replaces the scan over the entire cache.
+  sorted.reserve(m_cache.size());
+  for(Cache::const_iterator i=m_cache.begin(); i!=m_cache.end(); ++i)
+    sorted.push_back(make_pair(string((*i).second->GetName()),(*i).second));
+  sort(sorted.begin(), sorted.end());
+  for(Entry* e : changes)  {
+    if ( GlobalAlignmentStack::needsReset(*e) || GlobalAlignmentStack::hasMatrix(*e) )  {
+      const string& path = e->path;
+      Sorted::const_iterator i = lower_bound(sorted.begin(), sorted.end(),
+                                             make_pair(path,(TGeoPhysicalNode*)0));
+      if ( GlobalAlignmentStack::resetChildren(*e) )  {
+        for( ; i != sorted.end() && 0 == (*i).first.compare(0,path.length(),path); ++i )
+          nodes.insert(make_pair((*i).first,make_pair((*i).second,e)));
+      }
+      else if ( i != sorted.end() && (*i).first == path )  {
+        nodes.insert(make_pair((*i).first,make_pair((*i).second,e)));
+      }
+    }
+  }
+  timer.select += elapsed(start);
+
+  // Reset the selected nodes. Shared parent matrices are restored only once.
+  start.Set();
+  map<string,TGeoPhysicalNode*> lookups;
+  set<TGeoMatrix*> restored;
+  printout(INFO,"GlobalAlignmentCache","Section: %s reset %ld node(s) for %ld entrie(s)",
+           name().c_str(), nodes.size(), changes.size());
+  for(Nodes::value_type& n : nodes)
+    reset_node(*this, n.second.first, lookups, restored);
+  timer.reset += elapsed(start);
+
+  // Apply the alignments: parents before their children, one entry per path
+  start.Set();
+  vector<Entry*> duplicates;
+  vector<pair<size_t,Nodes::value_type*> > ordered;
+  nodes.clear();
+  for(Entry* e : changes)  {
+    if ( !nodes.insert(make_pair(e->path,make_pair((TGeoPhysicalNode*)0,e))).second )
+      duplicates.push_back(e);
+  }
+  ordered.reserve(nodes.size());
+  for(Nodes::value_type& n : nodes)
+    ordered.push_back(make_pair(path_depth(n.first),&n));
+  stable_sort(ordered.begin(), ordered.end(),
+              [](const pair<size_t,Nodes::value_type*>& a, const pair<size_t,Nodes::value_type*>& b)
+              { return a.first < b.first; });
+  GlobalAlignmentActor<node_align_deferred> align(*this,nodes);
+  for(const auto& o : ordered)
+    align(*o.second);
+  for_each(nodes.begin(),nodes.end(),GlobalAlignmentActor<node_delete>(*this,nodes));
+  for(Entry* e : duplicates)
+    delete e;
+  timer.align += elapsed(start);
+}
+
+/// Bulk mode: Execute the deferred overlap checks of this section
+void GlobalAlignmentCache::checkOverlaps()   {
+  TGeoManager&     mgr = m_detDesc.manager();
+  set<TGeoVolume*> mothers;
+
+  for(const OverlapChecks::value_type& c : m_overlapChecks)  {
+    TGeoPhysicalNode* pn    = c.first;
+    Int_t             level = pn->GetLevel();
+    TGeoVolume*       mother = level > 0 ? pn->GetVolume(level-1) : 0;
+    // The voxels of every mother volume are rebuilt only once for all its daughters
+    if ( mother && mothers.insert(mother).second )  {
+      TGeoVoxelFinder* voxels = mother->GetVoxels();
+      if ( voxels && voxels->NeedRebuild() )  {
+        voxels->Voxelize();
+        voxels->SetNeedRebuild(kFALSE);
+        mother->FindOverlaps();
+      }
+    }
+    TGeoNode* node = pn->GetNode();
+    if ( node->IsOverlapping() )  {
+      printout(INFO,"GlobalAlignmentCache","+++ Node %s is declared overlapping: no overlap check.",
+               pn->GetName());
+      continue;
+    }
+    // Check against the first parent which is not an assembly (as TGeoPhysicalNode::Align)
+    TGeoNode* parent = 0;
+    for(Int_t i=level-1; i>=0; --i)  {
+      parent = pn->GetNode(i);
+      if ( !parent->GetVolume()->IsAssembly() ) break;
+    }
+    if ( parent )  {
+      mgr.SetCheckedNode(node);
+      parent->CheckOverlaps(c.second,"d");
+      mgr.SetCheckedNode(0);
+    }
+  }
+  m_overlapChecks.clear();
+}
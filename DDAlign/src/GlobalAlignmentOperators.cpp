@@ -31,6 +31,10 @@ void GlobalAlignmentOperator::insert(GlobalAlignment alignment)  const   {
   }
 }
 
+GlobalAlignmentCache::OverlapChecks& GlobalAlignmentOperator::overlapChecks()  const   {
+  return cache.m_overlapChecks;
+}
+
 void GlobalAlignmentSelector::operator()(Entries::value_type e)  const {
   TGeoPhysicalNode* pn = 0;
   nodes.insert(make_pair(e->path,make_pair(pn,e)));
@@ -108,52 +112,70 @@ template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_reset>::
   }
 }
 
-template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align>::operator()(Nodes::value_type& n) const  {
-  Entry&     e       = *n.second.second;
-  bool       overlap = GlobalAlignmentStack::overlapDefined(e);
-  DetElement det     = e.detector;
-
-  if ( !det->global_alignment.isValid() && !GlobalAlignmentStack::hasMatrix(e) )  {
-    printout(WARNING,"GlobalAlignmentActor","++++ SKIP Alignment %s DE:%s Valid:%s Matrix:%s",
-             e.path.c_str(),det.placementPath().c_str(),
-             yes_no(det->global_alignment.isValid()), yes_no(GlobalAlignmentStack::hasMatrix(e)));
-    return;
-  }
-  if ( GlobalDetectorAlignment::debug() )  {
-    printout(INFO,"GlobalAlignmentActor","++++ %s DE:%s Matrix:%s",
-             e.path.c_str(),det.placementPath().c_str(),yes_no(GlobalAlignmentStack::hasMatrix(e)));
-  }
-  // Need to care about optional arguments 'check_overlaps' and 'overlap'
-  GlobalDetectorAlignment ad(det);
-  GlobalAlignment   align;
-  Transform3D       trafo;
-  const Delta&      delta  = e.delta;
-  bool              no_vol = e.path == det.placementPath();
-  double            ovl_precision = e.overlap;
-
-  if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_PIVOT|Delta::HAVE_TRANSLATION) )
-    trafo = Transform3D(Translation3D(delta.translation)*delta.pivot*delta.rotation*(delta.pivot.Inverse()));
-  else if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_TRANSLATION) )
-    trafo = Transform3D(delta.rotation,delta.translation);
-  else if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_PIVOT) )
-    trafo = Transform3D(delta.pivot*delta.rotation*(delta.pivot.Inverse()));
-  else if ( delta.checkFlag(Delta::HAVE_ROTATION) )
-    trafo = Transform3D(delta.rotation);
-  else if ( delta.checkFlag(Delta::HAVE_TRANSLATION) )
-    trafo = Transform3D(delta.translation);
-
-  if ( GlobalAlignmentStack::checkOverlap(e) && overlap )
-    align = no_vol ? ad.align(trafo,ovl_precision,e.overlap) : ad.align(e.path,trafo,ovl_precision,e.overlap);
-  else if ( GlobalAlignmentStack::checkOverlap(e) )
-    align = no_vol ? ad.align(trafo,ovl_precision) : ad.align(e.path,trafo,ovl_precision);
-  else
-    align = no_vol ? ad.align(trafo) : ad.align(e.path,trafo);
-
-  if ( align.isValid() )  {
-    insert(align);
-    return;
+namespace {
+  /// Apply the alignment of one entry. Optionally defer the overlap check to the cache
+  void align_entry(const GlobalAlignmentOperator& op, GlobalAlignmentOperator::Entry& e,
+                   GlobalAlignmentCache::OverlapChecks* deferred)  {
+    bool       overlap = GlobalAlignmentStack::overlapDefined(e);
+    DetElement det     = e.detector;
+
+    if ( !det->global_alignment.isValid() && !GlobalAlignmentStack::hasMatrix(e) )  {
+      printout(WARNING,"GlobalAlignmentActor","++++ SKIP Alignment %s DE:%s Valid:%s Matrix:%s",
+               e.path.c_str(),det.placementPath().c_str(),
+               yes_no(det->global_alignment.isValid()), yes_no(GlobalAlignmentStack::hasMatrix(e)));
+      return;
+    }
+    if ( GlobalDetectorAlignment::debug() )  {
+      printout(INFO,"GlobalAlignmentActor","++++ %s DE:%s Matrix:%s",
+               e.path.c_str(),det.placementPath().c_str(),yes_no(GlobalAlignmentStack::hasMatrix(e)));
+    }
+    // Need to care about optional arguments 'check_overlaps' and 'overlap'
+    GlobalDetectorAlignment ad(det);
+    GlobalAlignment   align;
+    Transform3D       trafo;
+    const Delta&      delta  = e.delta;
+    bool              no_vol = e.path == det.placementPath();
+    double            ovl_precision = e.overlap;
+
+    if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_PIVOT|Delta::HAVE_TRANSLATION) )
+      trafo = Transform3D(Translation3D(delta.translation)*delta.pivot*delta.rotation*(delta.pivot.Inverse()));
+    else if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_TRANSLATION) )
+      trafo = Transform3D(delta.rotation,delta.translation);
+    else if ( delta.checkFlag(Delta::HAVE_ROTATION|Delta::HAVE_PIVOT) )
+      trafo = Transform3D(delta.pivot*delta.rotation*(delta.pivot.Inverse()));
+    else if ( delta.checkFlag(Delta::HAVE_ROTATION) )
+      trafo = Transform3D(delta.rotation);
+    else if ( delta.checkFlag(Delta::HAVE_TRANSLATION) )
+      trafo = Transform3D(delta.translation);
+
+    if ( deferred )  {
+      // Bulk mode: the voxels of the mother volume are rebuilt once for all checks.
+      // Same check flag and precision as the calls below.
+      align = no_vol ? ad.align(trafo) : ad.align(e.path,trafo);
+      if ( align.isValid() && GlobalAlignmentStack::checkOverlap(e) && ovl_precision != 0e0 )
+        deferred->push_back(std::make_pair(align.ptr(), overlap ? e.overlap : 0.001));
+    }
+    else if ( GlobalAlignmentStack::checkOverlap(e) && overlap )
+      align = no_vol ? ad.align(trafo,ovl_precision,e.overlap) : ad.align(e.path,trafo,ovl_precision,e.overlap);
+    else if ( GlobalAlignmentStack::checkOverlap(e) )
+      align = no_vol ? ad.align(trafo,ovl_precision) : ad.align(e.path,trafo,ovl_precision);
+    else
+      align = no_vol ? ad.align(trafo) : ad.align(e.path,trafo);
+
+    if ( align.isValid() )  {
+      op.insert(align);
+      return;
+    }
+    except("GlobalAlignmentActor","Failed to apply alignment for "+e.path);
   }
-  except("GlobalAlignmentActor","Failed to apply alignment for "+e.path);
+}
+
+template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align>::operator()(Nodes::value_type& n) const  {
+  align_entry(*this, *n.second.second, 0);
+}
+
+template <> void GlobalAlignmentActor<DDAlign_standard_operations::node_align_deferred>::operator()(Nodes::value_type& n) const  {
+  align_entry(*this, *n.second.second, &overlapChecks());
 }
 
 #if 0
@@ -29,6 +29,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <cstring>
 
 namespace dd4hep  {
 
@@ -273,8 +274,12 @@ DECLARE_XML_DOC_READER(global_alignment,setup_Alignment)
  *  @version 1.0
  *  @date    01/04/2014
  */
-static long install_Alignment(Detector& description, int, char**) {
-  GlobalAlignmentCache::install(description);
+static long install_Alignment(Detector& description, int argc, char** argv) {
+  GlobalAlignmentCache* cache = GlobalAlignmentCache::install(description);
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-bulk",argv[i],4) )
+      cache->setBulkMode(true);
+  }
   return 1;
 }
 DECLARE_APPLY(DD4hep_GlobalAlignmentInstall,install_Alignment)
@@ -18,6 +18,10 @@
 #include "DD4hep/ConditionDerived.h"
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsManager.h"
+#include "DD4hep/Mutex.h"
+
+// C/C++ include files
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -32,6 +36,17 @@ namespace dd4hep {
     
     /// Callback handler to update condition dependencies.
     /** 
+     *  Derived conditions are either computed one by one (operator()) or
+     *  all at once (compute()). compute() sorts the dependency graph
+     *  into levels: all conditions of one level only depend on conditions
+     *  of lower levels and may be computed concurrently. The results of a
+     *  level are registered in dependency order once the level is complete,
+     *  hence the content of the user pool is identical to the serial computation.
+     *
+     *  For incremental slice preparation the handler records the validities of all
+     *  conditions accessed by a callback. The derived condition is then registered
+     *  with the intersection of these validities rather than the validity of the
+     *  user pool. It is hence selected again for any IOV where its inputs are unchanged.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -51,14 +66,39 @@ namespace dd4hep {
       ConditionsPool*          m_iovPool;
       /// User defined optional processing parameter
       void*                    m_userParam;
+      /// Flag set while the levels are computed concurrently: the user pool is read-only
+      bool                     m_parallel;
+      /// Flag to register derived conditions with the validity of their inputs
+      bool                     m_incremental;
+      /// Lock serializing the computation of conditions requested out of level order
+      mutable dd4hep_mutex_t   m_lock;
+      /// Conditions computed out of level order during concurrent computation
+      mutable std::map<Condition::key_type,std::pair<const ConditionDependency*,Condition::Object*> > m_outOfOrder;
 
     public:
       /// Number of callbacks to the handler for monitoring
       mutable size_t           num_callback;
+      /// Number of callbacks of the scheduled conditions per worker thread (filled by compute())
+      std::vector<size_t>      thread_callback;
 
     protected:
       /// Internal call to trigger update callback
       Condition::Object* do_callback(const ConditionDependency& dep) const;
+      /// Invoke the update callback of a dependency. The result is not registered
+      Condition::Object* invoke(const ConditionDependency& dep) const;
+      /// Register the result of a callback to the IOV pool
+      /** If a slice with the same IOV registered the condition first, obj is deleted
+       *  and the registered instance is returned.
+       */
+      Condition::Object* do_register(Condition::Object* obj) const;
+      /// Register the result of a callback to the user pool and the IOV pool
+      Condition::Object* insert(const ConditionDependency& dep, Condition::Object* obj) const;
+      /// Access conditions while the conditions are computed one by one
+      Condition get_serial(Condition::key_type key)  const;
+      /// Access conditions while the levels are computed concurrently
+      Condition get_concurrent(Condition::key_type key)  const;
+      /// Compute the level of a dependency in the dependency graph
+      int level(const ConditionDependency* dep, std::map<Condition::key_type,int>& levels) const;
 
     public:
       /// Initializing constructor
@@ -80,6 +120,11 @@ namespace dd4hep {
       virtual Condition get(Condition::key_type key)  const;
       /// Handler callback to process multiple derived conditions
       Condition::Object* operator()(const ConditionDependency* dep)  const;
+      /// Compute all derived conditions of the dependency list, which are not yet present
+      /** With num_threads > 1 independent conditions are computed concurrently.
+       *  @return Number of derived conditions computed.
+       */
+      size_t compute(size_t num_threads);
     };
 
   }        /* End namespace cond                */
@@ -15,9 +15,11 @@
 
 // Framework include files
 #include "DDCond/ConditionsPool.h"
+#include "DD4hep/Mutex.h"
 
 // C/C++ include files
 #include <map>
+#include <vector>
 #include <memory>
 
 /// Namespace for the AIDA detector description toolkit
@@ -43,15 +45,76 @@ namespace dd4hep {
       typedef std::map<IOV::Key, Element >    Elements;      
 
       /// Container of IOV dependent conditions pools
+      /** New pools are added with insert(). Any other change of the elements
+       *  must be followed by a call to invalidate().
+       */
       Elements elements;     //! Not ROOT persistent
       /// Reference to the IOV container
       const IOVType* type;   //! Not ROOT persistent
-      
+      /// Lock protecting the elements and the content of the pools of this IOV type
+      /** Slices of different IOV types never contend. Selections lock internally,
+       *  registrations to one of the elements must hold the lock themselves.
+       */
+      dd4hep_mutex_t lock;   //! Not ROOT persistent
+
+    protected:
+      /// Node of the interval index over the IOV keys of the elements
+      struct IndexEntry  {
+        /// IOV key of the element
+        IOV::Key             key;
+        /// Largest upper IOV bound within the sub-tree rooted at this node
+        IOV::Key_second_type maxEnd;
+        /// Aging stamp: value of m_numSelect when the pool was last selected
+        long                 stamp;
+        /// Heap priority of the node. Derived from the key: the tree shape is reproducible
+        unsigned long long   priority;
+        /// Index of the left child in m_index. -1 if none
+        int                  left;
+        /// Index of the right child in m_index. -1 if none
+        int                  right;
+        /// Reference to the conditions pool
+        Element              pool;
+      };
+      /// Interval index: treap ordered by IOV key with sub-tree maxima of the upper bounds
+      /** Nodes are appended to the vector and linked by index. Registering a pool with
+       *  insert() adds one node and repairs the sub-tree maxima along the insertion
+       *  path in O(log(n)) expected time. Finding all pools covering an IOV costs
+       *  O(log(n)+k) instead of O(n). The index is only rebuilt after pools were
+       *  removed by clean() or after invalidate().
+       */
+      std::vector<IndexEntry> m_index;    //! Not ROOT persistent
+      /// Root node of the interval index. -1 if empty
+      int                     m_root;       //! Not ROOT persistent
+      /// Number of aging selections. The age of a pool is m_numSelect - stamp.
+      long                    m_numSelect;  //! Not ROOT persistent
+      /// Flag if the interval index reflects the elements
+      bool                    m_indexValid; //! Not ROOT persistent
+
+      /// Rebuild the interval index if the elements changed
+      void checkIndex();
+      /// Add a node for a pool to the interval index
+      void addNode(const IOV::Key& key, const Element& pool, long stamp);
+      /// Insert m_index[node] into the sub-tree rooted at root. Returns the new sub-tree root
+      int insertNode(int root, int node);
+      /// Recompute the sub-tree maximum of a node from its children
+      void updateMax(int node);
+      /// Copy the ages of the pools kept in the index to ConditionsPool::age_value
+      void updateAges();
+      /// Invoke action(entry) in key order for all nodes with key.first <= max_first and key.second >= min_end
+      template <typename ACTION>
+      void scan(int node, IOV::Key_first_type max_first, IOV::Key_second_type min_end, ACTION& action);
+      /// Aging selection of all pools containing the requested IOV
+      template <typename ACTION>
+      size_t selectCovering(const IOV& req_validity, IOV& cond_validity, ACTION action);
+
     public:
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
       /// Default destructor
       virtual ~ConditionsIOVPool();
+      /// Register a conditions pool for an IOV key. Updates the interval index incrementally
+      /** @return The pool registered for the key: the existing one if the key is already known */
+      Element insert(const IOV::Key& key, const Element& pool);
       /// Retrieve  a condition set given the key according to their validity
       size_t select(Condition::key_type key, const IOV& req_validity, RangeConditions& result);
       /// Retrieve  a condition set given the key according to their validity
@@ -66,6 +129,8 @@ namespace dd4hep {
       /// Remove all key based pools with an age beyon the minimum age. 
       /** @return Number of conditions cleaned up and removed.                       */
       int clean(int max_age);
+      /// Drop the interval index. Required after every change of the elements.
+      void invalidate();
     };
 
   } /* End namespace cond             */
@@ -19,6 +19,7 @@
 
 // C/C++ include files
 #include <set>
+#include <vector>
 #include <memory>
 
 /// Namespace for the AIDA detector description toolkit
@@ -61,6 +62,8 @@ namespace dd4hep {
         size_t loaded   = 0;
         size_t computed = 0;
         size_t missing  = 0;
+        /// Number of derived conditions computed by each thread. Index 0 is the calling thread
+        std::vector<size_t> computed_by_thread;
         Result() = default;
         Result(const Result& result) = default;
         Result& operator=(const Result& result) = default;
@@ -173,6 +176,10 @@ namespace dd4hep {
       loaded   += result.loaded;
       computed += result.computed;
       missing  += result.missing;
+      if ( computed_by_thread.size() < result.computed_by_thread.size() )
+        computed_by_thread.resize(result.computed_by_thread.size(), 0);
+      for( size_t i = 0; i < result.computed_by_thread.size(); ++i )
+        computed_by_thread[i] += result.computed_by_thread[i];
       return *this;
     }
     /// Subtract results
@@ -182,6 +189,10 @@ namespace dd4hep {
       loaded   -= result.loaded;
       computed -= result.computed;
       missing  -= result.missing;
+      if ( computed_by_thread.size() < result.computed_by_thread.size() )
+        computed_by_thread.resize(result.computed_by_thread.size(), 0);
+      for( size_t i = 0; i < result.computed_by_thread.size(); ++i )
+        computed_by_thread[i] -= result.computed_by_thread[i];
       return *this;
     }
   }       /* End namespace cond        */
@@ -16,6 +16,7 @@
 // Framework include files
 #include "DD4hep/Conditions.h"
 #include "DD4hep/NamedObject.h"
+#include "DD4hep/Mutex.h"
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsSlice.h"
 #include "DDCond/ConditionsDataLoader.h"
@@ -65,6 +66,13 @@ namespace dd4hep {
       Detector&                  m_detDesc;
       /// Conditions listeners on registration of new conditions
       Listeners              m_onRegister;
+      /// Immutable copy of m_onRegister used for the callbacks. Replaced at every change
+      /** Registrations may run in many threads while listeners are added or
+       *  removed: the callbacks iterate a copy, which is never modified.
+       */
+      std::shared_ptr<const Listeners> m_onRegisterCopy;
+      /// Lock protecting the listener containers
+      mutable dd4hep_mutex_t m_listenerLock;
       /// Conditions listeners on de-registration of new conditions
       Listeners              m_onRemove;
       /// Reference to the data loader userd by this instance
@@ -73,6 +81,10 @@ namespace dd4hep {
       bool                   m_doLoad = true;
       /// Property: Flag to indicate if unloaded items should be saved to the slice (or not)
       bool                   m_doOutputUnloaded = false;
+      /// Property: Number of threads to compute derived conditions (0,1: serial computation)
+      int                    m_computeThreads = 0;
+      /// Property: Flag to prepare slices incrementally (derived conditions keep the validity of their inputs)
+      bool                   m_incremental = false;
 
       /// Register callback listener object
       void registerCallee(Listeners& listeners, const Listener& callee, bool add);
@@ -97,9 +109,18 @@ namespace dd4hep {
       /// Access to flag to indicate if unloaded items should be saved to the slice (or not)
       bool doOutputUnloaded()  const        {  return m_doOutputUnloaded;  }
 
+      /// Access to the number of threads used to compute derived conditions
+      int computeThreads()  const           {  return m_computeThreads;    }
+
+      /// Access to flag to prepare slices incrementally
+      bool incrementalPrepare()  const      {  return m_incremental;       }
+
       /// Listener invocation when a condition is registered to the cache
       void onRegister(Condition condition);
 
+      /// Access the immutable copy of the listeners called on registration. May be empty
+      std::shared_ptr<const Listeners> registerListeners()  const;
+
       /// Listener invocation when a condition is deregistered from the cache
       void onRemove(Condition condition);
 
@@ -70,7 +70,10 @@ namespace dd4hep {
       /// Lock to protect the update/delayed conditions pool
       dd4hep_mutex_t          m_updateLock;
       /// Lock to protect the pool of all known conditions
-      dd4hep_mutex_t          m_poolLock;
+      /** Held for every access to the entries of m_rawPool. The content of
+       *  each IOV pool is protected by the lock of the IOV pool.
+       */
+      mutable dd4hep_mutex_t  m_poolLock;
       /// Reference to update conditions pool
       std::unique_ptr<UpdatePool>  m_updatePool;
 
@@ -134,7 +137,10 @@ namespace dd4hep {
       /// Access conditions multi IOV pool by iov type
       ConditionsIOVPool* iovPool(const IOVType& type)  const  final;
 
-      /// Register new condition with the conditions store. Unlocked version, not multi-threaded
+      /// Register new condition with the conditions store.
+      /** The manager is not locked. The insertion into the pool is protected
+       *  by the lock of the IOV pool, which also protects the selections.
+       */
       virtual bool registerUnlocked(ConditionsPool& pool, Condition cond)  final;
 
       /// Clean conditions, which are above the age limit.
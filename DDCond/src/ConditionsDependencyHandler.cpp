@@ -14,18 +14,62 @@
 // Framework include files
 #include "DDCond/ConditionsDependencyHandler.h"
 #include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsIOVPool.h"
 #include "DD4hep/Printout.h"
 
+// C/C++ include files
+#include <atomic>
+#include <algorithm>
+#include <thread>
+#include <exception>
+#include <climits>
+
 using namespace dd4hep;
 using namespace dd4hep::cond;
 
+namespace {
+  /// Resolver passed to a single callback: records the validity of all conditions accessed
+  class ValidityRecorder : public ConditionResolver  {
+  public:
+    /// Resolver doing the actual work
+    const ConditionResolver& resolver;
+    /// Intersection of the validities of all conditions accessed
+    IOV&                     validity;
+    /// Initializing constructor
+    ValidityRecorder(const ConditionResolver& r, IOV& v) : resolver(r), validity(v)  {}
+    /// Interface to access conditions by conditions key
+    virtual Condition get(const ConditionKey& key)  const  { return get(key.hash);  }
+    /// Interface to access conditions by hash value
+    virtual Condition get(Condition::key_type key)  const  {
+      Condition c = resolver.get(key);
+      if ( c.isValid() && c->iov )  {
+        // The derived condition is only valid where all its inputs are valid.
+        // Inputs of another IOV type restrict it to the required validity.
+        const IOV& required = resolver.requiredValidity();
+        if ( IOV::same_type(*c->iov, required) )
+          validity.iov_intersection(c->iov->keyData);
+        else
+          validity.iov_intersection(required.keyData);
+      }
+      return c;
+    }
+    /// Access to the conditions manager
+    virtual Handle<NamedObject> manager() const      { return resolver.manager();             }
+    /// Access to the detector description instance
+    virtual Detector& detectorDescription() const    { return resolver.detectorDescription(); }
+    /// Required IOV value for update cycle
+    virtual const IOV& requiredValidity()  const     { return resolver.requiredValidity();    }
+  };
+}
+
 /// Default constructor
 ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager mgr,
                                                          UserPool& pool,
                                                          const Dependencies& dependencies,
                                                          void* user_param)
   : m_manager(mgr.access()), m_pool(pool), m_dependencies(dependencies),
-    m_userParam(user_param), num_callback(0)
+    m_userParam(user_param), m_parallel(false),
+    m_incremental(m_manager->incrementalPrepare()), num_callback(0)
 {
   const IOV& iov = m_pool.validity();
   m_iovPool = m_manager->registerIOV(*iov.iovType, iov.keyData);
@@ -42,6 +86,11 @@ Detector& ConditionsDependencyHandler::detectorDescription() const  {
 
 /// ConditionResolver implementation: Interface to access conditions
 Condition ConditionsDependencyHandler::get(Condition::key_type key)  const  {
+  return m_parallel ? get_concurrent(key) : get_serial(key);
+}
+
+/// Access conditions while the conditions are computed one by one
+Condition ConditionsDependencyHandler::get_serial(Condition::key_type key)  const  {
   Condition c = m_pool.get(key);
   if ( c.isValid() )  {
     Condition::Object* obj = c.ptr();
@@ -64,24 +113,56 @@ Condition ConditionsDependencyHandler::get(Condition::key_type key)  const  {
   return Condition();
 }
 
+/// Access conditions while the levels are computed concurrently
+Condition ConditionsDependencyHandler::get_concurrent(Condition::key_type key)  const  {
+  // The user pool is not modified while a level is computed: read access is safe
+  Condition c = m_pool.get(key);
+  Dependencies::const_iterator i = m_dependencies.find(key);
+  if ( c.isValid() )  {
+    Condition::Object* obj = c.ptr();
+    const IOV& required = m_pool.validity();
+    if ( obj && obj->iov && IOV::key_is_contained(required.keyData,obj->iov->keyData) )
+      return c;
+  }
+  if ( i == m_dependencies.end() )  {
+    return Condition();
+  }
+  // The callback accesses a derived condition, which is not yet computed
+  // (not declared as dependency or of the same level). Compute it now.
+  dd4hep_lock_t lock(m_lock);
+  auto j = m_outOfOrder.find(key);
+  if ( j != m_outOfOrder.end() )  {
+    return (*j).second.second;
+  }
+  // Register the condition at once: the caller must see the instance kept by the IOV pool
+  Condition::Object* obj = invoke(*(*i).second);
+  if ( obj ) obj = do_register(obj);
+  m_outOfOrder[key] = std::make_pair((*i).second, obj);
+  return obj;
+}
 
-/// Internal call to trigger update callback
+/// Invoke the update callback of a dependency. The result is not registered
 Condition::Object* 
-ConditionsDependencyHandler::do_callback(const ConditionDependency& dep)  const {
+ConditionsDependencyHandler::invoke(const ConditionDependency& dep)  const {
   try  {
-    IOV iov(m_pool.validity().iovType);
-    ConditionUpdateContext ctxt(*this, dep, m_userParam, iov.reset().invert());
+    IOV iov(m_pool.validity().iovType), validity(m_pool.validity().iovType);
+    // In incremental mode the callback accesses the conditions through a recorder of their validity
+    ValidityRecorder recorder(*this, validity.reset().invert());
+    const ConditionResolver& resolver = m_incremental ? (const ConditionResolver&)recorder : *this;
+    ConditionUpdateContext ctxt(resolver, dep, m_userParam, iov.reset().invert());
     Condition          cond = (*dep.callback)(dep.target, ctxt);
     Condition::Object* obj  = cond.ptr();
     if ( obj )  {
+      const IOV& required = m_pool.validity();
       obj->hash = dep.target.hash;
       cond->setFlag(Condition::DERIVED);
       //cond->validate();
       cond->iov = m_pool.validityPtr();
-      // Must IMMEDIATELY insert to handle inter-dependencies.
-      ++num_callback;
-      m_pool.insert(dep.detector, dep.target.item_key(), cond);
-      m_manager->registerUnlocked(*m_iovPool, cond);
+      // Without any recorded input keep the validity of the user pool
+      if ( m_incremental && (validity.keyData.first != LONG_MIN || validity.keyData.second != LONG_MAX) &&
+           IOV::key_is_contained(required.keyData, validity.keyData) )  {
+        cond->iov = m_manager->registerIOV(*required.iovType, validity.keyData)->iov;
+      }
     }
     return obj;
   }
@@ -103,7 +184,154 @@ ConditionsDependencyHandler::do_callback(const ConditionDependency& dep)  const
   return 0;
 }
 
+/// Register the result of a callback to the IOV pool. Returns the registered instance
+Condition::Object*
+ConditionsDependencyHandler::do_register(Condition::Object* obj)  const {
+  Condition cond(obj);
+  ConditionsPool* target = m_iovPool;
+  if ( m_incremental && obj->iov && obj->iov != m_iovPool->iov )  {
+    // Incremental mode: registered with the validity of the inputs
+    target = m_manager->registerIOV(*obj->iov->iovType, obj->iov->keyData);
+  }
+  Condition present;  {
+    // A slice with the same IOV may be prepared concurrently and may have
+    // registered this condition first: then use the registered instance.
+    dd4hep_lock_t lock(m_manager->iovPool(*target->iov->iovType)->lock);
+    present = target->exists(obj->hash);
+    if ( !present.isValid() )
+      m_manager->registerUnlocked(*target, cond);
+  }
+  if ( present.isValid() && present.ptr() != obj )  {
+    delete obj;
+    obj = present.ptr();
+  }
+  return obj;
+}
+
+/// Register the result of a callback to the user pool and the IOV pool
+Condition::Object*
+ConditionsDependencyHandler::insert(const ConditionDependency& dep, Condition::Object* obj)  const {
+  obj = do_register(obj);
+  ++num_callback;
+  m_pool.insert(dep.detector, dep.target.item_key(), Condition(obj));
+  return obj;
+}
+
+/// Internal call to trigger update callback
+Condition::Object* 
+ConditionsDependencyHandler::do_callback(const ConditionDependency& dep)  const {
+  Condition::Object* obj = invoke(dep);
+  // Must IMMEDIATELY insert to handle inter-dependencies.
+  return obj ? insert(dep, obj) : 0;
+}
+
 /// Handler callback to process multiple derived conditions
 Condition::Object* ConditionsDependencyHandler::operator()(const ConditionDependency* dep)  const   {
   return do_callback(*dep);
 }
+
+/// Compute the level of a dependency in the dependency graph
+int ConditionsDependencyHandler::level(const ConditionDependency* dep,
+                                       std::map<Condition::key_type,int>& levels) const
+{
+  Condition::key_type key = dep->key();
+  auto i = levels.find(key);
+  if ( i != levels.end() )  {
+    if ( (*i).second < 0 )  {
+      except("ConditionDependency","++ Cyclic dependency for derived condition %s.",dep->name());
+    }
+    return (*i).second;
+  }
+  levels[key] = -1;   // Mark as being processed to detect cycles
+  int lvl = 0;
+  for( const auto& k : dep->dependencies )  {
+    Dependencies::const_iterator j = m_dependencies.find(k.hash);
+    if ( j != m_dependencies.end() )
+      lvl = std::max(lvl, 1 + level((*j).second, levels));
+  }
+  levels[key] = lvl;
+  return lvl;
+}
+
+/// Compute all derived conditions of the dependency list, which are not yet present
+size_t ConditionsDependencyHandler::compute(size_t num_threads)   {
+  size_t num_start = num_callback;
+  thread_callback.assign(std::max(num_threads,size_t(1)), 0);
+  if ( num_threads <= 1 )  {
+    for( const auto& i : m_dependencies )   {
+      // If we would know, that dependencies are only ONE level, we could skip this search....
+      if ( !m_pool.exists(i.first) )
+        do_callback(*i.second);
+    }
+    thread_callback[0] = num_callback - num_start;
+    return num_callback - num_start;
+  }
+
+  // Sort the dependencies into levels. Within a level the order of the map is kept.
+  std::map<Condition::key_type,int> levels;
+  std::vector<std::vector<const ConditionDependency*> > work;
+  for( const auto& i : m_dependencies )   {
+    size_t lvl = level(i.second, levels);
+    if ( work.size() <= lvl ) work.resize(lvl+1);
+    work[lvl].push_back(i.second);
+  }
+
+  for( const auto& items : work )   {
+    std::vector<const ConditionDependency*> todo;
+    for( const ConditionDependency* d : items )
+      if ( !m_pool.exists(d->key()) ) todo.push_back(d);
+    if ( todo.empty() ) continue;
+
+    // Every item is computed by exactly one worker and stored in its own slot
+    std::vector<Condition::Object*> results(todo.size(), 0);
+    std::vector<std::exception_ptr> errors(num_threads);
+    std::atomic<size_t> next(0);
+    auto worker = [&](size_t id)  {
+      try  {
+        for( size_t n = next++; n < todo.size(); n = next++ )  {
+          const ConditionDependency* d = todo[n];
+          {
+            dd4hep_lock_t lock(m_lock);
+            if ( m_outOfOrder.find(d->key()) != m_outOfOrder.end() ) continue;
+          }
+          results[n] = invoke(*d);
+          ++thread_callback[id];
+        }
+      }
+      catch(...)  {
+        errors[id] = std::current_exception();
+      }
+    };
+    size_t nthreads = std::min(num_threads, todo.size());
+    std::vector<std::thread> threads;
+    m_parallel = true;
+    for( size_t id = 1; id < nthreads; ++id )
+      threads.push_back(std::thread(worker, id));
+    worker(0);
+    for( auto& t : threads ) t.join();
+    m_parallel = false;
+
+    // Merge the level: first the conditions computed out of order, which are
+    // already registered to the IOV pool, then the scheduled items in dependency order.
+    for( const auto& e : m_outOfOrder )  {
+      if ( !e.second.second ) continue;
+      const ConditionDependency* d = e.second.first;
+      ++num_callback;
+      m_pool.remove(e.first);
+      m_pool.insert(d->detector, d->target.item_key(), Condition(e.second.second));
+    }
+    for( size_t n = 0; n < todo.size(); ++n )  {
+      if ( !results[n] ) continue;
+      if ( m_outOfOrder.find(todo[n]->key()) != m_outOfOrder.end() )  {
+        delete results[n];   // Duplicate of a condition computed out of order
+        continue;
+      }
+      m_pool.remove(todo[n]->key());
+      insert(*todo[n], results[n]);
+    }
+    m_outOfOrder.clear();
+    for( const auto& e : errors )
+      if ( e ) std::rethrow_exception(e);
+  }
+  return num_callback - num_start;
+}
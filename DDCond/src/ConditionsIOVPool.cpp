@@ -18,11 +18,30 @@
 #include "DD4hep/detail/ConditionsInterna.h"
 #include "DDCond/ConditionsDataLoader.h"
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep;
 using namespace dd4hep::cond;
 
+namespace {
+  /// Pseudo-random heap priority of an index node (64 bit finalizer of MurmurHash3)
+  unsigned long long node_priority(const IOV::Key& key)  {
+    unsigned long long h = (unsigned long long)key.first * 0x9e3779b97f4a7c15ULL;
+    h ^= (unsigned long long)key.second + (h >> 29);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+}
+
 /// Default constructor
-ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
+ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ)
+  : type(typ), m_root(-1), m_numSelect(0), m_indexValid(true)
+{
   InstanceCount::increment(this);
 }
 
@@ -32,16 +51,139 @@ ConditionsIOVPool::~ConditionsIOVPool()  {
   InstanceCount::decrement(this);
 }
 
+/// Recompute the sub-tree maximum of a node from its children
+void ConditionsIOVPool::updateMax(int node)   {
+  IndexEntry& e = m_index[node];
+  e.maxEnd = e.key.second;
+  if ( e.left  >= 0 ) e.maxEnd = std::max(e.maxEnd, m_index[e.left].maxEnd);
+  if ( e.right >= 0 ) e.maxEnd = std::max(e.maxEnd, m_index[e.right].maxEnd);
+}
+
+/// Insert m_index[node] into the sub-tree rooted at root. Returns the new sub-tree root
+int ConditionsIOVPool::insertNode(int root, int node)   {
+  if ( root < 0 ) return node;
+  IndexEntry& r = m_index[root];
+  if ( m_index[node].key < r.key )  {
+    r.left = insertNode(r.left, node);
+    int child = r.left;
+    if ( m_index[child].priority > r.priority )  {
+      // Rotate right: the left child becomes the root of the sub-tree
+      r.left = m_index[child].right;
+      m_index[child].right = root;
+      updateMax(root);
+      updateMax(child);
+      return child;
+    }
+  }
+  else  {
+    r.right = insertNode(r.right, node);
+    int child = r.right;
+    if ( m_index[child].priority > r.priority )  {
+      // Rotate left: the right child becomes the root of the sub-tree
+      r.right = m_index[child].left;
+      m_index[child].left = root;
+      updateMax(root);
+      updateMax(child);
+      return child;
+    }
+  }
+  updateMax(root);
+  return root;
+}
+
+/// Add a node for a pool to the interval index
+void ConditionsIOVPool::addNode(const IOV::Key& key, const Element& pool, long stamp)   {
+  IndexEntry entry;
+  entry.key      = key;
+  entry.maxEnd   = key.second;
+  entry.stamp    = stamp;
+  entry.priority = node_priority(key);
+  entry.left     = -1;
+  entry.right    = -1;
+  entry.pool     = pool;
+  m_index.push_back(entry);
+  m_root = insertNode(m_root, int(m_index.size()-1));
+}
+
+/// Rebuild the interval index if the elements changed
+void ConditionsIOVPool::checkIndex()   {
+  // The size check catches insertions by clients, which did not invalidate the index
+  if ( m_indexValid && m_index.size() == elements.size() ) return;
+  updateAges();
+  m_index.clear();
+  m_index.reserve(elements.size());
+  m_root = -1;
+  for( const auto& e : elements )
+    addNode(e.first, e.second, m_numSelect - e.second->age_value);
+  m_indexValid = true;
+}
+
+/// Register a conditions pool for an IOV key. Updates the interval index incrementally
+ConditionsIOVPool::Element ConditionsIOVPool::insert(const IOV::Key& key, const Element& pool)   {
+  dd4hep_lock_t locked(lock);
+  std::pair<Elements::iterator,bool> r = elements.insert(std::make_pair(key, pool));
+  // A stale index is rebuilt completely at the next selection
+  if ( r.second && m_indexValid && m_index.size()+1 == elements.size() )
+    addNode(key, pool, m_numSelect - pool->age_value);
+  return (*r.first).second;
+}
+
+/// Copy the ages of the pools kept in the index to ConditionsPool::age_value
+void ConditionsIOVPool::updateAges()   {
+  for( const auto& e : m_index )
+    e.pool->age_value = int(m_numSelect - e.stamp);
+}
+
+/// Drop the interval index. Required after every change of the elements.
+void ConditionsIOVPool::invalidate()   {
+  dd4hep_lock_t locked(lock);
+  updateAges();
+  m_index.clear();
+  m_root = -1;
+  m_indexValid = false;
+}
+
+/// Invoke action(entry) in key order for all nodes with key.first <= max_first and key.second >= min_end
+template <typename ACTION>
+void ConditionsIOVPool::scan(int node, IOV::Key_first_type max_first, IOV::Key_second_type min_end, ACTION& action)  {
+  while ( node >= 0 )  {
+    IndexEntry& e = m_index[node];
+    if ( e.maxEnd < min_end ) return;        // Nothing in this sub-tree reaches min_end
+    scan(e.left, max_first, min_end, action);
+    if ( e.key.first > max_first ) return;   // This node and the right sub-tree start too late
+    if ( e.key.second >= min_end ) action(e);
+    node = e.right;
+  }
+}
+
+/// Aging selection of all pools containing the requested IOV
+template <typename ACTION>
+size_t ConditionsIOVPool::selectCovering(const IOV& req_validity, IOV& cond_validity, ACTION action)  {
+  size_t num_selected = 0;
+  if ( !elements.empty() )  {
+    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
+    checkIndex();
+    long stamp = ++m_numSelect;   // All pools not selected age by one
+    auto select = [&](IndexEntry& e)  {
+      cond_validity.iov_intersection(e.key);
+      num_selected += action(e);
+      e.stamp = stamp;
+    };
+    // Candidates start before the requested IOV and end after it
+    scan(m_root, req_key.first, req_key.second, select);
+  }
+  return num_selected;
+}
+
 size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  dd4hep_lock_t locked(lock);
   if ( !elements.empty() )  {
     size_t len = result.size();
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& e : elements )  {
-      if ( IOV::key_contains_range(e.first, req_key) )  {
-        e.second->select(key, result);
-      }
-    }
+    checkIndex();
+    auto select = [key, &result](const IndexEntry& e)  { e.pool->select(key, result); };
+    scan(m_root, req_key.first, req_key.second, select);
     return result.size() - len;
   }
   return 0;
@@ -49,27 +191,26 @@ size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validit
 
 size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  dd4hep_lock_t locked(lock);
   size_t len = result.size();
   const IOV::Key range = req_validity.key();
-  for( const auto& e : elements )  {
-    const IOV::Key& k = e.first;
-    if ( IOV::key_is_contained(k,range) )
-      // IOV test contained in key. Take it!
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_lower_end(k,range) )
-      // IOV overlap on test on the lower end of key
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_higher_end(k,range) )
-      // IOV overlap of test on the higher end of key
-      e.second->select(key, result);
-  }
+  checkIndex();
+  // Candidates start before the end of the range and end after its start:
+  // keys starting inside the range match, keys starting before it must also end inside.
+  auto select = [key, range, &result](const IndexEntry& e)  {
+    if ( e.key.first >= range.first || e.key.second <= range.second )
+      e.pool->select(key, result);
+  };
+  scan(m_root, range.second, range.first, select);
   return result.size() - len;
 }
 
 /// Remove all key based pools with an age beyon the minimum age
 int ConditionsIOVPool::clean(int max_age)   {
+  dd4hep_lock_t locked(lock);
   Elements rest;
   int count = 0;
+  invalidate();
   for( const auto& e : elements )  {
     if ( e.second->age_value >= max_age )   {
       count += e.second->size();
@@ -88,20 +229,9 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
                                  RangeConditions&  valid,
                                  IOV&              cond_validity)
 {
-  size_t num_selected = 0;
-  if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      num_selected += i.second->select_all(valid);
-      i.second->age_value = 0;
-    }
-  }
-  return num_selected;
+  dd4hep_lock_t locked(lock);
+  return selectCovering(req_validity, cond_validity,
+                        [&valid](IndexEntry& e)  { return e.pool->select_all(valid); });
 }
 
 /// Select all ACTIVE conditions, which do match the IOV requirement
@@ -109,40 +239,17 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
                                  const ConditionsSelect& predicate_processor,
                                  IOV&                    cond_validity)
 {
-  size_t num_selected = 0;
-  if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      num_selected += i.second->select_all(predicate_processor);
-      i.second->age_value = 0;
-    }
-  }
-  return num_selected;
+  dd4hep_lock_t locked(lock);
+  return selectCovering(req_validity, cond_validity,
+                        [&predicate_processor](IndexEntry& e)  { return e.pool->select_all(predicate_processor); });
 }
 
-/// Select all ACTIVE conditions, which do match the IOV requirement
+/// Select all ACTIVE conditions pools, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, 
                                  Elements&  valid,
                                  IOV&       cond_validity)
 {
-  size_t num_selected = 0;
-  if ( !elements.empty() )   {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      valid[i.first] = i.second;
-      i.second->age_value = 0;
-      ++num_selected;
-    }
-  }
-  return num_selected;
+  dd4hep_lock_t locked(lock);
+  return selectCovering(req_validity, cond_validity,
+                        [&valid](IndexEntry& e)  { valid[e.key] = e.pool; return size_t(1); });
 }
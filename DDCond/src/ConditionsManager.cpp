@@ -52,11 +52,14 @@ ConditionsManagerObject::ConditionsManagerObject(Detector& ref_description)
   InstanceCount::increment(this);
   declareProperty("LoadConditions",           m_doLoad);
   declareProperty("OutputUnloadedConditions", m_doOutputUnloaded);
+  declareProperty("ComputeThreads",           m_computeThreads);
+  declareProperty("IncrementalPrepare",       m_incremental);
 }
 
 /// Default destructor
 ConditionsManagerObject::~ConditionsManagerObject()   {
   m_onRegister.clear();
+  m_onRegisterCopy.reset();
   m_onRemove.clear();
   InstanceCount::decrement(this);
 }
@@ -72,7 +75,15 @@ void ConditionsManagerObject::registerCallee(Listeners& listeners, const Listene
 
 /// (Un)Registration of conditions listeners with callback when a new condition is registered
 void ConditionsManagerObject::callOnRegister(const Listener& callee, bool add)  {
+  dd4hep_lock_t lock(m_listenerLock);
   registerCallee(m_onRegister, callee, add);
+  m_onRegisterCopy.reset(m_onRegister.empty() ? 0 : new Listeners(m_onRegister));
+}
+
+/// Access the immutable copy of the listeners called on registration
+shared_ptr<const ConditionsManagerObject::Listeners> ConditionsManagerObject::registerListeners()  const  {
+  dd4hep_lock_t lock(m_listenerLock);
+  return m_onRegisterCopy;
 }
 
 /// (Un)Registration of conditions listeners with callback when a condition is de-registered
@@ -82,8 +93,11 @@ void ConditionsManagerObject::callOnRemove(const Listener& callee, bool add)  {
 
 /// Call this when a condition is registered to the cache
 void ConditionsManagerObject::onRegister(Condition condition)    {
-  for(const auto& listener : m_onRegister )
-    listener.first->onRegisterCondition(condition, listener.second);
+  shared_ptr<const Listeners> listeners = registerListeners();
+  if ( listeners )  {
+    for(const auto& listener : *listeners )
+      listener.first->onRegisterCondition(condition, listener.second);
+  }
 }
 
 /// Call this when a condition is deregistered from the cache
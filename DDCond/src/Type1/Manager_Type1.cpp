@@ -65,7 +65,7 @@ namespace {
       if ( typ )  {
         if ( iov->type == typ->type )  {
           if ( typ->type < o->m_rawPool.size() )  {
-            if ( o->m_rawPool[typ->type] != 0 )  {
+            if ( o->iovPool(*typ) != 0 )  {
               return typ;
             }
           }
@@ -127,9 +127,11 @@ namespace {
   }
 
   template <typename PMF>
-  void __callListeners(const Manager_Type1::Listeners& listeners, PMF pmf, Condition& cond)  {
-    for(const auto& listener : listeners )
-      (listener.first->*pmf)(cond, listener.second);
+  void __callListeners(const shared_ptr<const Manager_Type1::Listeners>& listeners, PMF pmf, Condition& cond)  {
+    if ( listeners )  {
+      for(const auto& listener : *listeners )
+        (listener.first->*pmf)(cond, listener.second);
+    }
   }
 }
 
@@ -184,6 +186,7 @@ pair<bool, const IOVType*> Manager_Type1::registerIOVType(size_t iov_index, cons
       except("ConditionsManager","Cannot register IOV %s. Type %d already in use!",
              iov_name.c_str(), iov_index);
     }
+    dd4hep_lock_t lock(m_poolLock);
     typ.name = iov_name;
     typ.type = iov_index;
     m_rawPool[typ.type] = new ConditionsIOVPool(&typ);
@@ -215,11 +218,15 @@ const IOVType* Manager_Type1::iovType (const string& iov_name) const   {
 /// Register IOV with type and key
 ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   // IOV read and checked. Now register it, but always locked!
-  ConditionsIOVPool* pool = m_rawPool[typ.type];
-  dd4hep_lock_t lock(m_poolLock);
-  if ( !pool )  {
-    m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
+  ConditionsIOVPool* pool = 0;  {
+    dd4hep_lock_t lock(m_poolLock);
+    pool = m_rawPool[typ.type];
+    if ( !pool )  {
+      m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
+    }
   }
+  // Only the pool of this IOV type is locked: other IOV types may proceed.
+  dd4hep_lock_t lock(pool->lock);
   ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
   if ( i != pool->elements.end() )   {
     return (*i).second.get();
@@ -230,22 +237,26 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   iov->type      = typ.type;
   iov->keyData   = key;
   cond_pool->iov = iov;
-  pool->elements.insert(make_pair(key,cond_pool));
+  pool->insert(key, cond_pool);
   return cond_pool.get();
 }
 
 /// Access conditions multi IOV pool by iov type
 ConditionsIOVPool* Manager_Type1::iovPool(const IOVType& iov_type)  const    {
+  dd4hep_lock_t lock(m_poolLock);
   return m_rawPool[iov_type.type];
 }
 
-/// Register new condition with the conditions store. Unlocked version, not multi-threaded
+/// Register new condition with the conditions store. The manager is not locked.
 bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
   if ( cond.isValid() )  {
     cond->iov  = pool.iov;
-    cond->setFlag(Condition::ACTIVE);
-    pool.insert(cond);
-    __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, cond);
+    cond->setFlag(Condition::ACTIVE);  {
+      // Concurrent selections from the IOV pool hold the same lock
+      dd4hep_lock_t lock(iovPool(*pool.iov->iovType)->lock);
+      pool.insert(cond);
+    }
+    __callListeners(registerListeners(), &ConditionsListener::onRegisterCondition, cond);
     return true;
   }
   else if ( !cond.isValid() )
@@ -283,7 +294,7 @@ void Manager_Type1::__get_checked_pool(const IOV& req_iov,
 {
   const IOVType* typ = check_iov_type<Discrete>(this, &req_iov);
   if ( typ )  {
-    ConditionsIOVPool* pool = m_rawPool[typ->type];
+    ConditionsIOVPool* pool = iovPool(*typ);
     if ( 0 == up.get() )  {
       const void* argv[] = {this, pool, 0};
       UserPool* p = createPlugin<UserPool>(m_userType,m_detDesc,2,argv);
@@ -300,7 +311,7 @@ void Manager_Type1::__get_checked_pool(const IOV& req_iov,
 int Manager_Type1::clean(const IOVType* typ, int max_age)   {
   int count = 0;
   dd4hep_lock_t lock(m_updateLock);
-  ConditionsIOVPool* pool = m_rawPool[typ->type];
+  ConditionsIOVPool* pool = iovPool(*typ);
   if ( pool )  {
     count += pool->clean(max_age);
   }
@@ -310,7 +321,13 @@ int Manager_Type1::clean(const IOVType* typ, int max_age)   {
 /// Full cleanup of all managed conditions.
 pair<int,int> Manager_Type1::clear()   {
   pair<int,int> count(0,0);
-  for( TypedConditionPool::iterator i=m_rawPool.begin(); i != m_rawPool.end(); ++i)  {
+  TypedConditionPool pools;  {
+    // Registrations may hold the lock of an IOV pool while they access
+    // m_rawPool: never lock an IOV pool while holding m_poolLock.
+    dd4hep_lock_t lock(m_poolLock);
+    pools = m_rawPool;
+  }
+  for( TypedConditionPool::iterator i=pools.begin(); i != pools.end(); ++i)  {
     ConditionsIOVPool* p = *i;
     if ( p )  {
       ++count.first;
@@ -347,9 +364,8 @@ bool Manager_Type1::select(Condition::key_type key,
                            const IOV& req_validity,
                            RangeConditions& conditions)   {
   {
-    ConditionsIOVPool* p = 0;
-    dd4hep_lock_t locked_action(m_poolLock);
-    p = m_rawPool[req_validity.type]; // Existence already checked by caller!
+    // The IOV pool locks itself: no need to block other IOV types
+    ConditionsIOVPool* p = iovPool(*iovType(req_validity.type)); // Existence already checked by caller!
     p->select(key, req_validity, conditions);
   }
   {
@@ -365,9 +381,8 @@ bool Manager_Type1::select_range(Condition::key_type key,
                                  RangeConditions& conditions)
 {
   {
-    ConditionsIOVPool* p = 0;
-    dd4hep_lock_t locked_action(m_poolLock);
-    p = m_rawPool[req_validity.type]; // Existence alread checked by caller!
+    // The IOV pool locks itself: no need to block other IOV types
+    ConditionsIOVPool* p = iovPool(*iovType(req_validity.type)); // Existence alread checked by caller!
     p->selectRange(key, req_validity, conditions);
   }
   {
@@ -454,7 +469,7 @@ Manager_Type1::prepare(const IOV& req_iov, ConditionsSlice& slice)
 /// Create empty user pool object
 std::unique_ptr<UserPool> Manager_Type1::createUserPool(const IOVType* iovT)  const  {
   if ( iovT )  {
-    ConditionsIOVPool* p = m_rawPool[iovT->type];
+    ConditionsIOVPool* p = iovPool(*iovT);
     const void* argv[] = {this, p, 0};
     std::unique_ptr<UserPool> pool(createPlugin<UserPool>(m_userType,m_detDesc,2,argv));
     return pool;
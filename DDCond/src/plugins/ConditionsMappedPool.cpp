@@ -101,7 +101,7 @@ namespace dd4hep {
 
       /// Check if a condition exists in the pool
       virtual Condition exists(Condition::key_type key)  const  final   {
-        auto i=find_if(m_entries.begin(), m_entries.end(), Operators::keyFind(key));
+        auto i=m_entries.find(key);
         return i==m_entries.end() ? Condition() : (*i).second;
       }
 
@@ -436,6 +436,9 @@ size_t ConditionsMappedUserPool<MAPPING>::compute(const Dependencies& deps,
 }
 
 namespace {
+  /// Serialize the access to the (shared) conditions data loader
+  mutex loader_lock;
+
   struct COMP {
     typedef pair<Condition::key_type,const ConditionDependency*>     Dep;
     typedef pair<const Condition::key_type,detail::ConditionObject*> Cond;
@@ -469,18 +472,58 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&              required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
-  m_conditions.clear();
+  // No global lock: the selection locks the IOV pool and the registration
+  // of loaded and derived conditions locks it again. The user pool
+  // itself is owned by the slice and not shared between threads.
   slice_miss_cond.clear();
   slice_miss_calc.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
+  if ( m_manager->incrementalPrepare() && !m_conditions.empty() &&
+       m_iov.iovType && IOV::full_match(required, m_iov) )  {
+    // All conditions of the previous IOV are still valid: keep them and
+    // only add what the slice content requires in addition.
+    pool_iov = m_iov;
+    printout(DEBUG,"UserPool","Reuse %ld conditions of IOV:%s for IOV:%s.",
+             m_conditions.size(), m_iov.str().c_str(), required.str().c_str());
+  }
+  else if ( m_manager->incrementalPrepare() && !m_conditions.empty() &&
+            m_iov.iovType && IOV::same_type(required, m_iov) )  {
+    // Keep every condition, which carries its own validity and still covers
+    // the required IOV. Derived conditions were registered with the intersection
+    // of their inputs: only those depending on an expired input are dropped
+    // and hence recomputed below.
+    size_t num_total = m_conditions.size();
+    const IOV::Key old_key = m_iov.keyData;
+    for( auto i = m_conditions.begin(); i != m_conditions.end(); )  {
+      const IOV* iov = (*i).second->iov;
+      if ( iov && iov != &m_iov && IOV::same_type(*iov, required) &&
+           IOV::key_contains_range(iov->keyData, required.keyData) )
+        ++i;
+      else
+        i = m_conditions.erase(i);
+    }
+    size_t num_reused = m_conditions.size();
+    ConditionsIOVPool::Elements pools;  {
+      dd4hep_lock_t lock(m_iovPool->lock);
+      pool_iov.reset().invert();
+      m_iovPool->select(required, pools, pool_iov);
+      // Pools covering the previous IOV were already selected: their
+      // conditions are either kept or expired.
+      for( const auto& p : pools )  {
+        if ( !IOV::key_contains_range(p.first, old_key) )
+          p.second->select_all(Operators::mapConditionsSelect(m_conditions));
+      }
+    }
+    m_iov = pool_iov;
+    printout(DEBUG,"UserPool","Reuse %ld of %ld conditions of IOV:%s for IOV:%s.",
+             num_reused, num_total, IOV(m_iov.iovType,old_key).str().c_str(),
+             required.str().c_str());
+  }
+  else  {
+    m_conditions.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+  }
   CondMissing cond_missing(slice_cond.size()+m_conditions.size());
   CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
 
@@ -514,7 +557,11 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&              required,
   if ( num_cond_miss > 0 )  {
     if ( do_load )  {
       ConditionsDataLoader::LoadedItems loaded;
-      size_t updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
+      size_t updates = 0;  {
+        // The data loaders are not required to be thread safe
+        lock_guard<mutex> guard(loader_lock);
+        updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
+      }
       if ( updates > 0 )  {
         // Need to compute the intersection: All missing entries are required....
         CondMissing load_missing(cond_missing.size()+loaded.size());
@@ -550,17 +597,8 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&              required,
     if ( do_load )  {
       map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
-      for( const auto& i : deps )   {
-        const ConditionDependency* d = i.second;
-        typename MAPPING::iterator j = m_conditions.find(d->key());
-        // If we would know, that dependencies are only ONE level, we could skip this search....
-        if ( j == m_conditions.end() )  {
-          handler(d);
-          continue;
-        }
-        // printout(INFO,"UserPool","Already calcluated: %s",d->name());
-        continue;
-      }
+      handler.compute(max(m_manager->computeThreads(),0));
+      result.computed_by_thread = handler.thread_callback;
       result.computed = handler.num_callback;
       result.missing -= handler.num_callback;
       if ( do_output_miss && result.computed < deps.size() )  {
@@ -591,12 +629,9 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&              required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
+  // No global lock: the selection locks the IOV pool and the registration
+  // of loaded and derived conditions locks it again. The user pool
+  // itself is owned by the slice and not shared between threads.
   m_conditions.clear();
   slice_miss_cond.clear();
   pool_iov.reset().invert();
@@ -620,7 +655,11 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&              required,
   if ( num_cond_miss > 0 )  {
     if ( do_load )  {
       ConditionsDataLoader::LoadedItems loaded;
-      size_t updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
+      size_t updates = 0;  {
+        // The data loaders are not required to be thread safe
+        lock_guard<mutex> guard(loader_lock);
+        updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
+      }
       if ( updates > 0 )  {
         // Need to compute the intersection: All missing entries are required....
         CondMissing load_missing(cond_missing.size()+loaded.size());
@@ -663,12 +702,8 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&              required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static mutex lock;
-  lock_guard<mutex> guard(lock);
-
+  // No global lock: the user pool is owned by the slice. Derived conditions
+  // are registered to the IOV pool under its own lock.
   slice_miss_calc.clear();
   CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
   CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
@@ -690,17 +725,8 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&              required,
     if ( do_load )  {
       map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
-      for( const auto& i : deps )   {
-        const ConditionDependency* d = i.second;
-        typename MAPPING::iterator j = m_conditions.find(d->key());
-        // If we would know, that dependencies are only ONE level, we could skip this search....
-        if ( j == m_conditions.end() )  {
-          handler(d);
-          continue;
-        }
-        // printout(INFO,"UserPool","Already calcluated: %s",d->name());
-        continue;
-      }
+      handler.compute(max(m_manager->computeThreads(),0));
+      result.computed_by_thread = handler.thread_callback;
       result.computed = handler.num_callback;
       result.missing -= handler.num_callback;
       if ( do_output && result.computed < deps.size() )  {
@@ -17,6 +17,7 @@
 #include "DD4hep/NamedObject.h"
 #include "DD4hep/DetElement.h"
 #include "DD4hep/Volumes.h"
+#include "DD4hep/MatrixHelpers.h"
 
 // ROOT include files
 #include "TGeoMatrix.h"
@@ -89,6 +90,10 @@ namespace dd4hep {
 
   /// Derived condition data-object definition
   /**
+   *  The transformations are stored only as TGeoHMatrix. The alignment
+   *  computations work on compact copies (12 doubles each), which are
+   *  converted on access and written back with setTransformations().
+   *
    *  \author  M.Frank
    *  \version 1.0
    *  \ingroup DD4HEP_CONDITIONS
@@ -110,6 +115,9 @@ namespace dd4hep {
       TIME_STAMPED = 1<<12
     };
 
+    /// Compact transformation type: rotation and translation as 12 doubles
+    typedef detail::matrix::Affine3x4 Affine;
+
     /// Alignment changes
     Delta                delta;
     /// Intermediate buffer to store the transformation to the world coordination system
@@ -148,6 +156,14 @@ namespace dd4hep {
     const TGeoHMatrix& worldTransformation()  const    {  return worldTrafo;          }
     /// Access the alignment/placement matrix with respect to the world
     const TGeoHMatrix& detectorTransformation() const  {  return detectorTrafo;       }
+    /// Set the transformations from compact matrices. Updates the TGeoHMatrix members
+    void setTransformations(const Affine& world, const Affine& world_delta, const Affine& detector);
+    /// Compact copy of the transformation to the world
+    Affine worldAffine() const       {  return detail::matrix::_affine(worldTrafo);     }
+    /// Compact copy of the delta transformation to the world
+    Affine worldDeltaAffine() const  {  return detail::matrix::_affine(worldDelta);     }
+    /// Compact copy of the transformation to the parent detector element
+    Affine detectorAffine() const    {  return detail::matrix::_affine(detectorTrafo);  }
     /// Access the currently applied alignment/placement matrix
     const Transform3D& localToWorld() const            {  return trToWorld;           }
 
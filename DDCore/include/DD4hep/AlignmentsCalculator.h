@@ -66,6 +66,19 @@ namespace dd4hep {
       AlignmentsCalculator& operator=(const AlignmentsCalculator& mgr) = delete;
       /// Compute all alignment conditions of the internal dependency list
       Result compute(const std::map<DetElement, Delta>& deltas, ConditionsMap& alignments)  const;
+      /// Compute all alignment conditions level by level using worker threads
+      /** Detector elements at the same depth of the hierarchy only depend on their
+       *  parents. Hence each level is computed concurrently by num_threads threads
+       *  using plain 3x4 matrices. The alignment conditions are updated and
+       *  inserted into the conditions map in one go once all levels are done.
+       *  With num_threads <= 1 all levels are computed by the calling thread.
+       *  A level is only shared by as many threads as it has min_per_thread entries
+       *  for each of them, since starting a thread costs more than a few products.
+       */
+      Result compute(const std::map<DetElement, Delta>& deltas,
+                     ConditionsMap& alignments,
+                     size_t num_threads,
+                     size_t min_per_thread = 32)  const;
     };
 
     /// Add results
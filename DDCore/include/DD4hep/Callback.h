@@ -358,6 +358,13 @@ namespace dd4hep {
     void clear() {
       callbacks.clear();
     }
+    /// Remove all callbacks of the given object
+    void remove(const void* pointer)  {
+      for( Callbacks::iterator i = callbacks.begin(); i != callbacks.end(); )  {
+        if ( (*i).par == pointer ) i = callbacks.erase(i);
+        else ++i;
+      }
+    }
     /// Generically Add a new callback to the sequence depending on the location arguments
     void add(const Callback& cb,Location where) {
       if ( where == CallbackSequence::FRONT )
@@ -162,5 +162,57 @@ namespace dd4hep {
     virtual void fieldComponents(const double* pos, double* field);
   };
 
+  /// Implementation object of a field map defined on a regular grid.
+  /**
+   *  The field values are given at the nodes of a regular grid and are
+   *  interpolated linearly in between. Two grid geometries are supported:
+   *
+   *  \li CARTESIAN:   nodes (x,y,z) with values (Bx,By,Bz). Trilinear interpolation.
+   *  \li CYLINDRICAL: nodes (r,z) with values (Br,Bz). Bilinear interpolation,
+   *                   the field is assumed to be symmetric in phi.
+   *
+   *  The values of each component are stored in a separate contiguous array
+   *  with the first axis running fastest. The grid cell of the last lookup is
+   *  cached per thread, since consecutive steps of a track mostly stay within
+   *  the same cell. Outside the grid the field does not contribute.
+   *
+   *  Maps are read from text files with one node per line ("x y z Bx By Bz"
+   *  or "r z Br Bz"; lines starting with '#' are ignored) or from binary files
+   *  with the same columns stored as native doubles. Binary files are memory
+   *  mapped. The nodes may be given in any order.
+   *
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class GriddedField : public CartesianField::Object {
+  public:
+    /// Grid geometries
+    enum Geometry { CARTESIAN = 0, CYLINDRICAL = 1 };
+    /// Grid geometry
+    int                 geometry;
+    /// Number of nodes per axis: (x,y,z) or (r,z)
+    int                 nodes[3];
+    /// Coordinate of the first node per axis
+    double              origin[3];
+    /// Node spacing per axis
+    double              step[3];
+    /// Inverse of the node spacing per axis
+    double              invStep[3];
+    /// Field values per component. Node (i,j,k) has the index i + nodes[0]*(j + nodes[1]*k)
+    std::vector<double> values[3];
+    /// Unique identifier of the grid definition. Zero if no grid is defined
+    long                gridID;
+
+  public:
+    /// Initializing constructor
+    GriddedField();
+    /// Load the field map from file. Coordinates and values are multiplied with the units
+    void load(const std::string& file_name, bool binary, double length_unit, double field_unit);
+    /// Define the grid from a table of nodes with 6 (CARTESIAN) or 4 (CYLINDRICAL) columns
+    void fill(const double* table, std::size_t num_nodes, double length_unit, double field_unit);
+    /// Call to access the field components at a given location
+    virtual void fieldComponents(const double* pos, double* field);
+  };
+
 }         /* End namespace dd4hep             */
 #endif    /* DD4HEP_DDCORE_FIELDTYPES_H     */
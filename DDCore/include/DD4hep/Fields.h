@@ -131,6 +131,35 @@ namespace dd4hep {
     typedef std::map<std::string, std::string> PropertyValues;
     typedef std::map<std::string, PropertyValues> Properties;
 
+    /// Flat description of one field component used by the compiled evaluation
+    /**
+     *  The field types known to DD4hep are evaluated without virtual call.
+     *  Components are skipped without evaluation if the position is outside
+     *  their axis aligned bounding box.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class Component  {
+    public:
+      enum Kind  {
+        GENERIC = 0, CONSTANT, SOLENOID, DIPOLE, MULTIPOLE, GRIDDED
+      };
+      /// Implementation type
+      int                     kind;
+      /// Lower corner of the bounding box
+      double                  lower[3];
+      /// Upper corner of the bounding box
+      double                  upper[3];
+      /// Field implementation
+      CartesianField::Object* object;
+
+      /// Describe a field component. Implemented in FieldTypes.cpp
+      static Component build(CartesianField field);
+      /// Add the field of all components at a given location. Implemented in FieldTypes.cpp
+      static void evaluate(const std::vector<Component>& components, const double* pos, double* field);
+    };
+
     /// Internal data class shared by all handles
     /**
      *  \author  M.Frank
@@ -144,6 +173,12 @@ namespace dd4hep {
       CartesianField magnetic;
       std::vector<CartesianField> electric_components;
       std::vector<CartesianField> magnetic_components;
+      /// Compiled electric field components
+      std::vector<Component> electric_compiled;   //! not persistent
+      /// Compiled magnetic field components
+      std::vector<Component> magnetic_compiled;   //! not persistent
+      /// Flag if the compiled components are valid
+      bool compiled = false;                      //! not persistent
       /// Field extensions
       Properties properties;
       /// Default constructor
@@ -172,6 +207,9 @@ namespace dd4hep {
     /// Add a new field component
     void add(CartesianField field);
 
+    /// Flatten the field components for fast evaluation. Invalidated by add()
+    void compile();
+
     /// Returns the 3 electric field components (x, y, z) if many components are present
     void combinedElectric(const Position& pos, double* field) const {
       combinedElectric((const double*) &pos, field);
@@ -222,8 +260,9 @@ namespace dd4hep {
     /// Returns the 3 electric field components (x, y, z).
     void electricField(const double* pos, double* field) const {
       field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->electric;
-      f.isValid() ? f.value(pos, field) : combinedElectric(pos, field);
+      Object* o = data<Object>();
+      CartesianField f = o->electric;
+      f.isValid() && !o->compiled ? f.value(pos, field) : combinedElectric(pos, field);
     }
 
     /// Returns the 3 magnetic field components (x, y, z).
@@ -246,8 +285,9 @@ namespace dd4hep {
     /// Returns the 3  magnetic field components (x, y, z).
     void magneticField(const double* pos, double* field) const {
       field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->magnetic;
-      f.isValid() ? f.value(pos, field) : combinedMagnetic(pos, field);
+      Object* o = data<Object>();
+      CartesianField f = o->magnetic;
+      f.isValid() && !o->compiled ? f.value(pos, field) : combinedMagnetic(pos, field);
     }
 
     /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
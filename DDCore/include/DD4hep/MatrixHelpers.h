@@ -31,6 +31,80 @@ namespace dd4hep {
     /// Namespace for the AIDA detector description matrix helpers
     namespace matrix {
 
+      /// Compact affine transformation: 3x3 rotation and translation stored as 12 doubles
+      /**
+       *  The matrix elements are stored row-major as 3x4 matrix:
+       *  { r00 r01 r02 t0   r10 r11 r12 t1   r20 r21 r22 t2 }
+       *  Unlike TGeoMatrix there is no virtual dispatch, no TObject overhead
+       *  and no checks of rotation/translation flags: the object is cheap to
+       *  copy and the point transformations inline to a few multiply-adds.
+       *
+       *  \version 1.0
+       *  \ingroup DD4HEP_CORE
+       */
+      class Affine3x4  {
+      public:
+        /// Matrix elements (row-major 3x4)
+        double m[12];
+      public:
+        /// Default constructor: identity transformation
+        Affine3x4() : m{1e0,0e0,0e0,0e0, 0e0,1e0,0e0,0e0, 0e0,0e0,1e0,0e0}  {}
+        /// Initializing constructor from row-major 3x3 rotation and translation
+        Affine3x4(const double* rot, const double* tr)
+          : m{rot[0],rot[1],rot[2],tr[0], rot[3],rot[4],rot[5],tr[1], rot[6],rot[7],rot[8],tr[2]}  {}
+        /// Copy constructor
+        Affine3x4(const Affine3x4& copy) = default;
+        /// Assignment operator
+        Affine3x4& operator=(const Affine3x4& copy) = default;
+        /// Transform a point from the local to the master frame
+        void localToMaster(const double* l, double* g)  const   {
+          const double x = l[0], y = l[1], z = l[2];
+          g[0] = m[0]*x + m[1]*y + m[2] *z + m[3];
+          g[1] = m[4]*x + m[5]*y + m[6] *z + m[7];
+          g[2] = m[8]*x + m[9]*y + m[10]*z + m[11];
+        }
+        /// Transform a point from the master to the local frame (rotation must be orthogonal)
+        void masterToLocal(const double* g, double* l)  const   {
+          const double x = g[0]-m[3], y = g[1]-m[7], z = g[2]-m[11];
+          l[0] = m[0]*x + m[4]*y + m[8] *z;
+          l[1] = m[1]*x + m[5]*y + m[9] *z;
+          l[2] = m[2]*x + m[6]*y + m[10]*z;
+        }
+        /// Transform a direction vector from the local to the master frame
+        void localToMasterVect(const double* l, double* g)  const   {
+          const double x = l[0], y = l[1], z = l[2];
+          g[0] = m[0]*x + m[1]*y + m[2] *z;
+          g[1] = m[4]*x + m[5]*y + m[6] *z;
+          g[2] = m[8]*x + m[9]*y + m[10]*z;
+        }
+        /// Composition: (*this) * right, i.e. right is applied first
+        Affine3x4 operator*(const Affine3x4& r)  const   {
+          Affine3x4 res;
+          for( int i = 0; i < 3; ++i )  {
+            const double* a = m + 4*i;
+            double*       c = res.m + 4*i;
+            c[0] = a[0]*r.m[0] + a[1]*r.m[4] + a[2]*r.m[8];
+            c[1] = a[0]*r.m[1] + a[1]*r.m[5] + a[2]*r.m[9];
+            c[2] = a[0]*r.m[2] + a[1]*r.m[6] + a[2]*r.m[10];
+            c[3] = a[0]*r.m[3] + a[1]*r.m[7] + a[2]*r.m[11] + a[3];
+          }
+          return res;
+        }
+        /// In-place composition from the left: (*this) = left * (*this)
+        Affine3x4& multiplyLeft(const Affine3x4& left)   {
+          return *this = left * (*this);
+        }
+        /// Access the translation component
+        Position translation()  const   {  return Position(m[3], m[7], m[11]);  }
+      };
+
+      /// Convert a TGeoMatrix object to a compact affine transformation                        \ingroup DD4HEP \ingroup DD4HEP_CORE
+      Affine3x4        _affine(const TGeoMatrix& matrix);
+      /// Convert a Transform3D object to a compact affine transformation                       \ingroup DD4HEP \ingroup DD4HEP_CORE
+      Affine3x4        _affine(const Transform3D& trans);
+      /// Set a compact affine transformation to a TGeoHMatrix                                  \ingroup DD4HEP \ingroup DD4HEP_CORE
+      TGeoHMatrix&     _transform(TGeoHMatrix& mat, const Affine3x4& affine);
+
       /// Access the TGeo identity transformation                                               \ingroup DD4HEP \ingroup DD4HEP_CORE
       TGeoIdentity*    _identity();
       /// Convert a Position object to a TGeoTranslation                                        \ingroup DD4HEP \ingroup DD4HEP_CORE
@@ -63,6 +137,8 @@ namespace dd4hep {
 
       /// Convert a TGeoMatrix object to a generic Transform3D                                  \ingroup DD4HEP \ingroup DD4HEP_CORE
       Transform3D      _transform(const TGeoMatrix* matrix);
+      /// Convert a compact affine transformation to a generic Transform3D                     \ingroup DD4HEP \ingroup DD4HEP_CORE
+      Transform3D      _transform(const Affine3x4& affine);
 
       /// Decompose a generic Transform3D into a translation (Position) and a RotationZYX       \ingroup DD4HEP \ingroup DD4HEP_CORE
       void _decompose(const Transform3D& trafo, Position& pos, RotationZYX& rot);
@@ -80,6 +80,9 @@ namespace dd4hep {
     VolumeID volumeID(const CellID& cellID) const;
     /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
     void neighbours(const CellID& cellID, std::set<CellID>& neighbours) const;
+    /// Adds the neighbours of the given cell ID to a fixed capacity buffer without allocation. Returns the number of added cells
+    std::size_t fillNeighbours(const CellID& cellID, DDSegmentation::CellNeighbours& neighbours,
+                               int connectivity = DDSegmentation::FACE_NEIGHBOURS) const;
     /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
      *  in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
      *
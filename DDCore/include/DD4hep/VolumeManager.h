@@ -20,10 +20,14 @@
 #include "DD4hep/NamedObject.h"
 #include "DD4hep/IDDescriptor.h"
 #include "DD4hep/ConditionsMap.h"
+#include "DD4hep/MatrixHelpers.h"
 
 // ROOT include files
 #include "TGeoMatrix.h"
 
+// C/C++ include files
+#include <atomic>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -57,6 +61,17 @@ namespace dd4hep {
     VolumeID     mask       = ~0x0ULL;
     /// Flag to indicate optional information
     long         flag       = 0;
+    /// Cached nominal volume -> world transformation. Retired entries are kept for one update epoch
+    struct WorldCache  {
+      /// The compact transformation
+      detail::matrix::Affine3x4 trafo;
+      /// Retired transformation, which may still be referenced by readers until the next update
+      WorldCache*               retired = 0;
+      /// Flag set once the placements changed
+      std::atomic<bool>         stale {false};
+    };
+    /// Optional, lazily built cache of the nominal volume -> world transformation
+    mutable std::atomic<WorldCache*> worldCache {nullptr};  //! Not ROOT persistent
   public:
     /// Default constructor
     VolumeManagerContext() = default;
@@ -76,6 +91,21 @@ namespace dd4hep {
     PlacedVolume elementPlacement()  const;
     /// Access the transformation to the closest detector element
     const TGeoHMatrix& toElement()  const;
+    /// Compute the compact nominal volume -> world transformation (toWorld * toElement)
+    detail::matrix::Affine3x4 toWorld()  const;
+    /// Access the cached compact nominal volume -> world transformation
+    /** The transformation is computed on first access and cached.
+     *  If the placements change, the volume manager marks the cache stale and
+     *  the next access builds a new entry. An entry once returned stays valid
+     *  until the second following placement update: callers must not keep
+     *  the reference across alignment updates.
+     */
+    const detail::matrix::Affine3x4& cachedWorld()  const;
+    /// Mark the cached volume -> world transformation stale. It is rebuilt on the next access
+    /** Entries retired by the previous call are freed. Updates must not run
+     *  concurrently with each other.
+     */
+    void resetWorld()  const;
   };
     
   /// Class to support the retrieval of detector elements and volumes given a valid identifier
@@ -118,6 +148,7 @@ namespace dd4hep {
       TREE = 1 << 1,   // Build 1 level DetElement hierarchy while populating
       ONE  = 1 << 2,   // Populate all daughter volumes into one big lookup-container
       // This flag may be in parallel with 'TREE'
+      HASHED = 1 << 3, // Build flat hashed lookup index once populated
       LAST
     };
 
@@ -175,6 +206,11 @@ namespace dd4hep {
     /// Register physical volume with the manager and pre-computed volume id
     bool adoptPlacement(VolumeID volume_id, VolumeManagerContext* context);
 
+    /// Build the flat hashed lookup index of the top level manager. Returns number of indexed entries
+    std::size_t buildIndex();
+    /// Drop the flat hashed lookup index. Lookups then use the map based search
+    void clearIndex();
+
     /** This set of functions is required when reading/analyzing
      *  already created hits which have a VolumeID attached.
      */
@@ -30,12 +30,77 @@
 // ROOT include files
 #include "TGeoMatrix.h"
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
   /// Namespace for implementation details of the AIDA detector description toolkit
   namespace detail {
 
+    class VolumeManagerObject;
+
+    /// Flat lookup index of all placements known to a top level volume manager
+    /**
+     *  The index is an open-addressing hash table keyed by the (masked) volume
+     *  identifier. The subdetector sections are selected by the system field
+     *  of the volume identifier. If all sections share the same system field,
+     *  the section is found by direct indexing of a jump table, otherwise by
+     *  a linear scan over the (few) sections.
+     *
+     *  The index is a snapshot: it is built once the volume manager is populated
+     *  and is invalidated whenever new placements are adopted.
+     *
+     * \version 1.0
+     * \ingroup DD4HEP_CORE
+     */
+    class VolumeManagerIndex  {
+    public:
+      /// Description of one subdetector section
+      struct Section  {
+        /// Mask of the system field in the volume identifier
+        VolumeID sysMask   = 0;
+        /// Value of the system field identifying this section
+        VolumeID sysID     = 0;
+        /// Mask applied to the volume identifier to form the key
+        VolumeID detMask   = ~0x0ULL;
+        /// Offset of the system field in the volume identifier
+        unsigned sysOffset = 0;
+      };
+      /// Subdetector sections in lookup order
+      std::vector<Section>               sections;
+      /// Jump table: system value -> section index (only if all sections share the system field)
+      std::vector<int>                   jump;
+      /// Hash table keys (masked volume identifiers)
+      std::vector<VolumeID>              keys;
+      /// Hash table values. Empty slots are marked with a NULL pointer
+      std::vector<VolumeManagerContext*> values;
+      /// Hash table bucket mask (capacity - 1)
+      std::size_t                        bucketMask = 0;
+      /// Common system field mask for jump table access
+      VolumeID                           sysMask    = 0;
+      /// Common system field offset for jump table access
+      unsigned                           sysOffset  = 0;
+
+    public:
+      /// Default constructor
+      VolumeManagerIndex() = default;
+      /// Check if the index was built
+      bool empty()  const  {  return values.empty();  }
+      /// Remove all entries
+      void clear();
+      /// Build the index from a fully populated top level volume manager
+      std::size_t build(const VolumeManagerObject& top);
+      /// Search the index for a matching volume identifier
+      VolumeManagerContext* search(VolumeID id)  const;
+    private:
+      /// Insert a context into the hash table
+      void insert(VolumeManagerContext* context);
+      /// Probe the hash table for a masked key
+      VolumeManagerContext* probe(VolumeID key)  const;
+    };
+
     /// This structure describes the internal data of the volume manager object
     /**
      *
@@ -65,6 +130,8 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+      /// Optional flat lookup index (only used by the top level manager)
+      VolumeManagerIndex     index;   //! Not ROOT persistent. Rebuilt only by buildIndex()
     public:
       /// Default constructor
       VolumeManagerObject() = default;
@@ -26,6 +26,12 @@ public:
 	virtual Vector3D position(const CellID& cellID) const;
 	/// determine the cell ID based on the position
 	virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+	/// set the underlying decoder and resolve the field accessors
+	virtual void setDecoder(const BitFieldCoder* decoder);
+	/// set the parameters and resolve the field accessors
+	virtual void setParameters(const Parameters& parameters);
+	/// add the neighbours of the given cell ID to a fixed capacity buffer
+	virtual size_t fillNeighbours(const CellID& cellID, CellNeighbours& neighbours, int connectivity = FACE_NEIGHBOURS) const;
 	/// access the grid size in X
 	double gridSizeX() const {
 		return _gridSizeX;
@@ -69,10 +75,12 @@ public:
 	/// set the field name used for X
 	void setFieldNameX(const std::string& fieldName) {
 		_xId = fieldName;
+		resolveFields();
 	}
 	/// set the field name used for Y
 	void setFieldNameY(const std::string& fieldName) {
 		_yId = fieldName;
+		resolveFields();
 	}
 	/** \brief Returns a vector<double> of the cellDimensions of the given cell ID
 	    in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -98,6 +106,22 @@ protected:
 	std::string _xId;
 	/// the field name used for Y
 	std::string _yId;
+	/// the accessor of the field used for X. Resolved when the decoder is set
+	BitFieldAccessor _xField;   //! not persistent
+	/// the accessor of the field used for Y. Resolved when the decoder is set
+	BitFieldAccessor _yField;   //! not persistent
+	/// the field name the accessor for X was resolved for
+	std::string _xFieldId;      //! not persistent
+	/// the field name the accessor for Y was resolved for
+	std::string _yFieldId;      //! not persistent
+
+	/// resolve the field accessors for the current decoder and field names
+	virtual void resolveFields();
+	/// true if the accessors are valid for the current field names.
+	/// Identifiers changed with parameter(name)->setValue() use the access by name until the next resolveFields()
+	bool fieldsResolved() const {
+		return _xField.isValid() && _yField.isValid() && _xFieldId == _xId && _yFieldId == _yId;
+	}
 };
 
 } /* namespace DDSegmentation */
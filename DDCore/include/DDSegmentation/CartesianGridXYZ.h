@@ -26,6 +26,8 @@ public:
 	virtual Vector3D position(const CellID& cellID) const;
 	/// determine the cell ID based on the position
 	virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+	/// add the neighbours of the given cell ID to a fixed capacity buffer
+	virtual size_t fillNeighbours(const CellID& cellID, CellNeighbours& neighbours, int connectivity = FACE_NEIGHBOURS) const;
 	/// access the grid size in Z
 	double gridSizeZ() const {
 		return _gridSizeZ;
@@ -49,6 +51,7 @@ public:
 	/// set the field name used for Z
 	void setFieldNameZ(const std::string& fieldName) {
 		_zId = fieldName;
+		resolveFields();
 	}
 	/** \brief Returns a vector<double> of the cellDimensions of the given cell ID
 	    in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -69,6 +72,17 @@ protected:
 	double _offsetZ;
 	/// the field name used for Z
 	std::string _zId;
+	/// the accessor of the field used for Z. Resolved when the decoder is set
+	BitFieldAccessor _zField;   //! not persistent
+	/// the field name the accessor for Z was resolved for
+	std::string _zFieldId;      //! not persistent
+
+	/// resolve the field accessors for the current decoder and field names
+	virtual void resolveFields();
+	/// true if the accessors are valid for the current field names
+	bool fieldsResolved() const {
+		return CartesianGridXY::fieldsResolved() && _zField.isValid() && _zFieldId == _zId;
+	}
 };
 
 } /* namespace DDSegmentation */
@@ -27,6 +27,8 @@ public:
 	virtual Vector3D position(const CellID& cellID) const;
 	/// determine the cell ID based on the position
 	virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+	/// add the neighbours of the given cell ID to a fixed capacity buffer. Neighbours in phi wrap around the full circle
+	virtual size_t fillNeighbours(const CellID& cellID, CellNeighbours& neighbours, int connectivity = FACE_NEIGHBOURS) const;
 	/// access the grid size in R
 	double gridSizeR() const {
 		return _gridSizeR;
@@ -64,6 +64,73 @@ struct Vector3D {
 	double X, Y, Z;
 };
 
+/// Connectivity of the neighbour search: the maximal number of indices in which a neighbour differs from the cell
+enum NeighbourConnectivity {
+	/// Cells sharing a face: 4 neighbours in 2D, 6 in 3D
+	FACE_NEIGHBOURS = 1,
+	/// Cells sharing a face or an edge: 8 neighbours in 2D, 18 in 3D
+	EDGE_NEIGHBOURS = 2,
+	/// All adjacent cells including the diagonal ones: 8 neighbours in 2D, 26 in 3D
+	ALL_NEIGHBOURS = 3
+};
+
+/// Fixed capacity buffer of neighbouring cell IDs. Filled without heap allocation
+class CellNeighbours {
+public:
+	/// Maximal number of neighbours: all adjacent cells of a 3D grid
+	enum { CAPACITY = 26 };
+	/// Default constructor
+	CellNeighbours() :
+			_size(0) {
+	}
+	/// Number of cell IDs in the buffer
+	size_t size() const {
+		return _size;
+	}
+	/// True if the buffer is empty
+	bool empty() const {
+		return _size == 0;
+	}
+	/// True if no further cell ID can be added
+	bool full() const {
+		return _size == CAPACITY;
+	}
+	/// Access to the first cell ID
+	const CellID* begin() const {
+		return _ids;
+	}
+	/// Access to the end of the cell IDs
+	const CellID* end() const {
+		return _ids + _size;
+	}
+	/// Access to a cell ID by index
+	const CellID& operator[](size_t i) const {
+		return _ids[i];
+	}
+	/// Remove all cell IDs
+	void clear() {
+		_size = 0;
+	}
+	/// True if the cell ID is in the buffer
+	bool contains(const CellID& cID) const {
+		for (unsigned i = 0; i < _size; ++i) {
+			if (_ids[i] == cID) return true;
+		}
+		return false;
+	}
+	/// Append a cell ID. Returns false if the buffer is full or the cell ID is already present
+	bool add(const CellID& cID) {
+		if (_size == CAPACITY || contains(cID)) return false;
+		_ids[_size++] = cID;
+		return true;
+	}
+protected:
+	/// The cell IDs
+	CellID _ids[CAPACITY];
+	/// The number of valid entries
+	unsigned _size;
+};
+
 /// Base class for all segmentations
 class Segmentation {
 public:
@@ -81,6 +148,18 @@ public:
 	virtual VolumeID volumeID(const CellID& cellID) const;
 	/// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
 	virtual void neighbours(const CellID& cellID, std::set<CellID>& neighbours) const;
+	/** \brief Adds the neighbours of the given cell ID to a fixed capacity buffer
+
+	    The search does neither allocate memory nor throw on cells at the boundary
+	    of the valid index range. Neighbours not fitting into the buffer are dropped.
+	    The default implementation treats all index identifiers as a regular grid.
+	    \param cellID the cell ID of which the neighbours are searched
+	    \param neighbours the buffer the neighbours are appended to
+	    \param connectivity the maximal number of indices in which a neighbour differs, see NeighbourConnectivity
+	    \return the number of neighbours added to the buffer
+	*/
+	virtual size_t fillNeighbours(const CellID& cellID, CellNeighbours& neighbours,
+			int connectivity = FACE_NEIGHBOURS) const;
 	/// Access the encoding string
 	virtual std::string fieldDescription() const {
 		return _decoder->fieldDescription();
@@ -122,6 +201,28 @@ public:
 	virtual std::vector<double> cellDimensions(const CellID& cellID) const;
 
 protected:
+	/// Description of one index of a regular grid used by the neighbour search
+	struct GridAxis {
+		/// Default constructor: axis without any valid index
+		GridAxis() :
+				lowest(1), highest(0), period(0) {
+		}
+		/// Axis covering the full value range of a field
+		explicit GridAxis(const BitFieldAccessor& f, long64 numBins = 0) :
+				field(f), lowest(f.minValue()), highest(f.maxValue()), period(numBins) {
+		}
+		/// Accessor of the index field
+		BitFieldAccessor field;
+		/// Lowest valid index
+		long64 lowest;
+		/// Highest valid index
+		long64 highest;
+		/// Number of bins of a periodic index, e.g. phi. 0 if the index is not periodic
+		long64 period;
+	};
+	/// Maximal number of grid axes handled by the neighbour search
+	enum { MAX_GRID_AXES = 8 };
+
 	/// Default constructor used by derived classes passing the encoding string
 	Segmentation(const std::string& cellEncoding = "");
 	/// Default constructor used by derived classes passing an existing decoder
@@ -147,6 +248,12 @@ protected:
 	/// Helper method to convert a 1D position to a cell ID given a vector of binBoundaries
 	static int positionToBin(double position, std::vector<double> const& cellBoundaries, double offset = 0.);
 
+	/// Helper method to add the neighbours of a cell on a regular grid to the buffer. Returns the number of added cells
+	static size_t gridNeighbours(const CellID& cellID, const GridAxis* axes, size_t numAxes, int connectivity,
+			CellNeighbours& neighbours);
+	/// Helper method to describe an azimuthal index binned by positionToBin in [-pi, pi]. Periodic if the bins cover the full circle
+	static GridAxis azimuthalAxis(const BitFieldAccessor& field, double cellSize, double offset = 0.);
+
 	/// The segmentation name
 	std::string _name;
 	/// The segmentation type
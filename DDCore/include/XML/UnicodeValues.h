@@ -139,6 +139,7 @@ UNICODE (file);
 UNICODE (first);
 UNICODE (firstposition);
 UNICODE (firstrotation);
+UNICODE (format);
 UNICODE (formula);
 UNICODE (fraction);
 UNICODE (funit);
@@ -92,6 +92,7 @@ AlignmentData& AlignmentData::operator=(const AlignmentData& copy)  {
   if ( this != &copy )  {
     delta         = copy.delta;
     worldTrafo    = copy.worldTrafo;
+    worldDelta    = copy.worldDelta;
     detectorTrafo = copy.detectorTrafo;
     nodes         = copy.nodes;
     trToWorld     = copy.trToWorld;
@@ -102,6 +103,13 @@ AlignmentData& AlignmentData::operator=(const AlignmentData& copy)  {
   return *this;
 }
 
+/// Set the transformations from compact matrices. Updates the TGeoHMatrix members
+void AlignmentData::setTransformations(const Affine& world, const Affine& world_delta, const Affine& detector)  {
+  detail::matrix::_transform(worldTrafo,    world);
+  detail::matrix::_transform(worldDelta,    world_delta);
+  detail::matrix::_transform(detectorTrafo, detector);
+}
+
 /// print Conditions object
 ostream& operator << (ostream& s, const AlignmentData& data)   {
   stringstream str;
@@ -20,6 +20,11 @@
 #include "DD4hep/MatrixHelpers.h"
 #include "DD4hep/detail/AlignmentsInterna.h"
 
+// C/C++ include files
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
 using namespace dd4hep;
 using namespace dd4hep::align;
 typedef AlignmentsCalculator::Result Result;
@@ -102,6 +107,82 @@ namespace dd4hep {
           except("AlignContext","Failed to add entry: invalid detector handle!");
         }
       };
+
+      /// Work item of the level by level alignment computation
+      /**
+       *  All inputs are resolved by the calling thread before the levels are
+       *  computed. Workers only read the entries of the parent levels and
+       *  write the results of their own entry.
+       *
+       *  \version 1.0
+       *  \ingroup DD4HEP_ALIGNMENTS
+       */
+      class LevelEntry  {
+      public:
+        typedef detail::matrix::Affine3x4 Affine;
+        DetElement          det;
+        const Delta*        delta  = 0;
+        /// Alignment condition already present in the conditions map (if any)
+        AlignmentCondition  cond;
+        /// Index of the closest aligned parent entry. -1 if there is none
+        long                parent = -1;
+        /// Nominal transformations up to the closest aligned parent or the world
+        Affine              toParent;
+        /// Nominal transformations of the detector element
+        Affine              nominalWorld, nominalDetector;
+        /// Results of the computation
+        Affine              worldDelta, worldTrafo, detectorTrafo;
+        /// Initializing constructor
+        LevelEntry(DetElement d, const Delta* del) : det(d), delta(del)  {}
+      };
+      typedef std::vector<LevelEntry>                         LevelEntries;
+      typedef std::unordered_map<DetElement::Object*,size_t>  LevelIndex;
+
+      /// Add a detector element and all its children to the level entries
+      void collect(DetElement det, const Delta* delta, LevelEntries& entries, LevelIndex& index)   {
+        if ( index.find(det.ptr()) == index.end() )  {
+          index.insert(std::make_pair(det.ptr(), entries.size()));
+          entries.emplace_back(det, delta);
+        }
+        for( const auto& c : det.children() )
+          collect(c.second, 0, entries, index);
+      }
+
+      /// Compute the alignment delta as a 3x4 matrix (same conventions as Calculator::computeDelta)
+      detail::matrix::Affine3x4 computeDelta(const Delta& delta)   {
+        const Position&        pos = delta.translation;
+        const Translation3D&   piv = delta.pivot;
+        const RotationZYX&     rot = delta.rotation;
+
+        switch(delta.flags)   {
+        case Delta::HAVE_TRANSLATION+Delta::HAVE_ROTATION+Delta::HAVE_PIVOT:
+          return detail::matrix::_affine(Transform3D(Translation3D(pos)*piv*rot*(piv.Inverse())));
+        case Delta::HAVE_TRANSLATION+Delta::HAVE_ROTATION:
+          return detail::matrix::_affine(Transform3D(rot,pos));
+        case Delta::HAVE_ROTATION+Delta::HAVE_PIVOT:
+          return detail::matrix::_affine(Transform3D(piv*rot*(piv.Inverse())));
+        case Delta::HAVE_ROTATION:   {
+          TGeoHMatrix tr_delta;
+          detail::matrix::_transform(tr_delta, rot);
+          return detail::matrix::_affine(tr_delta);
+        }
+        case Delta::HAVE_TRANSLATION:
+          return detail::matrix::_affine(Transform3D(Translation3D(pos)));
+        default:
+          break;
+        }
+        return detail::matrix::Affine3x4();
+      }
+
+      /// Compute the transformations of one entry. The parent entries must be computed
+      void computeEntry(LevelEntry& e, const LevelEntries& entries)   {
+        LevelEntry::Affine tr_delta = e.delta ? computeDelta(*e.delta) : LevelEntry::Affine();
+        e.worldDelta = e.toParent * tr_delta;
+        if ( e.parent >= 0 )
+          e.worldDelta.multiplyLeft(entries[e.parent].worldDelta);
+        e.worldTrafo    = e.nominalWorld * e.worldDelta;
+        e.detectorTrafo = e.nominalDetector * tr_delta;
+      }
     }
   }       /* End namespace align */
 }         /* End namespace dd4hep     */
@@ -289,3 +370,87 @@ Result AlignmentsCalculator::compute(const std::map<DetElement, Delta>& deltas,
     result += obj.compute(context, i);
   return result;
 }
+
+/// Compute all alignment conditions level by level using worker threads
+Result AlignmentsCalculator::compute(const std::map<DetElement, Delta>& deltas,
+                                     ConditionsMap& alignments,
+                                     size_t num_threads,
+                                     size_t min_per_thread)  const
+{
+  Result       result;
+  LevelEntries entries;
+  LevelIndex   index;
+  std::vector<std::vector<size_t> > levels;
+  // Same ordering as the serial computation: first the detector elements
+  // with deltas ordered by path, then all their children.
+  std::map<DetElement,Delta,Calculator::Context::PathOrdering> ordered_deltas(deltas.begin(), deltas.end());
+
+  entries.reserve(ordered_deltas.size());
+  for( const auto& i : ordered_deltas )  {
+    index.insert(std::make_pair(i.first.ptr(), entries.size()));
+    entries.emplace_back(i.first, &i.second);
+  }
+  for( const auto& i : ordered_deltas )
+    collect(i.first, &i.second, entries, index);
+
+  // Resolve all inputs in this thread: the nominal alignments are created
+  // on first access and the conditions map is not necessarily thread safe.
+  for( size_t n = 0; n < entries.size(); ++n )  {
+    LevelEntry& e   = entries[n];
+    Alignment   nom = e.det.nominal();
+    size_t      lvl = e.det.level();
+    e.cond            = alignments.get(e.det, Keys::alignmentKey);
+    e.nominalWorld    = nom.data().worldAffine();
+    e.nominalDetector = nom.data().detectorAffine();
+    for( DetElement par = e.det.parent(); par.isValid(); par = par.parent() )  {
+      LevelIndex::const_iterator i = index.find(par.ptr());
+      if ( i != index.end() )  {
+        e.parent = (*i).second;
+        break;
+      }
+      AlignmentCondition cond = alignments.get(par, Keys::alignmentKey);
+      if ( cond.isValid() )  {
+        e.toParent.multiplyLeft(cond.data().worldDeltaAffine());
+        break;
+      }
+      e.toParent.multiplyLeft(par.nominal().data().detectorAffine());
+    }
+    if ( levels.size() <= lvl ) levels.resize(lvl+1);
+    levels[lvl].push_back(n);
+  }
+
+  // Compute level by level. Entries of one level only depend on lower levels.
+  size_t max_threads = 1;
+  for( const auto& level : levels )  {
+    size_t nthreads = std::min(num_threads, level.size()/std::max(min_per_thread,size_t(1)));
+    max_threads = std::max(max_threads, nthreads);
+    std::atomic<size_t> next(0);
+    auto worker = [&entries, &level, &next]()  {
+      for( size_t i = next++; i < level.size(); i = next++ )
+        computeEntry(entries[level[i]], entries);
+    };
+    std::vector<std::thread> threads;
+    for( size_t i = 1; i < nthreads; ++i )
+      threads.emplace_back(worker);
+    worker();
+    for( auto& t : threads )
+      t.join();
+  }
+
+  // Update the conditions map in one go
+  for( auto& e : entries )  {
+    AlignmentCondition cond  = e.cond.isValid() ? e.cond : AlignmentCondition("alignment");
+    AlignmentData&     align = cond.data();
+    align.delta         = e.delta ? *e.delta : identity_delta;
+    align.setTransformations(e.worldTrafo, e.worldDelta, e.detectorTrafo);
+    align.trToWorld     = detail::matrix::_transform(e.worldDelta);
+    if ( !e.cond.isValid() )  {
+      cond->hash = ConditionKey(e.det,Keys::alignmentKey).hash;
+      alignments.insert(e.det, Keys::alignmentKey, cond);
+    }
+    ++result.computed;
+  }
+  printout(DEBUG,"ComputeAlignment","Computed %ld alignments in %ld levels with up to %ld threads.",
+           result.computed, levels.size(), max_threads);
+  return result;
+}
@@ -504,6 +504,8 @@ void DetectorImp::endDocument() {
     patcher.patchShapes();
     mapDetectorTypes();
   }
+  /// All field components are known now: flatten them for fast evaluation
+  m_field.compile();
 }
 
 /// Initialize the geometry and set the bounding box of the world volume
@@ -12,8 +12,26 @@
 //==========================================================================
 
 #include "DD4hep/FieldTypes.h"
+#include "DD4hep/Printout.h"
 #include "DD4hep/detail/Handle.inl"
+
+// ROOT include files
+#include "TGeoBBox.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
 #include <cmath>
+#include <limits>
+#include <typeinfo>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace dd4hep;
@@ -26,6 +44,7 @@ DD4HEP_INSTANTIATE_HANDLE(ConstantField);
 DD4HEP_INSTANTIATE_HANDLE(SolenoidField);
 DD4HEP_INSTANTIATE_HANDLE(DipoleField);
 DD4HEP_INSTANTIATE_HANDLE(MultipoleField);
+DD4HEP_INSTANTIATE_HANDLE(GriddedField);
 
 /// Compute  the field components at a given location and add to given field
 void ConstantField::fieldComponents(const double* /* pos */, double* field) {
@@ -124,3 +143,314 @@ void MultipoleField::fieldComponents(const double* pos, double* field) {
     field[2] += B_z;
   }
 }
+
+namespace {
+  /// Per-thread cache of the grid cell found by the last field lookup of one map
+  struct GridCellCache  {
+    long grid    = 0;
+    int  cell[3] = {0, 0, 0};
+    long offset  = 0;
+  };
+  /// Number of per-thread cache slots. Overlaid maps with consecutive identifiers use different slots
+  constexpr long s_numGridCells = 8;
+  thread_local GridCellCache s_gridCells[s_numGridCells];
+  /// Source of unique grid identifiers. Zero is never assigned
+  atomic<long> s_numGrids(0);
+}
+
+/// Initializing constructor
+GriddedField::GriddedField() : geometry(CARTESIAN), gridID(0)  {
+  type = CartesianField::MAGNETIC;
+  for(int i=0; i<3; ++i)  {
+    nodes[i]   = 1;
+    origin[i]  = 0e0;
+    step[i]    = 1e0;
+    invStep[i] = 1e0;
+  }
+}
+
+/// Load the field map from file. Coordinates and values are multiplied with the units
+void GriddedField::load(const string& file_name, bool binary, double length_unit, double field_unit)  {
+  size_t num_columns = geometry == CARTESIAN ? 6 : 4;
+  if ( binary )  {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    struct stat buff;
+    if ( fd < 0 || ::fstat(fd, &buff) != 0 )  {
+      int err = errno;
+      if ( fd >= 0 ) ::close(fd);
+      except("GriddedField","+++ Cannot access field map %s: %s", file_name.c_str(), ::strerror(err));
+    }
+    size_t len = buff.st_size;
+    if ( len == 0 || len % (num_columns*sizeof(double)) != 0 )  {
+      ::close(fd);
+      except("GriddedField","+++ Field map %s: size %ld is no multiple of %ld doubles.",
+             file_name.c_str(), long(len), long(num_columns));
+    }
+    void* mem = ::mmap(0, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( mem == MAP_FAILED )  {
+      except("GriddedField","+++ Cannot map field map %s: %s", file_name.c_str(), ::strerror(errno));
+    }
+    try  {
+      fill((const double*)mem, len/(num_columns*sizeof(double)), length_unit, field_unit);
+    }
+    catch(...)  {
+      ::munmap(mem, len);
+      throw;
+    }
+    ::munmap(mem, len);
+    return;
+  }
+  ifstream in(file_name);
+  if ( !in.good() )  {
+    except("GriddedField","+++ Cannot open field map %s.", file_name.c_str());
+  }
+  vector<double> table;
+  string line;
+  for(size_t num_line=1; getline(in, line); ++num_line)  {
+    size_t first = line.find_first_not_of(" \t\r");
+    if ( first == string::npos || line[first] == '#' ) continue;
+    istringstream str(line);
+    double val;
+    size_t num = 0;
+    for( ; num < num_columns && (str >> val); ++num) table.push_back(val);
+    if ( num != num_columns )  {
+      except("GriddedField","+++ Field map %s line %ld: expected %ld columns.",
+             file_name.c_str(), long(num_line), long(num_columns));
+    }
+  }
+  fill(table.data(), table.size()/num_columns, length_unit, field_unit);
+}
+
+/// Define the grid from a table of nodes with 6 (CARTESIAN) or 4 (CYLINDRICAL) columns
+void GriddedField::fill(const double* table, size_t num_nodes, double length_unit, double field_unit)  {
+  size_t num_axes = geometry == CARTESIAN ? 3 : 2;
+  size_t num_columns = 2*num_axes;
+  size_t num_total = 1;
+  vector<double> coord(num_nodes);
+
+  gridID = 0;
+  if ( 0 == num_nodes )  {
+    except("GriddedField","+++ Field map without nodes.");
+  }
+  // Derive the grid from the distinct node coordinates of each axis
+  for(size_t a=0; a<3; ++a)  {
+    nodes[a] = 1;
+    origin[a] = 0e0;
+    step[a] = invStep[a] = 1e0;
+    if ( a >= num_axes ) continue;
+    for(size_t i=0; i<num_nodes; ++i)
+      coord[i] = table[i*num_columns+a] * length_unit;
+    sort(coord.begin(), coord.end());
+    double lo = coord.front(), hi = coord.back();
+    double tolerance = 1e-9 * max(1e0, hi - lo);
+    auto last = unique(coord.begin(), coord.end(),
+                       [tolerance](double x, double y) { return y - x < tolerance; });
+    size_t num = last - coord.begin();
+    if ( num < 2 )  {
+      except("GriddedField","+++ Field map axis %ld has less than 2 nodes.", long(a));
+    }
+    nodes[a]   = int(num);
+    origin[a]  = lo;
+    step[a]    = (hi - lo) / double(num-1);
+    invStep[a] = 1e0 / step[a];
+    num_total *= num;
+  }
+  if ( num_total != num_nodes )  {
+    except("GriddedField","+++ Field map with %ld nodes does not fill a regular grid of %ld nodes.",
+           long(num_nodes), long(num_total));
+  }
+  // Sort the values into one contiguous array per component
+  vector<char> filled(num_total, 0);
+  for(size_t c=0; c<3; ++c)
+    values[c].assign(c < num_axes ? num_total : 0, 0e0);
+  for(size_t i=0; i<num_nodes; ++i)  {
+    const double* row = table + i*num_columns;
+    long idx = 0;
+    for(size_t a=num_axes; a-- > 0; )  {
+      long k = lround((row[a]*length_unit - origin[a]) * invStep[a]);
+      if ( k < 0 || k >= nodes[a] || fabs(row[a]*length_unit - origin[a] - k*step[a]) > 1e-3*step[a] )  {
+        except("GriddedField","+++ Field map node %ld is not on the regular grid.", long(i));
+      }
+      idx = idx*nodes[a] + k;
+    }
+    if ( filled[idx]++ )  {
+      except("GriddedField","+++ Field map node %ld is defined twice.", long(i));
+    }
+    for(size_t c=0; c<num_axes; ++c)
+      values[c][idx] = row[num_axes+c] * field_unit;
+  }
+  gridID = ++s_numGrids;
+}
+
+/// Compute  the field components at a given location and add to given field
+void GriddedField::fieldComponents(const double* pos, double* field) {
+  if ( 0 == gridID ) return;
+  GridCellCache& cache = s_gridCells[gridID % s_numGridCells];
+  bool   cylindrical = geometry == CYLINDRICAL;
+  int    num_axes = cylindrical ? 2 : 3;
+  double r = 0e0, coord[3], frac[3] = {0e0, 0e0, 0e0};
+
+  if ( cylindrical )  {
+    r = std::sqrt(pos[0]*pos[0] + pos[1]*pos[1]);
+    coord[0] = r;
+    coord[1] = pos[2];
+  }
+  else  {
+    coord[0] = pos[0];
+    coord[1] = pos[1];
+    coord[2] = pos[2];
+  }
+  // Try the cell of the previous lookup first
+  bool hit = cache.grid == gridID;
+  for(int a=0; a<num_axes; ++a)  {
+    double t = (coord[a] - origin[a]) * invStep[a];
+    frac[a] = t - cache.cell[a];
+    if ( !(frac[a] >= 0e0 && frac[a] <= 1e0) )  {
+      hit = false;
+      break;
+    }
+  }
+  if ( !hit )  {
+    // The cache is only updated once the point is known to be inside the grid
+    int  cell[3] = {0, 0, 0};
+    long offset = 0;
+    for(int a=num_axes; a-- > 0; )  {
+      double t = (coord[a] - origin[a]) * invStep[a];
+      // Negated comparison: also rejects NaN
+      if ( !(t >= 0e0 && t <= double(nodes[a]-1)) ) return;
+      cell[a] = std::min(int(t), nodes[a]-2);
+      frac[a] = t - cell[a];
+      offset = offset*nodes[a] + cell[a];
+    }
+    for(int a=0; a<3; ++a) cache.cell[a] = cell[a];
+    cache.grid   = gridID;
+    cache.offset = offset;
+  }
+  long   sy = nodes[0], sz = long(nodes[0])*nodes[1];
+  double fx = frac[0], fy = frac[1], fz = frac[2];
+  if ( cylindrical )  {
+    const double* br = values[0].data() + cache.offset;
+    const double* bz = values[1].data() + cache.offset;
+    double b_r = (br[0]*(1e0-fx) + br[1]*fx)*(1e0-fy) + (br[sy]*(1e0-fx) + br[sy+1]*fx)*fy;
+    double b_z = (bz[0]*(1e0-fx) + bz[1]*fx)*(1e0-fy) + (bz[sy]*(1e0-fx) + bz[sy+1]*fx)*fy;
+    if ( r > 0e0 )  {
+      field[0] += b_r * pos[0] / r;
+      field[1] += b_r * pos[1] / r;
+    }
+    field[2] += b_z;
+    return;
+  }
+  for(int c=0; c<3; ++c)  {
+    const double* v = values[c].data() + cache.offset;
+    double c0 = (v[0]*(1e0-fx)    + v[1]*fx)*(1e0-fy)    + (v[sy]*(1e0-fx)    + v[sy+1]*fx)*fy;
+    double c1 = (v[sz]*(1e0-fx)   + v[sz+1]*fx)*(1e0-fy) + (v[sz+sy]*(1e0-fx) + v[sz+sy+1]*fx)*fy;
+    field[c] += c0*(1e0-fz) + c1*fz;
+  }
+}
+
+namespace {
+  typedef OverlayedField::Component FieldComponent;
+
+  /// Set the bounding box of a component
+  void set_box(FieldComponent& c, double x0, double x1, double y0, double y1, double z0, double z1)  {
+    c.lower[0] = x0;  c.upper[0] = x1;
+    c.lower[1] = y0;  c.upper[1] = y1;
+    c.lower[2] = z0;  c.upper[2] = z1;
+  }
+  /// Bounding box of a component with limited radius and z-range
+  void set_cylinder_box(FieldComponent& c, double r, double z0, double z1)  {
+    set_box(c, -r, r, -r, r, z0, z1);
+  }
+}
+
+/// Describe a field component. Implemented here, where all field types are known
+OverlayedField::Component OverlayedField::Component::build(CartesianField field)  {
+  const double inf = numeric_limits<double>::infinity();
+  CartesianField::Object* obj = field.data<CartesianField::Object>();
+  FieldComponent c;
+  c.kind   = GENERIC;
+  c.object = obj;
+  set_box(c, -inf, inf, -inf, inf, -inf, inf);
+  // Only exact types: sub-classes may overload the field computation
+  const type_info& typ = typeid(*obj);
+  if ( typ == typeid(ConstantField) )  {
+    c.kind = CONSTANT;
+  }
+  else if ( typ == typeid(SolenoidField) )  {
+    SolenoidField* f = static_cast<SolenoidField*>(obj);
+    c.kind = SOLENOID;
+    set_cylinder_box(c, std::max(f->innerRadius, f->outerRadius), f->minZ, f->maxZ);
+  }
+  else if ( typ == typeid(DipoleField) )  {
+    DipoleField* f = static_cast<DipoleField*>(obj);
+    c.kind = DIPOLE;
+    set_cylinder_box(c, f->rmax, f->zmin, f->zmax);
+  }
+  else if ( typ == typeid(MultipoleField) )  {
+    MultipoleField* f = static_cast<MultipoleField*>(obj);
+    c.kind = MULTIPOLE;
+    // The field is restricted to the volume given in the local frame:
+    // The box is spanned by the corners of the volume's box in the global frame.
+    if ( TGeoBBox* box = dynamic_cast<TGeoBBox*>(f->volume.ptr()) )  {
+      Transform3D to_global = f->transform.Inverse();
+      const double* o = box->GetOrigin();
+      double d[3] = { box->GetDX(), box->GetDY(), box->GetDZ() };
+      set_box(c, inf, -inf, inf, -inf, inf, -inf);
+      for(int i=0; i<8; ++i)  {
+        Transform3D::Point p(o[0] + ((i&1) ? d[0] : -d[0]),
+                             o[1] + ((i&2) ? d[1] : -d[1]),
+                             o[2] + ((i&4) ? d[2] : -d[2]));
+        p = to_global * p;
+        double g[3] = { p.X(), p.Y(), p.Z() };
+        for(int a=0; a<3; ++a)  {
+          c.lower[a] = std::min(c.lower[a], g[a]);
+          c.upper[a] = std::max(c.upper[a], g[a]);
+        }
+      }
+    }
+  }
+  else if ( typ == typeid(GriddedField) )  {
+    GriddedField* f = static_cast<GriddedField*>(obj);
+    c.kind = GRIDDED;
+    double hi[3];
+    for(int a=0; a<3; ++a) hi[a] = f->origin[a] + (f->nodes[a]-1)*f->step[a];
+    if ( f->geometry == GriddedField::CYLINDRICAL )
+      set_cylinder_box(c, hi[0], f->origin[1], hi[1]);
+    else
+      set_box(c, f->origin[0], hi[0], f->origin[1], hi[1], f->origin[2], hi[2]);
+  }
+  return c;
+}
+
+/// Add the field of all components at a given location
+void OverlayedField::Component::evaluate(const vector<Component>& components, const double* pos, double* field)  {
+  for(const FieldComponent& c : components)  {
+    if ( pos[0] < c.lower[0] || pos[0] > c.upper[0] ||
+         pos[1] < c.lower[1] || pos[1] > c.upper[1] ||
+         pos[2] < c.lower[2] || pos[2] > c.upper[2] )  {
+      continue;
+    }
+    // Qualified calls: no virtual dispatch and the analytic types can be inlined
+    switch(c.kind)  {
+    case CONSTANT:
+      static_cast<ConstantField*>(c.object)->ConstantField::fieldComponents(pos, field);
+      break;
+    case SOLENOID:
+      static_cast<SolenoidField*>(c.object)->SolenoidField::fieldComponents(pos, field);
+      break;
+    case DIPOLE:
+      static_cast<DipoleField*>(c.object)->DipoleField::fieldComponents(pos, field);
+      break;
+    case MULTIPOLE:
+      static_cast<MultipoleField*>(c.object)->MultipoleField::fieldComponents(pos, field);
+      break;
+    case GRIDDED:
+      static_cast<GriddedField*>(c.object)->GriddedField::fieldComponents(pos, field);
+      break;
+    default:
+      c.object->fieldComponents(pos, field);
+      break;
+    }
+  }
+}
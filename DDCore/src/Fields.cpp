@@ -28,6 +28,11 @@ namespace {
   void calculate_combined_field(vector<CartesianField>& v, const double* pos, double* field) {
     for (const auto& i : v ) i.value(pos, field);
   }
+  void compile_components(const vector<CartesianField>& v, vector<OverlayedField::Component>& c)  {
+    c.clear();
+    c.reserve(v.size());
+    for (const auto& i : v ) c.push_back(OverlayedField::Component::build(i));
+  }
 }
 
 /// Default constructor
@@ -105,6 +110,7 @@ void OverlayedField::add(CartesianField field) {
     Object* o = data<Object>();
     if (o) {
       int typ = field.fieldType();
+      o->compiled = false;
       bool isEle = field.ELECTRIC == (typ & field.ELECTRIC);
       bool isMag = field.MAGNETIC == (typ & field.MAGNETIC);
       if (isEle) {
@@ -128,22 +134,44 @@ void OverlayedField::add(CartesianField field) {
   throw runtime_error("OverlayedField::add: Attempt to add an invalid field.");
 }
 
+/// Flatten the field components for fast evaluation. Invalidated by add()
+void OverlayedField::compile()  {
+  Object* o = data<Object>();
+  compile_components(o->electric_components, o->electric_compiled);
+  compile_components(o->magnetic_components, o->magnetic_compiled);
+  o->compiled = true;
+}
+
 /// Returns the 3 electric field components (x, y, z).
 void OverlayedField::combinedElectric(const double* pos, double* field) const {
+  Object* o = data<Object>();
   field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->electric_components, pos, field);
+  if ( o->compiled )
+    Component::evaluate(o->electric_compiled, pos, field);
+  else
+    calculate_combined_field(o->electric_components, pos, field);
 }
 
 /// Returns the 3  magnetic field components (x, y, z).
 void OverlayedField::combinedMagnetic(const double* pos, double* field) const {
+  Object* o = data<Object>();
   field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->magnetic_components, pos, field);
+  if ( o->compiled )
+    Component::evaluate(o->magnetic_compiled, pos, field);
+  else
+    calculate_combined_field(o->magnetic_components, pos, field);
 }
 
 /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
 void OverlayedField::electromagneticField(const double* pos, double* field) const {
   Object* o = data<Object>();
   field[0] = field[1] = field[2] = 0.;
+  field[3] = field[4] = field[5] = 0.;
+  if ( o->compiled )  {
+    Component::evaluate(o->electric_compiled, pos, field);
+    Component::evaluate(o->magnetic_compiled, pos, field + 3);
+    return;
+  }
   calculate_combined_field(o->electric_components, pos, field);
   calculate_combined_field(o->magnetic_components, pos, field + 3);
 }
@@ -36,6 +36,35 @@ TGeoRotation* dd4hep::detail::matrix::_rotation3D(const Rotation3D& rot3D) {
   return new TGeoRotation("", rot.Phi() * RAD_2_DEGREE, rot.Theta() * RAD_2_DEGREE, rot.Psi() * RAD_2_DEGREE);
 }
 
+/// Convert a TGeoMatrix object to a compact affine transformation \ingroup DD4HEP \ingroup DD4HEP_CORE
+dd4hep::detail::matrix::Affine3x4 dd4hep::detail::matrix::_affine(const TGeoMatrix& matrix)   {
+  return Affine3x4(matrix.GetRotationMatrix(), matrix.GetTranslation());
+}
+
+/// Convert a Transform3D object to a compact affine transformation \ingroup DD4HEP \ingroup DD4HEP_CORE
+dd4hep::detail::matrix::Affine3x4 dd4hep::detail::matrix::_affine(const Transform3D& trans)   {
+  Affine3x4 affine;
+  trans.GetComponents(affine.m);
+  return affine;
+}
+
+/// Convert a compact affine transformation to a generic Transform3D \ingroup DD4HEP \ingroup DD4HEP_CORE
+dd4hep::Transform3D dd4hep::detail::matrix::_transform(const Affine3x4& affine)   {
+  return Transform3D(affine.m, affine.m+12);
+}
+
+/// Set a compact affine transformation to a TGeoHMatrix  \ingroup DD4HEP \ingroup DD4HEP_CORE
+TGeoHMatrix& dd4hep::detail::matrix::_transform(TGeoHMatrix& tr, const Affine3x4& affine)   {
+  const double* a = affine.m;
+  double rot[9] = { a[0], a[1], a[2], a[4], a[5], a[6], a[8], a[9], a[10] };
+  double pos[3] = { a[3], a[7], a[11] };
+  tr.SetRotation(rot);
+  tr.SetTranslation(pos);
+  tr.SetBit(TGeoMatrix::kGeoRotation);
+  tr.SetBit(TGeoMatrix::kGeoTranslation);
+  return tr;
+}
+
 /// Set a RotationZYX object to a TGeoHMatrix            \ingroup DD4HEP \ingroup DD4HEP_CORE
 TGeoHMatrix& dd4hep::detail::matrix::_transform(TGeoHMatrix& tr, const RotationZYX& rot)   {
   tr.RotateZ(rot.Phi()   * RAD_2_DEGREE);
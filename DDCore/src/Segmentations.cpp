@@ -87,6 +87,11 @@ void Segmentation::neighbours(const CellID& cell, std::set<CellID>& nb) const  {
   data<Object>()->segmentation->neighbours(cell, nb);
 }
 
+/// Adds the neighbours of the given cell ID to a fixed capacity buffer without allocation
+std::size_t Segmentation::fillNeighbours(const CellID& cell, DDSegmentation::CellNeighbours& nb, int connectivity) const  {
+  return data<Object>()->segmentation->fillNeighbours(cell, nb, connectivity);
+}
+
 /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
  *  in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
  *
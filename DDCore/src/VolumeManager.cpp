@@ -152,6 +152,17 @@ namespace {
     VolumeContextAllocator::Large* p = (VolumeContextAllocator::Large*)ctxt;
     return (ContextExtension*)p->extension;
   }
+  /// Hash function for the flat volume index (64 bit finalizer of MurmurHash3)
+  inline size_t _hashVolumeID(VolumeID key)  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return size_t(key);
+  }
+  /// Maximal width of the system field to use a direct jump table
+  static constexpr unsigned MAX_JUMP_WIDTH = 16;
 }
 
 /// Namespace for the AIDA detector description toolkit
@@ -423,6 +434,11 @@ namespace dd4hep {
 
 /// Default destructor
 VolumeManagerContext::~VolumeManagerContext() {
+  for( WorldCache* c = worldCache.load(); c; )  {
+    WorldCache* retired = c->retired;
+    delete c;
+    c = retired;
+  }
   if ( 0 == flag ) return;
   _getExtension(this)->~ContextExtension();
 }
@@ -445,6 +461,42 @@ const TGeoHMatrix& VolumeManagerContext::toElement()  const   {
   return ( 0 == flag ) ? identity : _getExtension(this)->toElement;
 }
 
+/// Compute the compact nominal volume -> world transformation
+detail::matrix::Affine3x4 VolumeManagerContext::toWorld()  const   {
+  TGeoHMatrix world(element.nominal().worldTransformation());
+  world.Multiply(&toElement());
+  return detail::matrix::_affine(world);
+}
+
+/// Access the cached compact nominal volume -> world transformation
+const detail::matrix::Affine3x4& VolumeManagerContext::cachedWorld()  const   {
+  WorldCache* cache = worldCache.load(std::memory_order_acquire);
+  while ( !cache || cache->stale.load(std::memory_order_acquire) )   {
+    WorldCache* fresh = new WorldCache();
+    fresh->trafo   = toWorld();
+    fresh->retired = cache;
+    // If another thread was faster, use its result. The stale entry is kept until the next update
+    if ( worldCache.compare_exchange_strong(cache, fresh, std::memory_order_acq_rel) )
+      return fresh->trafo;
+    delete fresh;
+  }
+  return cache->trafo;
+}
+
+/// Mark the cached volume -> world transformation stale
+void VolumeManagerContext::resetWorld()  const   {
+  if ( WorldCache* cache = worldCache.load(std::memory_order_acquire) )  {
+    // Entries retired by the previous update survived one update epoch: free them
+    for( WorldCache* c = cache->retired; c; )  {
+      WorldCache* retired = c->retired;
+      delete c;
+      c = retired;
+    }
+    cache->retired = 0;
+    cache->stale.store(true, std::memory_order_release);
+  }
+}
+
 /// Initializing constructor to create a new object
 VolumeManager::VolumeManager(Detector& description, const string& nam, DetElement elt, Readout ro, int flags) {
   printout(INFO, "VolumeManager", " - populating volume ids - be patient ..."  );
@@ -459,6 +511,9 @@ VolumeManager::VolumeManager(Detector& description, const string& nam, DetElemen
     obj_ptr->flags = flags;
     p.populate(elt);
     node_count = p.numNodes();
+    if ( (flags & HASHED) == HASHED )   {
+      buildIndex();
+    }
   }
   printout(INFO, "VolumeManager", " - populating volume ids - done. %ld nodes.",node_count);
 }
@@ -581,6 +636,11 @@ bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* contex
   if ( i == o.volumes.end()) {
     o.volumes[vid] = context;
     o.detMask |= mask;
+    if ( o.top && !o.top->index.empty() )  {
+      // Adopting new placements invalidates the snapshot of the flat index
+      o.top->index.clear();
+      o.top->flags &= ~VolumeManager::HASHED;
+    }
     err << "Inserted new volume:" << setw(6) << left << o.volumes.size()
         << " Ptr:"  << (void*) pv.ptr()
         << " ["     << pv.name() << "]"
@@ -655,6 +715,38 @@ bool VolumeManager::adoptPlacement(VolumeManagerContext* context) {
   return false;
 }
 
+/// Build the flat hashed lookup index of the top level manager
+size_t VolumeManager::buildIndex()   {
+  if ( isValid() )   {
+    Object& o = _data();
+    if ( o.top && o.top != &o )  {
+      return VolumeManager(o.top).buildIndex();
+    }
+    size_t count = o.index.build(o);
+    o.flags |= HASHED;
+    printout(INFO, "VolumeManager", "+++ Built flat lookup index: %ld entries in %ld sections.",
+             count, o.index.sections.size());
+    return count;
+  }
+  except("VolumeManager","buildIndex: Failed to build lookup index [Invalid Manager Handle]");
+  return 0;
+}
+
+/// Drop the flat hashed lookup index. Lookups then use the map based search
+void VolumeManager::clearIndex()   {
+  if ( isValid() )   {
+    Object& o = _data();
+    if ( o.top && o.top != &o )  {
+      VolumeManager(o.top).clearIndex();
+      return;
+    }
+    o.index.clear();
+    o.flags &= ~HASHED;
+    return;
+  }
+  except("VolumeManager","clearIndex: Failed to drop lookup index [Invalid Manager Handle]");
+}
+
 /// Lookup the context, which belongs to a registered physical volume.
 VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
   if (isValid()) {
@@ -666,6 +758,12 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
       return VolumeManager(o.top).lookupContext(volume_id);
     }
     VolumeID id = volume_id;
+    /// If present, use the flat index of the top level manager
+    if ( is_top && !o.index.empty() )  {
+      if ( (c = o.index.search(id)) != 0 )
+        return c;
+      except("VolumeManager","lookupContext: Failed to search Volume context %016llX [Unknown identifier]", (void*)volume_id);
+    }
     /// First look in our own volume cache if the entry is found.
     c = o.search(id);
     if (c)
@@ -789,8 +887,15 @@ void VolumeManagerObject::update(unsigned long tags, DetElement& det, void* para
   if ( DetElement::PLACEMENT_CHANGED == (tags&DetElement::PLACEMENT_CHANGED) )
     printout(DEBUG,"VolumeManager","+++ Alignment update %s param:%p",det.path().c_str(),param);
   
-  for(const auto& i : volumes )
+  for(const auto& i : volumes )  {
     printout(DEBUG,"VolumeManager","+++ Alignment update %s",i.second->elementPlacement().name());
+    i.second->resetWorld();
+  }
+  /// If all placements are held by the top level manager, these caches must be dropped as well
+  if ( top && top != this && (top->flags&VolumeManager::ONE) == VolumeManager::ONE )  {
+    for(const auto& i : top->volumes )
+      i.second->resetWorld();
+  }
 }
 
 /// Search the locally cached volumes for a matching ID
@@ -799,3 +904,116 @@ VolumeManagerContext* VolumeManagerObject::search(const VolumeID& vol_id) const
   return (i == volumes.end()) ? 0 : (*i).second;
 }
 
+
+/// Remove all entries
+void VolumeManagerIndex::clear()   {
+  sections.clear();
+  jump.clear();
+  keys.clear();
+  values.clear();
+  bucketMask = 0;
+  sysMask    = 0;
+  sysOffset  = 0;
+}
+
+/// Build the index from a fully populated top level volume manager
+size_t VolumeManagerIndex::build(const VolumeManagerObject& top)   {
+  bool   one_tree = (top.flags & VolumeManager::ONE) == VolumeManager::ONE;
+  size_t count    = top.volumes.size();
+  vector<const VolumeManagerObject*> objects;
+
+  clear();
+  /// The sections are defined in the same order as the map based search:
+  /// First the top level volumes, then the subdetector sections.
+  if ( !top.volumes.empty() )  {
+    Section sec;
+    sec.detMask = top.detMask;
+    sections.push_back(sec);
+    objects.push_back(&top);
+  }
+  if ( !one_tree )   {
+    for ( const auto& j : top.subdetectors )  {
+      const VolumeManagerObject& mo = *j.second.ptr();
+      if ( mo.volumes.empty() ) continue;
+      /// Sections without system field match any identifier, like the map based search
+      Section sec;
+      if ( mo.system )  {
+        sec.sysMask   = mo.system->mask();
+        sec.sysOffset = mo.system->offset();
+        sec.sysID     = mo.sysID;
+      }
+      sec.detMask   = mo.detMask;
+      sections.push_back(sec);
+      objects.push_back(&mo);
+      count += mo.volumes.size();
+    }
+  }
+  /// Capacity: power of 2 with a load factor of at most 50 %
+  size_t capacity = 16;
+  while ( capacity < 2*count ) capacity <<= 1;
+  keys.assign(capacity, 0);
+  values.assign(capacity, nullptr);
+  bucketMask = capacity - 1;
+  for ( const auto* obj : objects )  {
+    for ( const auto& v : obj->volumes )
+      insert(v.second);
+  }
+  /// If all subdetector sections share the same system field, we can jump directly
+  bool common = true;
+  for ( const auto& sec : sections )   {
+    if ( sec.sysMask == 0 ) { common = false; break; }
+    if ( sec.sysMask != sections.back().sysMask ) { common = false; break; }
+  }
+  if ( common && !sections.empty() )   {
+    unsigned width = 0;
+    for ( VolumeID m = sections.back().sysMask >> sections.back().sysOffset; m; m >>= 1 ) ++width;
+    if ( width <= MAX_JUMP_WIDTH )  {
+      sysMask   = sections.back().sysMask;
+      sysOffset = sections.back().sysOffset;
+      jump.assign(size_t(1) << width, -1);
+      for ( size_t i = 0; i < sections.size(); ++i )   {
+        int& slot = jump[sections[i].sysID];
+        if ( slot < 0 ) slot = int(i);
+      }
+    }
+  }
+  return count;
+}
+
+/// Insert a context into the hash table
+void VolumeManagerIndex::insert(VolumeManagerContext* context)   {
+  VolumeID key = context->identifier;
+  for ( size_t slot = _hashVolumeID(key) & bucketMask; ; slot = (slot + 1) & bucketMask )  {
+    if ( !values[slot] )  {
+      keys[slot]   = key;
+      values[slot] = context;
+      return;
+    }
+    if ( keys[slot] == key )  {
+      return;      // Duplicates are refused by adoptPlacement: first one wins
+    }
+  }
+}
+
+/// Probe the hash table for a masked key
+VolumeManagerContext* VolumeManagerIndex::probe(VolumeID key)  const   {
+  for ( size_t slot = _hashVolumeID(key) & bucketMask; ; slot = (slot + 1) & bucketMask )  {
+    VolumeManagerContext* c = values[slot];
+    if ( !c ) return 0;
+    if ( keys[slot] == key ) return c;
+  }
+}
+
+/// Search the index for a matching volume identifier
+VolumeManagerContext* VolumeManagerIndex::search(VolumeID id)  const   {
+  if ( !jump.empty() )   {
+    int idx = jump[(id & sysMask) >> sysOffset];
+    return idx < 0 ? 0 : probe(id & sections[idx].detMask);
+  }
+  for ( const auto& sec : sections )   {
+    if ( ((id & sec.sysMask) >> sec.sysOffset) != sec.sysID ) continue;
+    if ( VolumeManagerContext* c = probe(id & sec.detMask) )
+      return c;
+  }
+  return 0;
+}
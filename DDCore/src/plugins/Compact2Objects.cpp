@@ -222,6 +222,37 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+/** Field map on a regular grid
+ *
+ *  <field name="Map" type="FieldMap" field="magnetic" geometry="cylindrical"
+ *         file="fieldmap.txt" format="text" lunit="mm" funit="tesla"/>
+ *
+ *  geometry: cartesian (default) or cylindrical. format: text (default) or binary.
+ *  Relative file names are resolved with respect to the directory of the xml file.
+ */
+static Ref_t create_GriddedField(Detector& /* description */, xml_h e) {
+  xml_comp_t c(e);
+  CartesianField obj;
+  GriddedField* ptr = new GriddedField();
+  double lunit  = c.hasAttr(_U(lunit)) ? c.attr<double>(_U(lunit)) : 1.0;
+  double funit  = c.hasAttr(_U(funit)) ? c.attr<double>(_U(funit)) : 1.0;
+  string geo    = c.hasAttr(_U(geometry)) ? c.attr<string>(_U(geometry)) : string("cartesian");
+  string format = c.hasAttr(_U(format))   ? c.attr<string>(_U(format))   : string("text");
+  string file   = xml::DocumentHandler::system_path(e, c.attr<string>(_U(file)));
+  string t      = c.hasAttr(_U(field))    ? c.attr<string>(_U(field))    : string("magnetic");
+
+  ptr->type     = ::toupper(t[0]) == 'E' ? CartesianField::ELECTRIC : CartesianField::MAGNETIC;
+  ptr->geometry = ::toupper(geo[0]) == 'C' && ::toupper(geo[1]) == 'Y'
+    ? GriddedField::CYLINDRICAL : GriddedField::CARTESIAN;
+  ptr->load(file, ::toupper(format[0]) == 'B', lunit, funit);
+  printout(s_debug_elements ? ALWAYS : DEBUG, "Compact",
+           "++ Field map %s: %d x %d x %d nodes from %s",
+           c.nameStr().c_str(), ptr->nodes[0], ptr->nodes[1], ptr->nodes[2], file.c_str());
+  obj.assign(ptr, c.nameStr(), c.typeStr());
+  return obj;
+}
+DECLARE_XMLELEMENT(FieldMap,create_GriddedField)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
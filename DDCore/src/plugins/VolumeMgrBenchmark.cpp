@@ -0,0 +1,113 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   geoPluginRun -volmgr -destroy -input <compact-file> \
+   -plugin DD4hep_VolumeMgrBenchmark -iterations 10
+
+   Compare the map based volume manager lookup with the flat hashed index.
+*/
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/VolumeManager.h"
+#include "DD4hep/detail/VolumeManagerInterna.h"
+
+// ROOT include files
+#include "TTimeStamp.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <random>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::detail;
+
+namespace  {
+
+  /// Collect all volume identifiers registered to a volume manager tree
+  void collect_ids(const VolumeManagerObject& o, vector<VolumeID>& ids)   {
+    for ( const auto& v : o.volumes )
+      ids.push_back(v.first);
+    for ( const auto& s : o.subdetectors )
+      collect_ids(*s.second.ptr(), ids);
+  }
+
+  /// Time the lookup of all volume identifiers
+  double time_lookup(VolumeManager mgr, const vector<VolumeID>& ids,
+                     vector<VolumeManagerContext*>& result, int iterations)
+  {
+    TTimeStamp start;
+    for ( int i = 0; i < iterations; ++i )   {
+      for ( size_t j = 0; j < ids.size(); ++j )
+        result[j] = mgr.lookupContext(ids[j]);
+    }
+    TTimeStamp stop;
+    return stop.AsDouble() - start.AsDouble();
+  }
+}
+
+/// Plugin function: Benchmark the volume manager lookup modes
+/**
+ *  Factory: DD4hep_VolumeMgrBenchmark
+ */
+static long volmgr_benchmark(Detector& description, int argc, char** argv)  {
+  int  iterations = 10;
+  bool arg_error  = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-iterations",argv[i],4) )
+      iterations = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || iterations <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_VolumeMgrBenchmark                       \n"
+      "     -iterations <number>     Number of passes over all volume identifiers.   \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  VolumeManager mgr = VolumeManager::getVolumeManager(description);
+  vector<VolumeID> ids;
+  collect_ids(*mgr.ptr(), ids);
+  shuffle(ids.begin(), ids.end(), mt19937(12345));
+
+  vector<VolumeManagerContext*> map_result(ids.size()), idx_result(ids.size());
+  mgr.clearIndex();
+  double map_time = time_lookup(mgr, ids, map_result, iterations);
+  mgr.buildIndex();
+  double idx_time = time_lookup(mgr, ids, idx_result, iterations);
+  mgr.clearIndex();
+
+  size_t errors  = 0;
+  for ( size_t i = 0; i < ids.size(); ++i )   {
+    if ( map_result[i] != idx_result[i] )  {
+      printout(ERROR,"VolumeMgrBenchmark","+++ Context mismatch for id:%016llX",ids[i]);
+      ++errors;
+    }
+  }
+  double num_lookups = double(ids.size()) * iterations;
+  printout(ALWAYS,"VolumeMgrBenchmark","+++ %ld volume ids, %d iterations.",ids.size(),iterations);
+  printout(ALWAYS,"VolumeMgrBenchmark","+++ Map   lookup: %8.3f seconds  %8.2f ns/lookup",
+           map_time, 1e9*map_time/num_lookups);
+  printout(ALWAYS,"VolumeMgrBenchmark","+++ Index lookup: %8.3f seconds  %8.2f ns/lookup  speedup: %.2f",
+           idx_time, 1e9*idx_time/num_lookups, idx_time > 0e0 ? map_time/idx_time : 0e0);
+  printout(ALWAYS,"VolumeMgrBenchmark","+++ %s: Num.Errors:%ld", errors ? "FAILED" : "PASSED", errors);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_VolumeMgrBenchmark,volmgr_benchmark)
@@ -85,6 +85,68 @@ namespace DDSegmentation {
 
 
 
+  BitFieldAccessor::BitFieldAccessor( const BitFieldElement& element ) :
+    _mask( element.mask() ),
+    _offset( element.offset() ),
+    _signBit( element.isSigned() ? 1ULL << ( element.width() - 1 ) : 0ULL ),
+    _minVal( element.minValue() ),
+    _maxVal( element.maxValue() ),
+    _element( &element ) {
+  }
+
+  void BitFieldAccessor::outOfRange( long64 in ) const {
+
+    if( _element ) {
+      // throws the same exception as a direct access to the element
+      long64 field = 0 ;
+      _element->set( field, in ) ;
+    }
+    std::stringstream s ;
+    s << " BitFieldAccessor: value out of range : " << in 
+      << " [" << _minVal << "," << _maxVal << "]" ;
+
+    throw( std::runtime_error( s.str() ) ) ;
+  }
+
+  void BitFieldAccessor::decode(const long64* bitfields, size_t count, long64* values) const {
+
+    const ulong64 mask = _mask, sign = _signBit ;
+    const unsigned offset = _offset ;
+
+    for( size_t i=0 ; i<count ; ++i ) {
+      ulong64 val = ( ulong64( bitfields[i] ) & mask ) >> offset ;
+      values[i] = long64( ( val ^ sign ) - sign ) ;
+    }
+  }
+
+  void BitFieldAccessor::encode(long64* bitfields, size_t count, const long64* values) const {
+
+    const ulong64 mask = _mask ;
+    const unsigned offset = _offset ;
+    const long64 minVal = _minVal, maxVal = _maxVal ;
+
+    // check all values first: nothing is written if one of them is out of range
+    bool bad = false ;
+    for( size_t i=0 ; i<count ; ++i )
+      bad |= ( values[i] < minVal ) | ( values[i] > maxVal ) ;
+
+    if( bad ) {
+      for( size_t i=0 ; i<count ; ++i )
+	if( values[i] < minVal || values[i] > maxVal ) outOfRange( values[i] ) ;
+    }
+    for( size_t i=0 ; i<count ; ++i )
+      bitfields[i] = long64( ( ulong64( bitfields[i] ) & ~mask ) | ( ( ulong64( values[i] ) << offset ) & mask ) ) ;
+  }
+
+
+
+  BitFieldAccessor BitFieldCoder::accessor( const std::string& name ) const {
+    
+    IndexMap::const_iterator it = _map.find( name ) ;
+    
+    return it != _map.end() ? BitFieldAccessor( _fields[ it->second ] ) : BitFieldAccessor() ;
+  }
+
   size_t BitFieldCoder::index( const std::string& name) const {
     
     IndexMap::const_iterator it = _map.find( name ) ;
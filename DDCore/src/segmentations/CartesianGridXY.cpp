@@ -24,6 +24,7 @@ CartesianGridXY::CartesianGridXY(const std::string& cellEncoding) :
 	registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
 	registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
 	registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	resolveFields();
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -41,6 +42,7 @@ CartesianGridXY::CartesianGridXY(const BitFieldCoder* decode) :
 	registerParameter("offset_y", "Cell offset in Y", _offsetY, 0., SegmentationParameter::LengthUnit, true);
 	registerIdentifier("identifier_x", "Cell ID identifier for X", _xId, "x");
 	registerIdentifier("identifier_y", "Cell ID identifier for Y", _yId, "y");
+	resolveFields();
 }
 
 /// destructor
@@ -48,19 +50,59 @@ CartesianGridXY::~CartesianGridXY() {
 
 }
 
+/// set the underlying decoder and resolve the field accessors
+void CartesianGridXY::setDecoder(const BitFieldCoder* newDecoder) {
+	this->Segmentation::setDecoder(newDecoder);
+	resolveFields();
+}
+
+/// set the parameters and resolve the field accessors
+void CartesianGridXY::setParameters(const Parameters& pars) {
+	this->Segmentation::setParameters(pars);
+	resolveFields();
+}
+
+/// resolve the field accessors for the current decoder and field names
+void CartesianGridXY::resolveFields() {
+	_xField = _decoder ? _decoder->accessor(_xId) : BitFieldAccessor();
+	_yField = _decoder ? _decoder->accessor(_yId) : BitFieldAccessor();
+	_xFieldId = _xId;
+	_yFieldId = _yId;
+}
+
+/// add the neighbours of the given cell ID to a fixed capacity buffer
+size_t CartesianGridXY::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+	if ( !fieldsResolved() ) {
+		return this->Segmentation::fillNeighbours(cID, cellNeighbours, connectivity);
+	}
+	const GridAxis axes[2] = { GridAxis(_xField), GridAxis(_yField) };
+	return gridNeighbours(cID, axes, 2, connectivity, cellNeighbours);
+}
+
 /// determine the position based on the cell ID
 Vector3D CartesianGridXY::position(const CellID& cID) const {
 	Vector3D cellPosition;
-	cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-	cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
+	// Fields unknown to the decoder or renamed: access by name, which reports the error
+	if ( !fieldsResolved() ) {
+		cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
+		cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
+		return cellPosition;
+	}
+	cellPosition.X = binToPosition( _xField.value(cID), _gridSizeX, _offsetX);
+	cellPosition.Y = binToPosition( _yField.value(cID), _gridSizeY, _offsetY);
 	return cellPosition;
 }
 
 /// determine the cell ID based on the position
   CellID CartesianGridXY::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */, const VolumeID& vID) const {
         CellID cID = vID ;
-	_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
-	_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+	if ( !fieldsResolved() ) {
+		_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+		_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+		return cID ;
+	}
+	_xField.set( cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+	_yField.set( cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
 	return cID ;
 }
 
@@ -21,6 +21,7 @@ CartesianGridXYZ::CartesianGridXYZ(const std::string& cellEncoding) :
 	registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
 	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+	resolveFields();
 }
 
 /// Default constructor used by derived classes passing an existing decoder
@@ -34,6 +35,7 @@ CartesianGridXYZ::CartesianGridXYZ(const BitFieldCoder* decode) :
 	registerParameter("grid_size_z", "Cell size in Z", _gridSizeZ, 1., SegmentationParameter::LengthUnit);
 	registerParameter("offset_z", "Cell offset in Z", _offsetZ, 0., SegmentationParameter::LengthUnit, true);
 	registerIdentifier("identifier_z", "Cell ID identifier for Z", _zId, "z");
+	resolveFields();
 }
 
 /// destructor
@@ -41,21 +43,50 @@ CartesianGridXYZ::~CartesianGridXYZ() {
 
 }
 
+/// resolve the field accessors for the current decoder and field names
+void CartesianGridXYZ::resolveFields() {
+	this->CartesianGridXY::resolveFields();
+	_zField = _decoder ? _decoder->accessor(_zId) : BitFieldAccessor();
+	_zFieldId = _zId;
+}
+
+/// add the neighbours of the given cell ID to a fixed capacity buffer
+size_t CartesianGridXYZ::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+	if ( !fieldsResolved() ) {
+		return this->Segmentation::fillNeighbours(cID, cellNeighbours, connectivity);
+	}
+	const GridAxis axes[3] = { GridAxis(_xField), GridAxis(_yField), GridAxis(_zField) };
+	return gridNeighbours(cID, axes, 3, connectivity, cellNeighbours);
+}
+
 /// determine the position based on the cell ID
 Vector3D CartesianGridXYZ::position(const CellID& cID) const {
 	Vector3D cellPosition;
-	cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
-	cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
-	cellPosition.Z = binToPosition( _decoder->get(cID,_zId ), _gridSizeZ, _offsetZ);
+	// Fields unknown to the decoder or renamed: access by name, which reports the error
+	if ( !fieldsResolved() ) {
+		cellPosition.X = binToPosition( _decoder->get(cID,_xId ), _gridSizeX, _offsetX);
+		cellPosition.Y = binToPosition( _decoder->get(cID,_yId ), _gridSizeY, _offsetY);
+		cellPosition.Z = binToPosition( _decoder->get(cID,_zId ), _gridSizeZ, _offsetZ);
+		return cellPosition;
+	}
+	cellPosition.X = binToPosition( _xField.value(cID), _gridSizeX, _offsetX);
+	cellPosition.Y = binToPosition( _yField.value(cID), _gridSizeY, _offsetY);
+	cellPosition.Z = binToPosition( _zField.value(cID), _gridSizeZ, _offsetZ);
 	return cellPosition;
 }
 
 /// determine the cell ID based on the position
   CellID CartesianGridXYZ::cellID(const Vector3D& localPosition, const Vector3D& /* globalPosition */, const VolumeID& vID) const {
         CellID cID = vID ;
-	_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
-	_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
-	_decoder->set( cID,_zId, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
+	if ( !fieldsResolved() ) {
+		_decoder->set( cID,_xId, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+		_decoder->set( cID,_yId, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+		_decoder->set( cID,_zId, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
+		return cID ;
+	}
+	_xField.set( cID, positionToBin(localPosition.X, _gridSizeX, _offsetX) );
+	_yField.set( cID, positionToBin(localPosition.Y, _gridSizeY, _offsetY) );
+	_zField.set( cID, positionToBin(localPosition.Z, _gridSizeZ, _offsetZ) );
 	return cID ;
 }
 
@@ -7,6 +7,8 @@
 
 #include "DDSegmentation/PolarGridRPhi.h"
 
+#include <algorithm>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -69,6 +71,15 @@ Vector3D PolarGridRPhi::position(const CellID& cID) const {
 	return cID;
 }
 
+/// add the neighbours of the given cell ID to a fixed capacity buffer
+size_t PolarGridRPhi::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+	GridAxis axes[2] = { GridAxis(_decoder->accessor(_rId)),
+			azimuthalAxis(_decoder->accessor(_phiId), _gridSizePhi, _offsetPhi) };
+	// no cells below the one containing the origin
+	axes[0].lowest = std::max(axes[0].lowest, long64(positionToBin(0., _gridSizeR, _offsetR)));
+	return gridNeighbours(cID, axes, 2, connectivity, cellNeighbours);
+}
+
 std::vector<double> PolarGridRPhi::cellDimensions(const CellID& cID) const {
   const double rPhiSize = binToPosition(_decoder->get(cID,_rId), _gridSizeR, _offsetR)*_gridSizePhi;
 #if __cplusplus >= 201103L
@@ -7,6 +7,8 @@
 
 #include "DDSegmentation/PolarGridRPhi2.h"
 
+#include <algorithm>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -85,6 +87,75 @@ Vector3D PolarGridRPhi2::position(const CellID& cID) const {
 }
 
 
+/// add the neighbours of the given cell ID to a fixed capacity buffer
+size_t PolarGridRPhi2::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+	const BitFieldAccessor rField = _decoder->accessor(_rId);
+	const BitFieldAccessor phiField = _decoder->accessor(_phiId);
+	const size_t start = cellNeighbours.size();
+	const long64 numR = std::min(long64(_gridRValues.size()) - 1, long64(_gridPhiValues.size()));
+	const long64 rBin = rField.value(cID);
+
+	if ( !rField.isValid() || !phiField.isValid() || rBin < 0 || rBin >= numR ) {
+		return 0;
+	}
+	// the phi bins of a ring start at the offset and are periodic if they cover the full circle
+	auto ringAxis = [this, &phiField](long64 ring) {
+		const double numBins = 2. * M_PI / _gridPhiValues[ring];
+		const double rounded = std::floor(numBins + 0.5);
+		GridAxis axis(phiField);
+		axis.lowest = std::max(axis.lowest, 0LL);
+		if ( std::fabs(numBins - rounded) < 1e-9 * numBins ) {
+			axis.period = long64(rounded);
+			axis.highest = std::min(axis.highest, axis.period - 1);
+		} else {
+			axis.highest = std::min(axis.highest, long64(std::ceil(numBins)) - 1);
+		}
+		return axis;
+	};
+	// neighbours in phi within the same ring
+	const GridAxis phiAxis = ringAxis(rBin);
+	gridNeighbours(cID, &phiAxis, 1, connectivity, cellNeighbours);
+
+	// the adjacent rings have different phi bins: the neighbours are all cells overlapping the phi range
+	// of the cell, the diagonal neighbours in addition the cells touching it at a corner. The relation is
+	// symmetric as long as the buffer capacity is not exceeded. Phi ranges are taken relative to the offset
+	const double tolerance = 1e-9;
+	const long64 pBin = phiField.value(cID);
+	for (long64 ring = rBin - 1; ring <= rBin + 1; ring += 2) {
+		if ( ring < 0 || ring >= numR || ring < rField.minValue() || ring > rField.maxValue() ) {
+			continue;
+		}
+		const GridAxis ringPhiAxis = ringAxis(ring);
+		const double low  = double(pBin) * _gridPhiValues[rBin] / _gridPhiValues[ring];
+		const double high = double(pBin + 1) * _gridPhiValues[rBin] / _gridPhiValues[ring];
+		long64 first = long64(std::floor(low + tolerance));
+		long64 last  = long64(std::ceil(high - tolerance)) - 1;
+		if ( connectivity > FACE_NEIGHBOURS ) {
+			if ( std::fabs(low - std::floor(low + 0.5)) < tolerance ) --first;
+			if ( std::fabs(high - std::floor(high + 0.5)) < tolerance ) ++last;
+		}
+		// a periodic ring is visited at most once around the circle
+		if ( ringPhiAxis.period > 0 ) {
+			last = std::min(last, first + ringPhiAxis.period - 1);
+		}
+		for (long64 bin = first; bin <= last; ++bin) {
+			long64 nBin = bin;
+			if ( ringPhiAxis.period > 0 ) {
+				nBin %= ringPhiAxis.period;
+				if ( nBin < 0 ) nBin += ringPhiAxis.period;
+			}
+			if ( nBin < ringPhiAxis.lowest || nBin > ringPhiAxis.highest ) {
+				continue;
+			}
+			CellID nID = cID;
+			rField.setUnchecked(nID, ring);
+			phiField.setUnchecked(nID, nBin);
+			cellNeighbours.add(nID);
+		}
+	}
+	return cellNeighbours.size() - start;
+}
+
 std::vector<double> PolarGridRPhi2::cellDimensions(const CellID& cID) const {
 
   const int rBin = _decoder->get(cID,_rId);
@@ -10,6 +10,7 @@
 
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <algorithm>
 
 namespace dd4hep {
 namespace DDSegmentation {
@@ -69,6 +70,17 @@ CellID ProjectiveCylinder::cellID(const Vector3D& /* localPosition */, const Vec
 	return cID;
 }
 
+/// add the neighbours of the given cell ID to a fixed capacity buffer
+size_t ProjectiveCylinder::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+	const double thetaSize = M_PI / (double) _thetaBins;
+	GridAxis axes[2] = { GridAxis(_decoder->accessor(_thetaID)),
+			azimuthalAxis(_decoder->accessor(_phiID), 2 * M_PI / (double) _phiBins, _offsetPhi) };
+	// theta is bounded by the poles
+	axes[0].lowest  = std::max(axes[0].lowest,  long64(positionToBin(0.,   thetaSize, _offsetTheta)));
+	axes[0].highest = std::min(axes[0].highest, long64(positionToBin(M_PI, thetaSize, _offsetTheta)));
+	return gridNeighbours(cID, axes, 2, connectivity, cellNeighbours);
+}
+
 /// determine the polar angle theta based on the cell ID
 double ProjectiveCylinder::theta(const CellID& cID) const {
         CellID thetaIndex = _decoder->get(cID,_thetaID);
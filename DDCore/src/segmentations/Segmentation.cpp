@@ -65,25 +65,22 @@ namespace dd4hep {
 
     /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
     void Segmentation::neighbours(const CellID& cID, std::set<CellID>& cellNeighbours) const {
+      CellNeighbours nb;
+      fillNeighbours(cID, nb, FACE_NEIGHBOURS);
+      cellNeighbours.insert(nb.begin(), nb.end());
+    }
+
+    /// Adds the neighbours of the given cell ID to a fixed capacity buffer
+    size_t Segmentation::fillNeighbours(const CellID& cID, CellNeighbours& cellNeighbours, int connectivity) const {
+      GridAxis axes[MAX_GRID_AXES];
+      size_t numAxes = 0;
       map<std::string, StringParameter>::const_iterator it;
-      for (it = _indexIdentifiers.begin(); it != _indexIdentifiers.end(); ++it) {
-        const std::string& identifier = it->second->typedValue();
-        CellID nID = cID ;
-        int currentValue = _decoder->get(cID,identifier);
-        // add both neighbouring cell IDs, don't add out of bound indices
-        try {
-          _decoder->set(nID,identifier,currentValue - 1);
-          cellNeighbours.insert(nID);
-        } catch (runtime_error& e) {
-          // nothing to do
-        }
-        try {
-          _decoder->set(nID,identifier,currentValue + 1);
-          cellNeighbours.insert(nID);
-        } catch (runtime_error& e) {
-          // nothing to do
-        }
+      for (it = _indexIdentifiers.begin(); it != _indexIdentifiers.end() && numAxes < MAX_GRID_AXES; ++it) {
+        BitFieldAccessor field = _decoder->accessor(it->second->typedValue());
+        // identifiers unknown to the decoder have no neighbours
+        if ( field.isValid() ) axes[numAxes++] = GridAxis(field);
       }
+      return gridNeighbours(cID, axes, numAxes, connectivity, cellNeighbours);
     }
 
     /// Set the underlying decoder
@@ -144,6 +141,69 @@ namespace dd4hep {
       return int(floor((position + 0.5 * cellSize - offset) / cellSize));
     }
 
+    /// Helper method to add the neighbours of a cell on a regular grid to the buffer
+    size_t Segmentation::gridNeighbours(const CellID& cID, const GridAxis* axes, size_t numAxes, int connectivity,
+                                        CellNeighbours& cellNeighbours) {
+      const size_t start = cellNeighbours.size();
+      long64 shifted[MAX_GRID_AXES][2];
+      bool   valid[MAX_GRID_AXES][2];
+      int    step[MAX_GRID_AXES];
+
+      if ( numAxes > MAX_GRID_AXES ) numAxes = MAX_GRID_AXES;
+      // the indices one bin below and above the cell. Periodic indices wrap around
+      for (size_t i = 0; i < numAxes; ++i) {
+        const GridAxis& a = axes[i];
+        const long64 current = a.field.value(cID);
+        for (int k = 0; k < 2; ++k) {
+          long64 idx = current + (k == 0 ? -1 : 1);
+          if ( a.period > 0 ) {
+            if ( idx > a.highest ) idx -= a.period;
+            else if ( idx < a.lowest ) idx += a.period;
+          }
+          shifted[i][k] = idx;
+          valid[i][k]   = idx >= a.lowest && idx <= a.highest && idx != current;
+        }
+        step[i] = 0;
+      }
+      // loop over all combinations of {unchanged, -1, +1} per axis except the cell itself
+      for (;;) {
+        size_t i = 0;
+        for (; i < numAxes; ++i) {
+          if ( ++step[i] < 3 ) break;
+          step[i] = 0;
+        }
+        if ( i == numAxes ) break;
+
+        CellID nID = cID;
+        int changed = 0;
+        bool inRange = true;
+        for (size_t j = 0; j < numAxes && inRange; ++j) {
+          if ( step[j] == 0 ) continue;
+          inRange = valid[j][step[j]-1] && ++changed <= connectivity;
+          axes[j].field.setUnchecked(nID, shifted[j][step[j]-1]);
+        }
+        if ( inRange && nID != cID ) {
+          cellNeighbours.add(nID);
+          if ( cellNeighbours.full() ) break;
+        }
+      }
+      return cellNeighbours.size() - start;
+    }
+
+    /// Helper method to describe an azimuthal index binned by positionToBin in [-pi, pi]
+    Segmentation::GridAxis Segmentation::azimuthalAxis(const BitFieldAccessor& field, double cellSize, double offset) {
+      GridAxis axis(field);
+      // use the same arithmetic as for the cell IDs, the bins at -pi and pi may overlap
+      axis.lowest  = std::max(axis.lowest,  long64(positionToBin(-M_PI, cellSize, offset)));
+      axis.highest = std::min(axis.highest, long64(positionToBin( M_PI, cellSize, offset)));
+      const double numBins = 2. * M_PI / cellSize;
+      const double rounded = std::floor(numBins + 0.5);
+      if ( rounded >= 1. && std::fabs(numBins - rounded) < 1e-9 * numBins ) {
+        axis.period = long64(rounded);
+      }
+      return axis;
+    }
+
     /// Helper method to convert a bin number to a 1D position given a vector of binBoundaries
     double Segmentation::binToPosition(CellID bin, std::vector<double> const& cellBoundaries, double offset) {
       return (cellBoundaries[bin+1] + cellBoundaries[bin])*0.5 + offset;
@@ -30,6 +30,9 @@
 #include "DDCond/ConditionsManagerObject.h"
 #include "DD4hep/detail/ConditionsInterna.h"
 
+// C/C++ include files
+#include <thread>
+
 // Forward declartions
 using namespace std;
 using namespace dd4hep;
@@ -62,6 +65,8 @@ namespace {
     Condition::key_type        key;
     RangeConditions&           rc;
     const IOV&                 req_iov;
+    /// Loading thread: conditions registered by other threads are ignored
+    std::thread::id            thread;
 
   public:
     IOV                        iov;
@@ -69,11 +74,11 @@ namespace {
   public:
     /// Initializing constructor
     ItemCollector(CMD c, Condition::key_type k, const IOV& i, RangeConditions& r)
-      : cmd(c), key(k), rc(r), req_iov(i), iov(i.iovType)  {}
+      : cmd(c), key(k), rc(r), req_iov(i), thread(std::this_thread::get_id()), iov(i.iovType)  {}
     /// ConditionsListener overload: onRegister new condition
     virtual void onRegisterCondition(Condition cond, void* param )  {
       Condition::Object* c = cond.ptr();
-      if ( param == this && key == c->hash &&
+      if ( param == this && key == c->hash && thread == std::this_thread::get_id() &&
            req_iov.iovType == c->iov->iovType &&
            IOV::key_is_contained(c->iov->keyData,req_iov.keyData) )
       {
@@ -107,6 +112,8 @@ namespace {
   private:
     Loaded&    loaded;
     const IOV& req_iov;
+    /// Loading thread: conditions registered by other threads are ignored
+    std::thread::id thread;
 
   public:
     IOV        iov;
@@ -114,11 +121,11 @@ namespace {
   public:
     /// Initializing constructor
     GroupCollector(const IOV& i, Loaded& l)
-      : loaded(l), req_iov(i), iov(req_iov.iovType)  {}
+      : loaded(l), req_iov(i), thread(std::this_thread::get_id()), iov(req_iov.iovType)  {}
     /// ConditionsListener overload: onRegister new condition
     virtual void onRegisterCondition(Condition cond, void* param)  {
       Condition::Object* c = cond.ptr();
-      if ( c && param == this &&
+      if ( c && param == this && thread == std::this_thread::get_id() &&
            req_iov.iovType == c->iov->iovType &&
            IOV::key_is_contained(c->iov->keyData,req_iov.keyData) )
       {
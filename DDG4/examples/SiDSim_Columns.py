@@ -0,0 +1,81 @@
+#
+#
+import os, time, logging, DDG4
+from DDG4 import OutputLevel as Output
+from SystemOfUnits import *
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.DEBUG)
+#
+logging.info("""
+
+   dd4hep simulation example setup DDG4
+   with columnar ROOT output:
+
+   The hits and MC particles of each event are written as flat columns
+   by Geant4Output2ROOTColumns to CLICSiD_Columns_<date>.root.
+   At the end of the job the action prints the number of events,
+   the time spent writing and the number of bytes written.
+   Run the example with e.g. /run/beamOn 100
+
+""")
+
+def run():
+  kernel = DDG4.Kernel()
+  description = kernel.detectorDescription()
+  install_dir = os.environ['DD4hepINSTALL']
+  DDG4.Core.setPrintFormat("%-32s %6s %s")
+  kernel.loadGeometry("file:"+install_dir+"/DDDetectors/compact/SiD.xml")
+  DDG4.importConstants(description)
+
+  geant4 = DDG4.Geant4(kernel,tracker='Geant4TrackerCombineAction')
+  geant4.setupCshUI()
+  geant4.setupTrackingField()
+
+  rndm = DDG4.Action(kernel,'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  logging.info("#PYTHON:  Configure I/O: hits and MC particles as columns")
+  evt_root = DDG4.EventAction(kernel,'Geant4Output2ROOTColumns/ColumnOutput',True)
+  evt_root.HandleMCTruth = True
+  evt_root.Control       = True
+  evt_root.OutputLevel   = Output.INFO
+  evt_root.Output        = 'CLICSiD_Columns_'+time.strftime('%Y-%m-%d_%H-%M')+'.root'
+  evt_root.enableUI()
+  kernel.eventAction().add(evt_root)
+
+  gen = DDG4.GeneratorAction(kernel,"Geant4GeneratorActionInit/GenerationInit")
+  kernel.generatorAction().adopt(gen)
+  logging.info("#PYTHON:  Generation of isotrope tracks: pi+")
+  gen = DDG4.GeneratorAction(kernel,"Geant4IsotropeGenerator/IsotropPi+")
+  gen.Mask     = 1
+  gen.Particle = 'pi+'
+  gen.Energy   = 20 * GeV
+  gen.Multiplicity = 2
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  Merge all existing interaction records")
+  gen = DDG4.GeneratorAction(kernel,"Geant4InteractionMerger/InteractionMerger")
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  Finally generate Geant4 primaries")
+  gen = DDG4.GeneratorAction(kernel,"Geant4PrimaryHandler/PrimaryHandler")
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  ....and handle the simulation particles.")
+  part = DDG4.GeneratorAction(kernel,"Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 100*MeV
+
+  logging.info("#PYTHON:  Setting up all sensitive detectors")
+  seq,act = geant4.setupTracker('SiVertexBarrel')
+  seq,act = geant4.setupTracker('SiTrackerBarrel')
+  seq,act = geant4.setupCalorimeter('EcalBarrel')
+  seq,act = geant4.setupCalorimeter('HcalBarrel')
+
+  phys = geant4.setupPhysics('QGSP_BERT')
+  geant4.execute()
+
+if __name__ == "__main__":
+  run()
@@ -157,8 +157,9 @@ def run():
   seq,act = geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
   #                                           allow_threads=True)
 
-  logging.info("#  Configure G4 magnetic field tracking")
-  geant4.setupTrackingFieldMT()
+  logging.info("#  Configure G4 magnetic field tracking: each worker caches its field values")
+  seq,field = geant4.setupTrackingFieldMT()
+  field.cache_distance = 0.1*mm
 
   logging.info("#  Setup random generator")
   rndm = DDG4.Action(kernel,'Geant4Random/Random')
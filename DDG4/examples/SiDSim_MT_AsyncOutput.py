@@ -0,0 +1,103 @@
+#
+#
+import os, time, logging, DDG4
+from DDG4 import OutputLevel as Output
+from SystemOfUnits import *
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.DEBUG)
+#
+logging.info("""
+
+   dd4hep simulation example setup DDG4
+   in multi-threaded mode with asynchronous ROOT output:
+
+   Every worker thread has its own output action writing to its own file
+   CLICSiD_<date>.<thread-id>.root. The hits and MC particles of each event
+   are written by a dedicated I/O thread of the output action.
+   At the end of the job every output action prints the events/s and MB/s
+   seen by the worker thread and by its I/O thread.
+   Run the example with e.g. /run/beamOn 30
+
+""")
+
+
+def setupWorker(geant4):
+  kernel = geant4.kernel()
+  logging.info('#PYTHON: +++ Creating Geant4 worker thread ....')
+
+  logging.info("\n#PYTHON:  Configure I/O: one output action per worker thread\n")
+  evt_root = DDG4.EventAction(kernel,'Geant4Output2ROOT/RootOutput')
+  evt_root.HandleMCTruth = True
+  evt_root.Control       = True
+  evt_root.FilePerThread = True
+  evt_root.QueueSize     = 5
+  evt_root.Output        = 'CLICSiD_'+time.strftime('%Y-%m-%d_%H-%M')+'.root'
+  kernel.eventAction().adopt(evt_root)
+
+  gen = DDG4.GeneratorAction(kernel,"Geant4GeneratorActionInit/GenerationInit")
+  kernel.generatorAction().adopt(gen)
+  logging.info("#PYTHON:  Generation of isotrope tracks: pi+")
+  gen = DDG4.GeneratorAction(kernel,"Geant4IsotropeGenerator/IsotropPi+")
+  gen.Mask     = 1
+  gen.Particle = 'pi+'
+  gen.Energy   = 20 * GeV
+  gen.Multiplicity = 2
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  Merge all existing interaction records")
+  gen = DDG4.GeneratorAction(kernel,"Geant4InteractionMerger/InteractionMerger")
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  Finally generate Geant4 primaries")
+  gen = DDG4.GeneratorAction(kernel,"Geant4PrimaryHandler/PrimaryHandler")
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  ....and handle the simulation particles.")
+  part = DDG4.GeneratorAction(kernel,"Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 100*MeV
+  logging.info('#PYTHON: +++ Geant4 worker thread configured successfully....')
+  return 1
+
+def setupMaster(geant4):
+  kernel = geant4.master()
+  logging.info('#PYTHON: +++ Setting up master thread for %d workers',kernel.NumberOfThreads)
+  return 1
+
+def setupSensitives(geant4):
+  logging.info("#PYTHON:  Setting up all sensitive detectors")
+  seq,act = geant4.setupTracker('SiVertexBarrel')
+  seq,act = geant4.setupTracker('SiTrackerBarrel')
+  seq,act = geant4.setupCalorimeter('EcalBarrel')
+  seq,act = geant4.setupCalorimeter('HcalBarrel')
+  return 1
+
+def run():
+  kernel = DDG4.Kernel()
+  description = kernel.detectorDescription()
+  install_dir = os.environ['DD4hepINSTALL']
+  DDG4.Core.setPrintFormat("%-32s %6s %s")
+  kernel.loadGeometry("file:"+install_dir+"/DDDetectors/compact/SiD.xml")
+  DDG4.importConstants(description)
+
+  kernel.NumberOfThreads = 3
+  geant4 = DDG4.Geant4(kernel,tracker='Geant4TrackerCombineAction')
+  geant4.setupCshUI()
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4,),
+                               master=setupMaster,master_args=(geant4,))
+  seq,act = geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  seq,act = geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                           sensitives=setupSensitives,sensitives_args=(geant4,))
+  seq,act = geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  geant4.setupTrackingFieldMT()
+
+  rndm = DDG4.Action(kernel,'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  phys = geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,117 @@
+#
+#
+import os, time, logging, DDG4
+from DDG4 import OutputLevel as Output
+from SystemOfUnits import *
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.DEBUG)
+#
+logging.info("""
+
+   dd4hep simulation example setup DDG4
+   in multi-threaded mode with sub-events:
+
+   The interactions of one physics event are simulated as NumSubEvents
+   consecutive Geant4 events on the worker threads and merged before
+   the output is written. Run the example with
+   /run/beamOn <NumSubEvents times the number of physics events>
+
+""")
+
+NumSubEvents = 3
+
+def setupWorker(geant4):
+  kernel = geant4.kernel()
+  logging.info('#PYTHON: +++ Creating Geant4 worker thread ....')
+
+  logging.info("\n#PYTHON:  Configure I/O: called by the merger once per physics event\n")
+  evt_root = DDG4.EventAction(kernel,'Geant4Output2ROOT/RootOutput',True)
+  evt_root.HandleMCTruth = True
+  evt_root.Control = True
+  evt_root.Output = 'CLICSiD_SubEvents_'+time.strftime('%Y-%m-%d_%H-%M')+'.root'
+  kernel.registerGlobalAction(evt_root)
+
+  merger = DDG4.EventAction(kernel,'Geant4SubEventMerger/SubEventMerger')
+  merger.SubEvents = NumSubEvents
+  merger.Outputs = ['RootOutput']
+  merger.OutputLevel = Output.INFO
+  kernel.eventAction().adopt(merger)
+
+  gen = DDG4.GeneratorAction(kernel,"Geant4GeneratorActionInit/GenerationInit")
+  kernel.generatorAction().adopt(gen)
+  #VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
+  logging.info("#PYTHON:  Inputs read once per physics event: 4 pile-up interactions")
+  inputs = []
+  for i in range(4):
+    nam = 'IsotropPi+%d'%(i,)
+    gen = DDG4.GeneratorAction(kernel,"Geant4IsotropeGenerator/"+nam)
+    gen.Mask     = 1<<i
+    gen.Particle = 'pi+'
+    gen.Energy   = 20 * GeV
+    gen.Multiplicity = 2
+    kernel.registerGlobalAction(gen)
+    inputs.append(nam)
+  #^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+
+  logging.info("#PYTHON:  Distribute the interactions to the sub-events and merge them")
+  gen = DDG4.GeneratorAction(kernel,"Geant4InteractionSplitter/InteractionSplitter")
+  gen.SubEvents = NumSubEvents
+  gen.Inputs = inputs
+  gen.OutputLevel = Output.INFO
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  Finally generate Geant4 primaries")
+  gen = DDG4.GeneratorAction(kernel,"Geant4PrimaryHandler/PrimaryHandler")
+  kernel.generatorAction().adopt(gen)
+
+  logging.info("#PYTHON:  ....and handle the simulation particles.")
+  part = DDG4.GeneratorAction(kernel,"Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.SaveProcesses = ['Decay']
+  part.MinimalKineticEnergy = 100*MeV
+  logging.info('#PYTHON: +++ Geant4 worker thread configured successfully....')
+  return 1
+
+def setupMaster(geant4):
+  kernel = geant4.master()
+  logging.info('#PYTHON: +++ Setting up master thread for %d workers',kernel.NumberOfThreads)
+  return 1
+
+def setupSensitives(geant4):
+  logging.info("#PYTHON:  Setting up all sensitive detectors")
+  seq,act = geant4.setupTracker('SiVertexBarrel')
+  seq,act = geant4.setupTracker('SiTrackerBarrel')
+  seq,act = geant4.setupCalorimeter('EcalBarrel')
+  seq,act = geant4.setupCalorimeter('HcalBarrel')
+  return 1
+
+def run():
+  kernel = DDG4.Kernel()
+  description = kernel.detectorDescription()
+  install_dir = os.environ['DD4hepINSTALL']
+  DDG4.Core.setPrintFormat("%-32s %6s %s")
+  kernel.loadGeometry("file:"+install_dir+"/DDDetectors/compact/SiD.xml")
+  DDG4.importConstants(description)
+
+  kernel.NumberOfThreads = 3
+  geant4 = DDG4.Geant4(kernel,tracker='Geant4TrackerCombineAction')
+  ui = geant4.setupCshUI()
+  # Hand out the events one by one to spread the sub-events over the workers
+  ui.Commands = ['/run/eventModulo 1']
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4,),
+                               master=setupMaster,master_args=(geant4,))
+  seq,act = geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  seq,act = geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                           sensitives=setupSensitives,sensitives_args=(geant4,))
+  seq,act = geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  geant4.setupTrackingFieldMT()
+
+  rndm = DDG4.Action(kernel,'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  phys = geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+
+if __name__ == "__main__":
+  run()
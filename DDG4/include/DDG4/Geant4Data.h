@@ -208,6 +208,8 @@ namespace dd4hep {
       static Contribution extractContribution(const G4Step* step);
       /// Extract the MC contribution for a given hit from the step information with BirksLaw option
       static Contribution extractContribution(const G4Step* step, bool ApplyBirksLaw);
+      /// Append the addresses of the track identifiers of all MC contributions of a tracker or calorimeter hit
+      static void trackIDs(Geant4HitData* hit, std::vector<int*>& track_ids);
     };
 
     /// Helper class to define structures used by the generic DDG4 tracker sensitive detector
@@ -246,6 +248,14 @@ namespace dd4hep {
         Hit(int track_id, int pdg_id, double deposit, double time_stamp);
         /// Default destructor
         virtual ~Hit();
+        /// Pooled allocation from a per-thread fixed size allocator
+        void* operator new(size_t size);
+        /// Placement new (required by ROOT)
+        void* operator new(size_t, void* ptr)  {  return ptr;  }
+        /// Return the memory to the per-thread allocator
+        void  operator delete(void* ptr, size_t size);
+        /// Placement delete (required by ROOT)
+        void  operator delete(void*, void*)    {             }
         /// Assignment operator
         Hit& operator=(const Hit& c);
         /// Clear hit content
@@ -288,6 +298,14 @@ namespace dd4hep {
         Hit(const Position& cell_pos);
         /// Default destructor
         virtual ~Hit();
+        /// Pooled allocation from a per-thread fixed size allocator
+        void* operator new(size_t size);
+        /// Placement new (required by ROOT)
+        void* operator new(size_t, void* ptr)  {  return ptr;  }
+        /// Return the memory to the per-thread allocator
+        void  operator delete(void* ptr, size_t size);
+        /// Placement delete (required by ROOT)
+        void  operator delete(void*, void*)    {             }
       };
     };
 
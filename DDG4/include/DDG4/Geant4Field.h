@@ -52,6 +52,49 @@ namespace dd4hep {
       virtual G4bool DoesFieldChangeEnergy() const;
     };
 
+    /// Geant4 field mediator returning the last field value for nearby query points
+    /**
+     *  The integrators query the field several times per step at points close
+     *  to each other. If the query point is within the cache distance of the
+     *  last evaluated point, the last field value is returned.
+     *
+     *  The cache is not protected against concurrent access: in multi-threaded
+     *  mode the field must be set up with Geant4FieldTrackingConstruction,
+     *  which creates one field object per worker thread.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4CachedField : public Geant4Field {
+    protected:
+      /// Square of the cache distance in Geant4 units
+      double         m_distance2;
+      /// Position of the last field evaluation
+      mutable double m_position[3];
+      /// Field value at the last evaluated position
+      mutable double m_value[3];
+      /// Flag if the cached value is valid
+      mutable bool   m_valid;
+      /// Number of queries answered from the cache
+      mutable long   m_numHits;
+      /// Number of queries requiring a field evaluation
+      mutable long   m_numMisses;
+
+    public:
+      /// Constructor. The cache distance is given in Geant4 units
+      Geant4CachedField(OverlayedField field, double distance);
+      /// Standard destructor
+      virtual ~Geant4CachedField() {    }
+      /// Access field values at a given point
+      virtual void GetFieldValue(const double pos[4], double *arr) const  override;
+      /// Number of queries answered from the cache
+      long numHits() const         {  return m_numHits;           }
+      /// Number of queries requiring a field evaluation
+      long numMisses() const       {  return m_numMisses;         }
+      /// Reset the cache and the statistics counters
+      void reset();
+    };
+
   }    // End namespace sim
 }      // End namespace dd4hep
 #endif // DD4HEP_DDG4_GEANT4FIELD_H
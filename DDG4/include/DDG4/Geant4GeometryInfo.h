@@ -40,6 +40,7 @@ class G4VisAttributes;
 class G4VPhysicalVolume;
 class G4AssemblyVolume;
 class G4VSensitiveDetector;
+class G4VTouchable;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -76,6 +77,60 @@ namespace dd4hep {
       //typedef std::map<Geant4PlacementPath, VolumeID>         Geant4PathMap;
     }
 
+    /// Hash index of Geant4 placement paths for allocation free touchable to volume ID lookups
+    /**
+     *  The key is a rolling hash over the physical volumes of the touchable history
+     *  starting from the deepest level. The placement paths are stored flat in one
+     *  array and are compared element-wise to resolve hash collisions.
+     *  A lookup therefore takes O(depth) and does not allocate memory.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4PathIndex  {
+    public:
+      typedef std::vector<const G4VPhysicalVolume*>  Geant4PlacementPath;
+      /// Hash table entry. Empty slots have depth 0
+      struct Entry  {
+        std::size_t hash     = 0;
+        unsigned    depth    = 0;
+        unsigned    offset   = 0;
+        VolumeID    volumeID = 0;
+      };
+    protected:
+      /// Open addressing hash table
+      std::vector<Entry>                    m_table;
+      /// Flattened placement paths referenced by the table entries
+      std::vector<const G4VPhysicalVolume*> m_volumes;
+      /// Bucket mask (capacity - 1)
+      std::size_t                           m_mask = 0;
+
+      /// Locate the table entry of a path given its hash and an element accessor
+      template <typename ACCESSOR> const Entry* locate(std::size_t hash, unsigned depth, const ACCESSOR& acc) const;
+
+    public:
+      /// Default constructor
+      Geant4PathIndex() = default;
+      /// Rolling hash: Combine the hash of the upper levels with the next placement
+      static std::size_t hash(std::size_t seed, const G4VPhysicalVolume* pv)  {
+        std::size_t k = reinterpret_cast<std::size_t>(pv);
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        return (seed ^ k) * 0x100000001b3ULL;
+      }
+      /// Check if the index was built
+      bool empty()  const   {  return m_table.empty();   }
+      /// Number of indexed placement paths
+      std::size_t size()  const;
+      /// Build the index from the map of placement paths
+      void build(const std::map<Geant4PlacementPath, VolumeID>& paths);
+      /// Lookup by placement path. Returns false if the path is not known
+      bool find(const Geant4PlacementPath& path, VolumeID& volume_id)  const;
+      /// Lookup by touchable history. Returns false if the path is not known
+      bool find(const G4VTouchable* touchable, VolumeID& volume_id)  const;
+    };
+
     /// Concreate class holding the relation information between geant4 objects and dd4hep objects.
     /**
      *  \author  M.Frank
@@ -96,6 +151,7 @@ namespace dd4hep {
       std::map<VisAttr, G4VisAttributes*>                      g4Vis;
       std::map<LimitSet, G4UserLimits*>                        g4Limits;
       std::map<Geant4PlacementPath, VolumeID>                  g4Paths;
+      Geant4PathIndex                                          g4PathIndex;
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
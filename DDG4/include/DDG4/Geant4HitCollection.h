@@ -205,8 +205,95 @@ namespace dd4hep {
       typedef std::vector<Geant4HitWrapper>    WrappedHits;
       /// Hit manipulator
       typedef Geant4HitWrapper::HitManipulator Manip;
-      /// Hit key map for fast random lookup
-      typedef std::map<VolumeID, size_t>  Keys;
+
+      /// Hash index of the hit keys for fast random lookup
+      /**
+       *  Open addressing hash table with linear probing mapping
+       *  the hit key (normally the cell identifier) to the hit index.
+       *  The table is never filled to more than half of its capacity.
+       *  Clearing the index keeps the allocated capacity.
+       *
+       * \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Keys  {
+      public:
+        /// Statistics of the index usage for tuning the capacity
+        class Statistics  {
+        public:
+          /// Maximal number of keys
+          size_t peakSize  = 0;
+          /// Number of lookups and insertions
+          size_t lookups   = 0;
+          /// Total number of probed slots
+          size_t probes    = 0;
+          /// Longest probe sequence
+          size_t maxProbe  = 0;
+          /// Number of table growths
+          size_t rehashes  = 0;
+          /// Accumulate the statistics of another index
+          void add(const Statistics& s);
+        };
+        /// Value of empty slots and failed lookups
+        static constexpr size_t npos = size_t(-1);
+
+      protected:
+        /// Keys of the occupied slots
+        std::vector<VolumeID> m_keys;
+        /// Hit index of the slots. Empty slots are marked with npos
+        std::vector<size_t>   m_values;
+        /// Number of keys
+        size_t                m_size = 0;
+        /// Bucket mask (capacity - 1)
+        size_t                m_mask = 0;
+        /// Usage statistics
+        mutable Statistics    m_stat;
+
+        /// Hash function (64 bit finalizer of MurmurHash3)
+        static size_t hash(VolumeID key)  {
+          key ^= key >> 33;
+          key *= 0xff51afd7ed558ccdULL;
+          key ^= key >> 33;
+          key *= 0xc4ceb9fe1a85ec53ULL;
+          key ^= key >> 33;
+          return size_t(key);
+        }
+        /// Slot of the key or the empty slot terminating the probe sequence
+        size_t slot(VolumeID key)  const  {
+          size_t i = hash(key) & m_mask, n = 1;
+          while ( m_values[i] != npos && m_keys[i] != key )  {
+            i = (i + 1) & m_mask;
+            ++n;
+          }
+          ++m_stat.lookups;
+          m_stat.probes += n;
+          if ( n > m_stat.maxProbe ) m_stat.maxProbe = n;
+          return i;
+        }
+        /// Rebuild the table with a new capacity (power of 2)
+        void rehash(size_t capacity);
+
+      public:
+        /// Number of keys
+        size_t size()  const              {  return m_size;           }
+        /// Check if the index is empty
+        bool   empty()  const             {  return m_size == 0;      }
+        /// Number of slots of the hash table
+        size_t capacity()  const          {  return m_values.size();  }
+        /// Access the usage statistics
+        const Statistics& statistics() const  {  return m_stat;       }
+        /// Prepare the table to hold the requested number of keys without growing
+        void   reserve(size_t num_keys);
+        /// Remove all keys. The capacity is kept
+        void   clear();
+        /// Insert a new key. Returns false if the key is already present
+        bool   insert(VolumeID key, size_t value);
+        /// Find the hit index of a key. Returns npos if not present
+        size_t find(VolumeID key)  const  {
+          if ( m_size == 0 ) return npos;
+          return m_values[slot(key)];
+        }
+      };
 
       /// Generic class template to compare/select hits in Geant4HitCollection objects
       /**
@@ -301,6 +388,12 @@ namespace dd4hep {
       const ComponentCast& vector_type() const;
       /// Clear the collection (Deletes all valid references to real hits)
       virtual void clear();
+      /// Reserve space for the expected number of hits and keys
+      void reserve(size_t num_hits);
+      /// Access the key index (statistics for tuning)
+      const Keys& keys()  const   {
+        return m_keys;
+      }
       /// Set optimization flags
       void setOptimize(int flag)  {
         m_flags.value |= flag;
@@ -338,8 +431,7 @@ namespace dd4hep {
       /// Add a new hit with a check, that the hit is of the same type
       template <typename TYPE> void add(VolumeID key, TYPE* hit_pointer) {
         m_lastHit = m_hits.size();
-        std::pair<Keys::iterator,bool> ret = m_keys.insert(std::make_pair(key,m_lastHit));
-        if ( ret.second )  {
+        if ( m_keys.insert(key,m_lastHit) )  {
           Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
           m_hits.push_back(w);
           return;
@@ -352,10 +444,10 @@ namespace dd4hep {
       }
       /// Find hits in a collection by comparison of key value
       template <typename TYPE> TYPE* findByKey(VolumeID key) {
-        Keys::const_iterator i=m_keys.find(key);
-        if ( i == m_keys.end() ) return 0;
-        m_lastHit = (*i).second;
-        TYPE* obj = m_hits.at(m_lastHit);
+        size_t idx = m_keys.find(key);
+        if ( idx == Keys::npos ) return 0;
+        m_lastHit = idx;
+        TYPE* obj = m_hits[m_lastHit];
         return obj;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
@@ -16,8 +16,16 @@
 // Framework include files
 #include "DDG4/Geant4OutputAction.h"
 
+// C/C++ include files
+#include <condition_variable>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <map>
+
 class TFile;
 class TTree;
+class TClass;
 class TBranch;
 
 /// Namespace for the AIDA detector description toolkit
@@ -28,8 +36,33 @@ namespace dd4hep {
   /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
   namespace sim {
 
+    // Forward declarations
+    class Geant4ThreadPool;
+    class Geant4HitCollection;
+
     /// Class to output Geant4 event data to ROOT files
     /**
+     *  Output modes:
+     *  - By default the event data are written synchronously by the event thread.
+     *  - Property "FilePerThread": action instances created for a worker thread
+     *    write to their own file. The thread identifier is added to the file name:
+     *    <name>.root becomes <name>.<thread-id>.root.
+     *    The action must be created in the worker setup without sharing it:
+     *    a shared action is rejected at the start of the run.
+     *  - Property "QueueSize" > 0: at the end of the event processing the action takes
+     *    the hits from the event and keeps a reference to the MC particles. The object
+     *    pointers are handed to a dedicated I/O thread using a bounded queue. The I/O
+     *    thread fills the tree, hence streaming, compression and writing are done
+     *    asynchronously. The event thread only waits if the queue is full. The objects
+     *    are deleted by the event thread, which created them, at its next event or at
+     *    the end of the run, where the thread waits until its events are written.
+     *    In this mode the trees may only be accessed by the I/O thread and fill()
+     *    may not be called directly. Since the hits are taken from the event, only
+     *    one output action per event may use this mode.
+     *
+     *  When the file is closed the number of events and bytes written and the
+     *  throughput seen by the event threads and by the I/O thread are printed.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -38,10 +71,38 @@ namespace dd4hep {
     protected:
       typedef std::map<std::string, TBranch*> Branches;
       typedef std::map<std::string, TTree*> Sections;
+      typedef std::map<const std::type_info*, TClass*> Classes;
+
+      /// Branch data of one event written by the I/O thread
+      class Collection  {
+      public:
+        /// Branch name
+        std::string                 name;
+        /// ROOT class of the branch data
+        TClass*                     cls       = 0;
+        /// Objects of the branch. Owned by the record once taken from the event
+        std::vector<void*>          objects;
+        /// Destructor of the objects after writing
+        void                      (*destroy)(void*) = 0;
+        /// Hit collection owning the objects until the end of the event
+        Geant4HitCollection*        hits      = 0;
+      };
+      /// Data of one event written by the I/O thread
+      class EventRecord  {
+      public:
+        /// Thread processing the event. The objects are deleted by this thread
+        std::thread::id             thread;
+        /// Branch data of the event
+        std::vector<Collection>     collections;
+      };
+      typedef std::map<const G4Event*, EventRecord*> PendingEvents;
+
       /// Known file sections
       Sections m_sections;
       /// Branches in the event tree
       Branches m_branches;
+      /// ROOT classes of the collection types
+      Classes m_classes;
       /// name of the event tree
       std::string m_section;
       /// Reference to the ROOT file to open
@@ -50,11 +111,75 @@ namespace dd4hep {
       TTree* m_tree;
       /// Flag if Monte-Carlo truth should be followed and checked
       bool m_handleMCTruth;
+      /// Property: Worker thread instances write to their own output file
+      bool m_filePerThread;
+      /// Property: Maximal number of events waiting for the I/O thread. 0: synchronous output
+      int  m_queueSize;
+      /// Property: Number of threads remapping the track identifiers of the hits to MC particles
+      int  m_remapThreads;
+      /// Threads remapping the track identifiers. Created on first use if m_remapThreads > 1
+      Geant4ThreadPool* m_remapPool;
+      /// Collections of the event currently processed
+      EventRecord* m_record;
+      /// Events processed, but not yet finished by all event actions
+      PendingEvents m_pending;
+      /// Events written by the I/O thread. The objects are deleted by the event threads
+      std::vector<EventRecord*> m_written;
+      /// Events waiting to be written by the I/O thread
+      std::deque<EventRecord*> m_queue;
+      /// Event currently written by the I/O thread
+      EventRecord* m_writing;
+      /// Protection of the event queue
+      std::mutex m_queueLock;
+      /// Signal the I/O thread that events are waiting
+      std::condition_variable m_haveData;
+      /// Signal the event thread that the queue has space
+      std::condition_variable m_haveSpace;
+      /// Signal the event threads that an event was written
+      std::condition_variable m_haveWritten;
+      /// Reference to the I/O thread
+      std::thread* m_ioThread;
+      /// Flag to stop the I/O thread once the queue is drained
+      bool m_stop;
+      /// Statistics: number of events written
+      long m_numEvents;
+      /// Statistics: number of uncompressed bytes filled into the tree
+      long long m_numBytes;
+      /// Statistics: wall time spent by the event threads in the output action in seconds
+      double m_eventSeconds;
+      /// Statistics: wall time spent by the I/O thread filling the tree in seconds
+      double m_ioSeconds;
+
+      /// Access the ROOT class of a collection type
+      TClass* rootClass(const ComponentCast& type);
+      /// Fill single branch entry. Branches with less entries are padded
+      int fillBranch(const std::string& nam, TClass* cl, void* ptr);
+      /// Add a collection to the event record handed to the I/O thread
+      Collection& addCollection(const std::string& nam, const ComponentCast& type);
+      /// Pad all branches to the number of entries of the event tree and close the entry
+      void commitEntry();
+      /// Hand the event data to the I/O thread. Waits only if the queue is full
+      void push(EventRecord* record);
+      /// Delete the objects of an event record
+      void destroy(EventRecord* record);
+      /// Delete the written events of the calling thread
+      void destroyWritten();
+      /// Body of the I/O thread: fill the queued events to the event tree
+      void write();
+      /// Drain the event queue and stop the I/O thread
+      void stop();
+
     public:
       /// Standard constructor
       Geant4Output2ROOT(Geant4Context* context, const std::string& nam);
       /// Default destructor
       virtual ~Geant4Output2ROOT();
+      /// Set or update client for the use in a new thread fiber
+      virtual void configureFiber(Geant4Context* thread_context);
+      /// Final end-of-event callback: take the event data and hand them to the I/O thread
+      void endEvent(const G4Event* event);
+      /// Geant4 end-of-event callback. Measures the time spent in the output
+      virtual void end(const G4Event* event);
       /// Create/access tree by name for non collection user data
       TTree* section(const std::string& nam);
       /// Fill single EVENT branch entry (Geant4 collection data)
@@ -62,6 +187,8 @@ namespace dd4hep {
 
       /// Callback to store the Geant4 run information
       virtual void beginRun(const G4Run* run);
+      /// Callback at the end of the run: delete the written events of the calling thread
+      virtual void endRun(const G4Run* run);
       /// Callback to store each Geant4 hit collection
       virtual void saveCollection(OutputContext<G4Event>& ctxt, G4VHitsCollection* collection);
       /// Callback to store the Geant4 event
@@ -27,6 +27,7 @@ class G4VProcess;
 // C/C++ include files
 #include <set>
 #include <map>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -36,6 +37,7 @@ namespace dd4hep {
 
     // Forward declarations
     class Geant4Particle;
+    class Geant4ThreadPool;
 
     /// Base class to extend the basic particle class used by DDG4 with user information
     /**
@@ -341,6 +343,13 @@ namespace dd4hep {
       const TrackEquivalents& equivalents() const  {  return equivalentTracks;  }
       /// Access the equivalent track id (shortcut to the usage of TrackEquivalents)
       int particleID(int track, bool throw_if_not_found=true) const;
+      /// Replace in bulk Geant4 track identifiers by the equivalent particle identifiers
+      /** The lookup table is built from the current track equivalents at each call.
+       *  If a thread pool is given, the work is split into equal chunks processed
+       *  by the pool. Unknown tracks are set to -1. Returns the number of unknown tracks.
+       *  Identifiers already set to -1 are left unchanged and are not counted.
+       */
+      std::size_t remapTrackIDs(const std::vector<int*>& track_ids, Geant4ThreadPool* pool=0)  const;
     };
 #endif
 
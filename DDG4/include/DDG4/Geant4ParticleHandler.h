@@ -16,6 +16,7 @@
 
 // Framework include files
 #include "DDG4/Geant4Primary.h"
+#include "DDG4/Geant4ParticleTable.h"
 #include "DDG4/Geant4GeneratorAction.h"
 #include "DDG4/Geant4MonteCarloTruth.h"
 
@@ -107,13 +108,14 @@ namespace dd4hep {
       Geant4PrimaryMap* m_primaryMap;
       /// Local buffer about the 'current' G4Track
       Particle          m_currTrack;
-      /// Map with stored MC Particles
-      ParticleMap       m_particleMap;
-      /// Map associating the G4Track identifiers with identifiers of existing MCParticles
-      TrackEquivalents  m_equivalentTracks;
+      /// Table with stored MC Particles and the G4Track equivalents, indexed by the track identifier
+      Geant4ParticleTable m_particles;
 
       /// Recombine particles and associate the to parents with cleanup
-      int recombineParents();
+      /** Checks the candidates or all particles if empty. On return the candidates
+       *  contain the particles to be checked again. Returns their number.
+       */
+      int recombineParents(std::vector<int>& candidates);
       /// Clear particle maps
       void clear();
       /// Check the record consistency
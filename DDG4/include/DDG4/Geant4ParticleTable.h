@@ -0,0 +1,117 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+#ifndef DD4HEP_DDG4_GEANT4PARTICLETABLE_H
+#define DD4HEP_DDG4_GEANT4PARTICLETABLE_H
+
+// Framework include files
+#include "DDG4/Geant4Particle.h"
+
+// C/C++ include files
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Contiguous particle table used to build the MC truth record of one event
+    /**
+     *  Geant4 numbers the tracks of an event densely starting from 1, the particles
+     *  of the final record are numbered densely starting from 0. Both the particles
+     *  and the track equivalents are hence stored in flat vectors indexed by the
+     *  identifier rather than in node based maps. Parent-daughter relations are
+     *  collected as pairs and sorted into index ranges of flat arrays, before the
+     *  sets of the particles are filled in one go.
+     *
+     *  Note: The table does NOT own the particles. Use releaseParticles()
+     *        to drop the references held by the table.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ParticleTable  {
+    public:
+      typedef Geant4Particle          Particle;
+      typedef std::map<int,Particle*> ParticleMap;
+      typedef std::map<int,int>       TrackEquivalents;
+      /// Marker for tracks without equivalent
+      enum { NO_EQUIVALENT = -1 };
+
+    protected:
+      /// Particles indexed by their identifier. Unused slots are NULL
+      std::vector<Particle*>         m_particles;
+      /// Track equivalents indexed by the Geant4 track identifier
+      std::vector<int>               m_equivalents;
+      /// Parent-daughter pairs registered since the last call to buildRelations()
+      std::vector<std::pair<int,int> > m_links;
+      /// Daughters of particle i: m_daughters[m_firstDaughter[i] ... m_firstDaughter[i+1])
+      std::vector<int>               m_firstDaughter;
+      /// Flat array of daughter identifiers
+      std::vector<int>               m_daughters;
+      /// Number of particles in the table
+      std::size_t                    m_size;
+      /// Number of tracks with equivalent
+      std::size_t                    m_numEquivalents;
+
+    public:
+      /// Default constructor
+      Geant4ParticleTable();
+      /// Default destructor. Particles are NOT released
+      ~Geant4ParticleTable() = default;
+      /// Number of particles in the table
+      std::size_t size() const                   {  return m_size;               }
+      /// Number of tracks with an equivalent
+      std::size_t numEquivalents() const         {  return m_numEquivalents;     }
+      /// Upper bound of the particle identifiers (for iteration)
+      int slots() const                          {  return int(m_particles.size()); }
+      /// Upper bound of the track identifiers with equivalent (for iteration)
+      int equivalentSlots() const                {  return int(m_equivalents.size()); }
+      /// Access particle by identifier. Returns NULL if not present
+      Particle* get(int id) const  {
+        return (id >= 0 && std::size_t(id) < m_particles.size()) ? m_particles[id] : 0;
+      }
+      /// Access the equivalent of a track. Returns NO_EQUIVALENT if not present
+      int equivalent(int g4_id) const  {
+        return (g4_id >= 0 && std::size_t(g4_id) < m_equivalents.size())
+          ? m_equivalents[g4_id] : int(NO_EQUIVALENT);
+      }
+      /// Insert particle. An existing entry is overwritten
+      void insert(int id, Particle* p);
+      /// Remove particle from the table without releasing it
+      Particle* remove(int id);
+      /// Set the equivalent of a track
+      void setEquivalent(int g4_id, int equiv);
+      /// Follow the track equivalents until a particle in the table is found. Returns NULL if none
+      /** If last_id is given, it receives the last track identifier of the chain:
+       *  the identifier of the particle found or the one where the chain ends.
+       */
+      Particle* equivalentParticle(int g4_id, int* last_id=0) const;
+      /// Register a parent-daughter relation
+      void addRelation(int parent, int daughter)  {
+        m_links.push_back(std::make_pair(parent, daughter));
+      }
+      /// Sort the registered relations into index ranges and update the particle's parents and daughters
+      void buildRelations();
+      /// Release all particles and remove them from the table
+      void releaseParticles();
+      /// Clear the table without releasing the particles. Allocated memory is kept
+      void clear();
+      /// Exchange the content with another table
+      void swap(Geant4ParticleTable& other);
+      /// Move the content to the maps of the final record. The table is cleared
+      void exportTo(ParticleMap& particles, TrackEquivalents& equivalents);
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#endif // DD4HEP_DDG4_GEANT4PARTICLETABLE_H
@@ -169,6 +169,8 @@ namespace dd4hep {
       void add(int id, Geant4PrimaryInteraction* interaction);
       /// Retrieve an interaction by it's ID
       Geant4PrimaryInteraction* get(int id) const;
+      /// Remove an interaction from the event and pass ownership to the caller
+      Geant4PrimaryInteraction* release(int id);
       /// Number of interaction contained in the primary event
       size_t size()  const      {        return m_interactions.size();      }
       /// Retrieve all interactions
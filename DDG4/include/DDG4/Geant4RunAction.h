@@ -161,6 +161,11 @@ namespace dd4hep {
       void callAtEnd(Q* p, void (T::*f)(const G4Run*)) {
         m_end.add(p, f);
       }
+      /// Remove all begin-of-run and end-of-run callbacks of an object
+      template <typename Q> void removeCallbacks(Q* p) {
+        m_begin.remove(p);
+        m_end.remove(p);
+      }
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adopt(Geant4RunAction* action);
       /// Begin-of-run callback
@@ -21,12 +21,15 @@
 
 // C/C++ include files
 #include <vector>
+#include <map>
 
 // Forward declarations
 class G4HCofThisEvent;
 class G4Step;
 class G4Event;
 class G4TouchableHistory;
+class G4VTouchable;
+class G4VPhysicalVolume;
 class G4VHitsCollection;
 class G4VReadOutGeometry;
 
@@ -117,6 +120,32 @@ namespace dd4hep {
         DETAILED_MODE = 1<<1
       };
 
+      /// Cache of the last resolved touchable history
+      /** Successive steps of a track mostly stay in the same sensitive volume.
+       *  The cache remembers the placement path of the last touchable and its
+       *  volume ID. Sensitive actions are instantiated per worker thread,
+       *  hence the cache is thread-local by construction.
+       */
+      struct TouchableCache  {
+        enum { MAX_DEPTH = 32 };
+        /// Depth of the cached touchable history. -1 if empty
+        int                      depth = -1;
+        /// Physical volumes of the cached touchable history
+        const G4VPhysicalVolume* volumes[MAX_DEPTH];
+        /// Replica (copy) numbers of the cached touchable history
+        int                      replicas[MAX_DEPTH];
+        /// Volume ID of the cached touchable history
+        VolumeID                 volumeID = 0;
+        /// Statistics: number of cache hits
+        unsigned long            hits     = 0;
+        /// Statistics: number of cache misses
+        unsigned long            misses   = 0;
+        /// Check if the touchable matches the cached entry
+        bool match(const G4VTouchable* touchable)  const;
+        /// Update the cache with a new touchable
+        void set(const G4VTouchable* touchable, VolumeID vid);
+      };
+
     private:
       /// Reference to G4 sensitive detector
       Geant4ActionSD* m_sensitiveDetector = 0;
@@ -126,6 +155,16 @@ namespace dd4hep {
     protected:
       /// Property: Hit creation mode. Maybe one of the enum HitCreationFlags
       int  m_hitCreationMode = 0;
+      /// Property: Enable the cache of the last resolved touchable
+      bool m_useTouchableCache = false;
+      /// Cache of the last resolved touchable
+      TouchableCache m_touchableCache;
+      /// Flag if the end-of-run callback printing the statistics is registered
+      bool m_endRunRegistered = false;
+      /// Property: Expected number of hits per collection to reserve the hit key index (0: no reservation)
+      int  m_collectionCapacity = 0;
+      /// Accumulated usage statistics of the hit key index by collection name
+      std::map<std::string, Geant4HitCollection::Keys::Statistics> m_keyStatistics;
       /// Reference to the detector description object
       Detector& m_detDesc;
       /// Reference to the detector element describing this sensitive element
@@ -163,6 +202,14 @@ namespace dd4hep {
         return m_hitCreationMode;
       }
 
+      /// Property access to the expected number of hits per collection
+      size_t collectionCapacity() const  {
+        return m_collectionCapacity > 0 ? size_t(m_collectionCapacity) : 0;
+      }
+
+      /// Accumulate the hit key index statistics of a collection at the end of the event
+      void addKeyStatistics(const std::string& collection, const Geant4HitCollection::Keys::Statistics& stat);
+
       /// G4VSensitiveDetector internals: Access to the detector name
       std::string detectorName() const {
         return detector().name();
@@ -254,6 +301,14 @@ namespace dd4hep {
        */
       virtual void clear(G4HCofThisEvent* hce);
 
+      /// Register the end-of-run callback printing the statistics if not yet done
+      void registerEndRun();
+      /// Callback at the end of the run: print the touchable cache and hit key index statistics
+      virtual void endRun(const G4Run* run);
+
+      /// Returns the volumeID of the touchable. Uses the touchable cache if enabled
+      VolumeID volumeID(const G4VTouchable* touchable);
+
       /// Returns the volumeID of the sensitive volume corresponding to the step
       /** Combining the VolIDS of the complete geometry path (Geant4TouchableHistory)
        * from the current sensitive volume to the world volume
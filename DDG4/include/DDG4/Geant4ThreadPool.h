@@ -0,0 +1,87 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+#ifndef DD4HEP_DDG4_GEANT4THREADPOOL_H
+#define DD4HEP_DDG4_GEANT4THREADPOOL_H
+
+// C/C++ include files
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Small pool of threads processing the chunks of a piece of work
+    /**
+     *  The threads are started once by the constructor and are reused by every
+     *  call to run(). The calling thread works on the chunks as well, so that
+     *  a pool of N threads processes up to N+1 chunks in parallel.
+     *  Calls to run() from different threads are serialized.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ThreadPool  {
+    public:
+      /// Work function called with the chunk number
+      typedef std::function<void(std::size_t)> Work;
+
+    protected:
+      /// Worker threads
+      std::vector<std::thread> m_threads;
+      /// Serialize calls to run()
+      std::mutex               m_runLock;
+      /// Protect the work description below
+      std::mutex               m_lock;
+      /// Signal new work or termination to the threads
+      std::condition_variable  m_start;
+      /// Signal the end of the last chunk to the caller
+      std::condition_variable  m_done;
+      /// Work currently processed
+      const Work*              m_work = 0;
+      /// Number of chunks of the current work
+      std::size_t              m_numChunks = 0;
+      /// Next chunk to be processed
+      std::size_t              m_nextChunk = 0;
+      /// Number of chunks not yet finished
+      std::size_t              m_pending = 0;
+      /// Flag to stop the threads
+      bool                     m_stop = false;
+
+      /// Take the next chunk and process it. Called with m_lock held
+      bool processChunk(std::unique_lock<std::mutex>& lock);
+      /// Thread body
+      void worker();
+
+    public:
+      /// Initializing constructor. Starts the threads
+      explicit Geant4ThreadPool(std::size_t num_threads);
+      /// No copy constructor
+      Geant4ThreadPool(const Geant4ThreadPool& copy) = delete;
+      /// No assignment
+      Geant4ThreadPool& operator=(const Geant4ThreadPool& copy) = delete;
+      /// Default destructor. Stops and joins the threads
+      ~Geant4ThreadPool();
+      /// Number of threads in the pool
+      std::size_t size() const   {  return m_threads.size();  }
+      /// Process num_chunks chunks of work. Returns when all chunks are finished
+      void run(std::size_t num_chunks, const Work& work);
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#endif // DD4HEP_DDG4_GEANT4THREADPOOL_H
@@ -19,12 +19,22 @@
 #include "DDG4/Geant4ActionPhase.h"
 #include "DDG4/Geant4DetectorConstruction.h"
 
+// C/C++ include files
+#include <map>
+#include <mutex>
+
+// Forward declarations
+class G4Run;
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
   /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
   namespace sim {
 
+    // Forward declarations
+    class Geant4CachedField;
+
     /// Generic Setup component to perform the magnetic field tracking in Geant4
     /** Geant4FieldTrackingSetup.
      *
@@ -58,6 +68,10 @@ namespace dd4hep {
       double      eps_max;
       /// G4PropagatorInField parameter: LargestAcceptableStep
       double      largest_step;
+      /// Geant4CachedField parameter: cache distance. Field values are not cached if <= 0
+      double      cache_distance;
+      /// Reference to the cached field (if used) to access the statistics
+      Geant4CachedField* cached_field;
 
     public:
       /// Default constructor
@@ -66,6 +80,10 @@ namespace dd4hep {
       virtual ~Geant4FieldTrackingSetup();
       /// Perform the setup of the magnetic field tracking in Geant4
       virtual int execute(Detector& description);
+      /// End-of-run callback: print and reset the statistics of the field cache
+      void endRun(const G4Run* run);
+      /// Print and reset the statistics of a field cache
+      void printCacheStatistics(Geant4CachedField* field);
     };
 
     /// Phase action to perform the setup of the Geant4 tracking in magnetic fields
@@ -105,6 +123,11 @@ namespace dd4hep {
       public Geant4FieldTrackingSetup
     {
     protected:
+      /// Field caches (if used) of the worker threads to access the statistics
+      std::map<unsigned long, Geant4CachedField*> m_workerFields;
+      /// Lock protecting the worker field caches
+      std::mutex m_workerLock;
+
     public:
       /// Standard constructor
       Geant4FieldTrackingConstruction(Geant4Context* context, const std::string& nam);
@@ -115,6 +138,11 @@ namespace dd4hep {
       /// Phase action callback
       void operator()();
 
+      /// Electromagnetic field construction callback: one field object per worker thread
+      virtual void constructField(Geant4DetectorConstructionContext* ctxt)  override;
+
+      /// End-of-run callback of a worker thread: print and reset the statistics of its field cache
+      void workerEndRun(const G4Run* run);
     };
   }    // End namespace sim
 }      // End namespace dd4hep
@@ -138,7 +166,10 @@ namespace dd4hep {
 #include "DD4hep/Fields.h"
 #include "DDG4/Factories.h"
 #include "DDG4/Geant4Field.h"
+#include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4Converter.h"
+#include "DDG4/Geant4RunAction.h"
+#include "DD4hep/DD4hepUnits.h"
 
 #include "G4TransportationManager.hh"
 #include "G4MagIntegratorStepper.hh"
@@ -183,6 +214,8 @@ Geant4FieldTrackingSetup::Geant4FieldTrackingSetup() : eq_typ(), stepper_typ() {
   delta_one_step     = -1.0;
   delta_intersection = -1.0;
   largest_step       = -1.0;
+  cache_distance     = -1.0;
+  cached_field       = 0;
 }
 
 /// Default destructor
@@ -192,7 +225,11 @@ Geant4FieldTrackingSetup::~Geant4FieldTrackingSetup()   {
 /// Perform the setup of the magnetic field tracking in Geant4
 int Geant4FieldTrackingSetup::execute(Detector& description)   {
   OverlayedField fld  = description.field();
-  G4MagneticField*         mag_field    = new sim::Geant4Field(fld);
+  G4MagneticField*         mag_field    = 0;
+  if ( cache_distance > 0e0 )
+    mag_field = cached_field = new sim::Geant4CachedField(fld, cache_distance);
+  else
+    mag_field = new sim::Geant4Field(fld);
   G4Mag_EqRhs*             mag_equation = PluginService::Create<G4Mag_EqRhs*>(eq_typ,mag_field);
   G4MagIntegratorStepper*  fld_stepper  = PluginService::Create<G4MagIntegratorStepper*>(stepper_typ,mag_equation);
   G4ChordFinder*           chordFinder  = new G4ChordFinder(mag_field,min_chord_step,fld_stepper);
@@ -222,6 +259,21 @@ int Geant4FieldTrackingSetup::execute(Detector& description)   {
   return 1;
 }
 
+/// End-of-run callback: print and reset the statistics of the field cache
+void Geant4FieldTrackingSetup::endRun(const G4Run* /* run */)   {
+  if ( cached_field )  {
+    printCacheStatistics(cached_field);
+  }
+}
+
+/// Print and reset the statistics of a field cache
+void Geant4FieldTrackingSetup::printCacheStatistics(Geant4CachedField* field)   {
+  long hits = field->numHits(), total = hits + field->numMisses();
+  printout( INFO, "FieldSetup", "Field cache [distance:%g mm]: %ld of %ld queries from cache (%.1f %%).",
+            cache_distance, hits, total, total > 0 ? 100.0*double(hits)/double(total) : 0.0);
+  field->reset();
+}
+
 static long setup_fields(Detector& description, const dd4hep::detail::GeoHandler& /* cnv */, const map<string,string>& vals) {
   struct XMLFieldTrackingSetup : public Geant4FieldTrackingSetup {
     XMLFieldTrackingSetup(const map<string,string>& values) : Geant4FieldTrackingSetup() {
@@ -236,6 +288,7 @@ static long setup_fields(Detector& description, const dd4hep::detail::GeoHandler
       if ( pm["delta_one_step"] ) delta_one_step = pm.toDouble("delta_one_step");
       if ( pm["delta_intersection"] ) delta_intersection = pm.toDouble("delta_intersection");
       if ( pm["largest_step"] ) largest_step = pm.toDouble("largest_step");
+      if ( pm["cache_distance"] ) cache_distance = pm.toDouble("cache_distance")/dd4hep::mm;
     }
     virtual ~XMLFieldTrackingSetup() {}
   } setup(vals);
@@ -255,6 +308,7 @@ Geant4FieldTrackingSetupAction::Geant4FieldTrackingSetupAction(Geant4Context* ct
   declareProperty("eps_min",            eps_min = -1.0);
   declareProperty("eps_max",            eps_max = -1.0);
   declareProperty("largest_step",       largest_step = -1.0);
+  declareProperty("cache_distance",     cache_distance = -1.0);
 }
 
 /// Post-track action callback
@@ -266,6 +320,10 @@ void Geant4FieldTrackingSetupAction::operator()()   {
   printout( INFO, "FieldSetup", "Epsilon:[min:%f mm max:%f mm]", eps_min, eps_max);
   printout( INFO, "FieldSetup", "Delta:[chord:%f 1-step:%f intersect:%f] LargestStep %f mm",
 	    delta_chord, delta_one_step, delta_intersection, largest_step);
+  if ( cached_field )  {
+    printout( INFO, "FieldSetup", "Field values cached within %f mm.", cache_distance);
+    runAction().callAtEnd((Geant4FieldTrackingSetup*)this, &Geant4FieldTrackingSetup::endRun);
+  }
 }
 
 
@@ -282,6 +340,7 @@ Geant4FieldTrackingConstruction::Geant4FieldTrackingConstruction(Geant4Context*
   declareProperty("eps_min",            eps_min = -1.0);
   declareProperty("eps_max",            eps_max = -1.0);
   declareProperty("largest_step",       largest_step = -1.0);
+  declareProperty("cache_distance",     cache_distance = -1.0);
 }
 
 /// Post-track action callback
@@ -293,6 +352,46 @@ void Geant4FieldTrackingConstruction::operator()()   {
   printout( INFO, "FieldSetup", "Epsilon:[min:%f mm max:%f mm]", eps_min, eps_max);
   printout( INFO, "FieldSetup", "Delta:[chord:%f 1-step:%f intersect:%f] LargestStep %f mm",
 	    delta_chord, delta_one_step, delta_intersection, largest_step);
+  if ( cached_field )  {
+    printout( INFO, "FieldSetup", "Field values cached within %f mm.", cache_distance);
+    runAction().callAtEnd((Geant4FieldTrackingSetup*)this, &Geant4FieldTrackingSetup::endRun);
+  }
+}
+
+/// Electromagnetic field construction callback: one field object per worker thread
+void Geant4FieldTrackingConstruction::constructField(Geant4DetectorConstructionContext* ctxt)   {
+  // Called within ConstructSDandField of each worker, which are serialized.
+  // The G4TransportationManager is thread-local: every worker gets its own field.
+  execute(ctxt->description);
+  printout( INFO, "FieldSetup", "+++ Worker:%ld Geant4 magnetic field tracking configured.",
+            context()->kernel().id());
+  printout( INFO, "FieldSetup", "G4MagIntegratorStepper:%s G4Mag_EqRhs:%s",
+	    stepper_typ.c_str(), eq_typ.c_str());
+  printout( INFO, "FieldSetup", "Epsilon:[min:%f mm max:%f mm]", eps_min, eps_max);
+  printout( INFO, "FieldSetup", "Delta:[chord:%f 1-step:%f intersect:%f] LargestStep %f mm",
+	    delta_chord, delta_one_step, delta_intersection, largest_step);
+  if ( cached_field )  {
+    {
+      lock_guard<mutex> lock(m_workerLock);
+      m_workerFields[Geant4Kernel::thread_self()] = cached_field;
+    }
+    cached_field = 0;
+    printout( INFO, "FieldSetup", "Field values cached within %f mm.", cache_distance);
+    // The context is the one of the worker: register to the worker's run action
+    runAction().callAtEnd(this, &Geant4FieldTrackingConstruction::workerEndRun);
+  }
+}
+
+/// End-of-run callback of a worker thread: print and reset the statistics of its field cache
+void Geant4FieldTrackingConstruction::workerEndRun(const G4Run* /* run */)   {
+  Geant4CachedField* field = 0;  {
+    lock_guard<mutex> lock(m_workerLock);
+    auto i = m_workerFields.find(Geant4Kernel::thread_self());
+    if ( i != m_workerFields.end() ) field = (*i).second;
+  }
+  if ( field )  {
+    printCacheStatistics(field);
+  }
 }
 
 DECLARE_GEANT4_SETUP(Geant4FieldSetup,setup_fields)
@@ -27,6 +27,7 @@ namespace dd4hep {
 
     // Forward declarations
     class Geant4ParticleMap;
+    class Geant4ThreadPool;
     
     /// Class to measure the energy of escaping tracks
     /** Class to measure the energy of escaping tracks of a detector using Geant 4
@@ -39,6 +40,14 @@ namespace dd4hep {
     class Geant4HitTruthHandler : public Geant4EventAction {
     public:
       typedef std::vector<std::string> CollectionNames;
+      /// Property: Number of threads remapping the track identifiers of the hits
+      int m_remapThreads;
+      /// Threads remapping the track identifiers. Created on first use if m_remapThreads > 1
+      Geant4ThreadPool* m_remapPool;
+      /// Access the remapping threads. Returns NULL for serial remapping
+      Geant4ThreadPool* remapPool();
+      /// Collect the addresses of the track identifiers of a container of hits
+      void collectTrackIDs(G4VHitsCollection* hc, std::vector<int*>& track_ids);
       /// Dump single container of hits
       void handleCollection(Geant4ParticleMap* truth, G4VHitsCollection* hc);
       
@@ -72,9 +81,11 @@ namespace dd4hep {
 //====================================================================
 
 // Framework include files
+#include "DD4hep/Primitives.h"
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4DataDump.h"
 #include "DDG4/Geant4HitCollection.h"
+#include "DDG4/Geant4ThreadPool.h"
 
 // Geant 4 includes
 #include "G4HCofThisEvent.hh"
@@ -86,14 +97,16 @@ using namespace dd4hep::sim;
 
 /// Standard constructor
 Geant4HitTruthHandler::Geant4HitTruthHandler(Geant4Context* ctxt, const string& nam)
-  : Geant4EventAction(ctxt, nam)
+  : Geant4EventAction(ctxt, nam), m_remapPool(0)
 {
+  declareProperty("RemapThreads", m_remapThreads = 1);
   m_needsControl = true;
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4HitTruthHandler::~Geant4HitTruthHandler() {
+  detail::deletePtr(m_remapPool);
   InstanceCount::decrement(this);
 }
 
@@ -101,33 +114,30 @@ Geant4HitTruthHandler::~Geant4HitTruthHandler() {
 void Geant4HitTruthHandler::begin(const G4Event* /* event */)   {
 }
 
-/// Dump single container of hits
-void Geant4HitTruthHandler::handleCollection(Geant4ParticleMap* truth, G4VHitsCollection* collection)  {
+/// Access the remapping threads. Returns NULL for serial remapping
+Geant4ThreadPool* Geant4HitTruthHandler::remapPool()  {
+  if ( !m_remapPool && m_remapThreads > 1 )  {
+    m_remapPool = new Geant4ThreadPool(m_remapThreads-1);
+  }
+  return m_remapPool;
+}
+
+/// Collect the addresses of the track identifiers of a container of hits
+void Geant4HitTruthHandler::collectTrackIDs(G4VHitsCollection* collection, vector<int*>& track_ids)  {
   Geant4HitCollection* coll = dynamic_cast<Geant4HitCollection*>(collection);
   if ( coll )    {
     size_t nhits = coll->GetSize();
-    for(size_t i=0; i<nhits; ++i)   {
-      Geant4HitData* h = coll->hit(i);
-      Geant4Tracker::Hit* trk_hit = dynamic_cast<Geant4Tracker::Hit*>(h);
-      if ( 0 != trk_hit )   {
-        if ( truth )  {
-          Geant4HitData::Contribution& t = trk_hit->truth;
-          int trackID = t.trackID;
-          t.trackID = truth->particleID(trackID);
-        }
-      }
-      Geant4Calorimeter::Hit* cal_hit = dynamic_cast<Geant4Calorimeter::Hit*>(h);
-      if ( 0 != cal_hit )   {
-        if ( truth )  {
-          Geant4HitData::Contributions& c = cal_hit->truth;
-          for(Geant4HitData::Contributions::iterator j=c.begin(); j!=c.end(); ++j)  {
-            Geant4HitData::Contribution& t = *j;
-            int trackID = t.trackID;
-            t.trackID = truth->particleID(trackID);
-          }
-        }
-      }
-    }
+    for(size_t i=0; i<nhits; ++i)
+      Geant4HitData::trackIDs(coll->hit(i), track_ids);
+  }
+}
+
+/// Dump single container of hits
+void Geant4HitTruthHandler::handleCollection(Geant4ParticleMap* truth, G4VHitsCollection* collection)  {
+  if ( truth )  {
+    vector<int*> track_ids;
+    collectTrackIDs(collection, track_ids);
+    truth->remapTrackIDs(track_ids, remapPool());
   }
 }
 
@@ -142,9 +152,12 @@ void Geant4HitTruthHandler::end(const G4Event* event)    {
       printout(WARNING,name(),"+++ [Event:%d] No valid MC truth info present. "
                "Is a Particle handler installed ?",event->GetEventID());
     }
-    for (int i = 0; i < nCol; ++i) {
-      G4VHitsCollection* hc = hce->GetHC(i);
-      handleCollection(truth, hc);
+    if ( truth )  {
+      // Remap the track identifiers of all collections in one bulk pass
+      vector<int*> track_ids;
+      for (int i = 0; i < nCol; ++i)
+        collectTrackIDs(hce->GetHC(i), track_ids);
+      truth->remapTrackIDs(track_ids, remapPool());
     }
     return;
   }
@@ -0,0 +1,455 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4OUTPUT2ROOTCOLUMNS_H
+#define DD4HEP_DDG4_GEANT4OUTPUT2ROOTCOLUMNS_H
+
+// Framework include files
+#include "DDG4/Geant4OutputAction.h"
+
+// ROOT include files
+#include "RtypesCore.h"
+
+// Forward declarations
+class TFile;
+class TTree;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Class to output Geant4 hit collections to ROOT files as flat columns
+    /**
+     *  Unlike Geant4Output2ROOT the hits are not streamed as objects.
+     *  Every collection <coll> is written as a set of branches of basic types,
+     *  one entry per event:
+     *
+     *  - <coll>_cellID, <coll>_energy, <coll>_x, <coll>_y, <coll>_z, <coll>_time
+     *    and <coll>_px, <coll>_py, <coll>_pz (tracker hits only, otherwise 0):
+     *    one value per hit.
+     *  - <coll>_contribBegin: index of the first Monte-Carlo contribution of each hit.
+     *    The contributions of hit i are [begin[i], begin[i+1]), the last hit ends
+     *    at the size of the contribution arrays.
+     *  - <coll>_contribTrackID, <coll>_contribPDG, <coll>_contribDeposit,
+     *    <coll>_contribTime: one value per contribution.
+     *
+     *  The Monte-Carlo particles are written in the same way to the branches
+     *  MCParticles_<column>:
+     *
+     *  - id, g4Parent, pdgID, status, genStatus, charge, mass, time,
+     *    vx, vy, vz, px, py, pz (at the start vertex), endx, endy, endz,
+     *    endpx, endpy, endpz (at the end vertex): one value per particle.
+     *  - parentsBegin, daughtersBegin: index of the first parent/daughter
+     *    of each particle in the arrays parents and daughters, which hold
+     *    the particle identifiers.
+     *
+     *  No dictionaries are required to read the data and readers may load
+     *  only the columns they need. The time of a calorimeter hit is the time
+     *  of its earliest contribution.
+     *
+     *  At the end of the job the number of events, the time spent in the
+     *  output action and the number of bytes written are printed to
+     *  measure the output throughput.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4Output2ROOTColumns : public Geant4OutputAction {
+    protected:
+      /// Column buffers of one hit collection
+      class Columns  {
+      public:
+        std::vector<Long64_t> cellID;
+        std::vector<double>   energy, x, y, z, time, px, py, pz;
+        std::vector<int>      contribBegin;
+        std::vector<int>      contribTrackID, contribPDG;
+        std::vector<double>   contribDeposit, contribTime;
+        /// Flag if the collection was filled for the current event
+        bool filled = false;
+        /// Clear all columns
+        void clear();
+      };
+      typedef std::map<std::string, Columns*> Collections;
+
+      /// Column buffers of the Monte-Carlo particles
+      class Particles  {
+      public:
+        std::vector<int>    id, g4Parent, pdgID, status, genStatus, charge;
+        std::vector<double> mass, time, vx, vy, vz, px, py, pz;
+        std::vector<double> endx, endy, endz, endpx, endpy, endpz;
+        std::vector<int>    parentsBegin, parents, daughtersBegin, daughters;
+        /// Clear all columns
+        void clear();
+      };
+
+      /// Column buffers by collection name
+      Collections m_collections;
+      /// Column buffers of the Monte-Carlo particles
+      Particles   m_particles;
+      /// Property: name of the event tree
+      std::string m_section;
+      /// Property: Flag if Monte-Carlo truth should be followed and checked
+      bool        m_handleMCTruth;
+      /// Reference to the ROOT file to open
+      TFile*      m_file;
+      /// Reference to the event data tree
+      TTree*      m_tree;
+      /// Statistics: number of events written
+      long        m_numEvents;
+      /// Statistics: number of uncompressed bytes filled into the tree
+      long long   m_numBytes;
+      /// Statistics: wall time spent in the output action in seconds
+      double      m_seconds;
+
+      /// Access the column buffers of a collection. Branches are created on first access
+      Columns* columns(const std::string& nam);
+      /// Map the Geant4 track identifier to the MC particle identifier
+      int trackID(int g4_id)  const;
+
+    public:
+      /// Standard constructor
+      Geant4Output2ROOTColumns(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4Output2ROOTColumns();
+      /// Callback to open the output file
+      virtual void beginRun(const G4Run* run)  override;
+      /// Geant4 end-of-event callback. Measures the time spent in the output
+      virtual void end(const G4Event* event)  override;
+      /// Callback to store the Monte-Carlo particles
+      virtual void saveEvent(OutputContext<G4Event>& ctxt)  override;
+      /// Callback to store each Geant4 hit collection
+      virtual void saveCollection(OutputContext<G4Event>& ctxt, G4VHitsCollection* collection)  override;
+      /// Commit data at end of filling procedure
+      virtual void commit(OutputContext<G4Event>& ctxt)  override;
+    };
+
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#endif /* DD4HEP_DDG4_GEANT4OUTPUT2ROOTCOLUMNS_H */
+
+//====================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//====================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Primitives.h"
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4HitCollection.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4Data.h"
+
+// ROOT include files
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+
+// C/C++ include files
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+/// Clear all columns
+void Geant4Output2ROOTColumns::Columns::clear()  {
+  cellID.clear();
+  energy.clear();
+  x.clear();
+  y.clear();
+  z.clear();
+  time.clear();
+  px.clear();
+  py.clear();
+  pz.clear();
+  contribBegin.clear();
+  contribTrackID.clear();
+  contribPDG.clear();
+  contribDeposit.clear();
+  contribTime.clear();
+  filled = false;
+}
+
+/// Clear all columns
+void Geant4Output2ROOTColumns::Particles::clear()  {
+  id.clear();
+  g4Parent.clear();
+  pdgID.clear();
+  status.clear();
+  genStatus.clear();
+  charge.clear();
+  mass.clear();
+  time.clear();
+  vx.clear();
+  vy.clear();
+  vz.clear();
+  px.clear();
+  py.clear();
+  pz.clear();
+  endx.clear();
+  endy.clear();
+  endz.clear();
+  endpx.clear();
+  endpy.clear();
+  endpz.clear();
+  parentsBegin.clear();
+  parents.clear();
+  daughtersBegin.clear();
+  daughters.clear();
+}
+
+/// Standard constructor
+Geant4Output2ROOTColumns::Geant4Output2ROOTColumns(Geant4Context* ctxt, const string& nam)
+  : Geant4OutputAction(ctxt, nam), m_file(0), m_tree(0),
+    m_numEvents(0), m_numBytes(0), m_seconds(0e0)
+{
+  declareProperty("Section", m_section = "EVENT");
+  declareProperty("HandleMCTruth", m_handleMCTruth = true);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4Output2ROOTColumns::~Geant4Output2ROOTColumns()  {
+  InstanceCount::decrement(this);
+  if ( m_file )  {
+    TDirectory::TContext ctxt(m_file);
+    m_tree->Write();
+    m_file->Close();
+    m_tree = 0;
+    double mb = 1024e0*1024e0, sec = m_seconds > 0e0 ? m_seconds : 1e-9;
+    printout(INFO,name(),"+++ Wrote %ld events in %.3f s: %.1f events/s, "
+             "%.2f MB uncompressed (%.2f MB/s), %.2f MB to file %s",
+             m_numEvents, m_seconds, double(m_numEvents)/sec,
+             double(m_numBytes)/mb, double(m_numBytes)/mb/sec,
+             double(m_file->GetBytesWritten())/mb, m_output.c_str());
+    detail::deletePtr(m_file);
+  }
+  detail::destroyObjects(m_collections);
+}
+
+/// Callback to open the output file
+void Geant4Output2ROOTColumns::beginRun(const G4Run* run)  {
+  if ( !m_file && !m_output.empty() )  {
+    TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
+    m_file = TFile::Open(m_output.c_str(), "RECREATE", "dd4hep Simulation data");
+    if ( m_file->IsZombie() )  {
+      detail::deletePtr(m_file);
+      except("Failed to open ROOT output file:'%s'", m_output.c_str());
+    }
+    m_tree = new TTree(m_section.c_str(), ("Geant4 " + m_section + " information").c_str());
+    Particles* p = &m_particles;
+    m_tree->Branch("MCParticles_id",             &p->id);
+    m_tree->Branch("MCParticles_g4Parent",       &p->g4Parent);
+    m_tree->Branch("MCParticles_pdgID",          &p->pdgID);
+    m_tree->Branch("MCParticles_status",         &p->status);
+    m_tree->Branch("MCParticles_genStatus",      &p->genStatus);
+    m_tree->Branch("MCParticles_charge",         &p->charge);
+    m_tree->Branch("MCParticles_mass",           &p->mass);
+    m_tree->Branch("MCParticles_time",           &p->time);
+    m_tree->Branch("MCParticles_vx",             &p->vx);
+    m_tree->Branch("MCParticles_vy",             &p->vy);
+    m_tree->Branch("MCParticles_vz",             &p->vz);
+    m_tree->Branch("MCParticles_px",             &p->px);
+    m_tree->Branch("MCParticles_py",             &p->py);
+    m_tree->Branch("MCParticles_pz",             &p->pz);
+    m_tree->Branch("MCParticles_endx",           &p->endx);
+    m_tree->Branch("MCParticles_endy",           &p->endy);
+    m_tree->Branch("MCParticles_endz",           &p->endz);
+    m_tree->Branch("MCParticles_endpx",          &p->endpx);
+    m_tree->Branch("MCParticles_endpy",          &p->endpy);
+    m_tree->Branch("MCParticles_endpz",          &p->endpz);
+    m_tree->Branch("MCParticles_parentsBegin",   &p->parentsBegin);
+    m_tree->Branch("MCParticles_parents",        &p->parents);
+    m_tree->Branch("MCParticles_daughtersBegin", &p->daughtersBegin);
+    m_tree->Branch("MCParticles_daughters",      &p->daughters);
+  }
+  Geant4OutputAction::beginRun(run);
+}
+
+/// Geant4 end-of-event callback. Measures the time spent in the output
+void Geant4Output2ROOTColumns::end(const G4Event* event)  {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  Geant4OutputAction::end(event);
+  m_seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/// Access the column buffers of a collection. Branches are created on first access
+Geant4Output2ROOTColumns::Columns* Geant4Output2ROOTColumns::columns(const string& nam)  {
+  Collections::const_iterator i = m_collections.find(nam);
+  if ( i != m_collections.end() )  {
+    return (*i).second;
+  }
+  Columns* c = new Columns();
+  vector<TBranch*> branches;
+  TDirectory::TContext ctxt(m_file);
+  branches.push_back(m_tree->Branch((nam+"_cellID").c_str(),         &c->cellID));
+  branches.push_back(m_tree->Branch((nam+"_energy").c_str(),         &c->energy));
+  branches.push_back(m_tree->Branch((nam+"_x").c_str(),              &c->x));
+  branches.push_back(m_tree->Branch((nam+"_y").c_str(),              &c->y));
+  branches.push_back(m_tree->Branch((nam+"_z").c_str(),              &c->z));
+  branches.push_back(m_tree->Branch((nam+"_time").c_str(),           &c->time));
+  branches.push_back(m_tree->Branch((nam+"_px").c_str(),             &c->px));
+  branches.push_back(m_tree->Branch((nam+"_py").c_str(),             &c->py));
+  branches.push_back(m_tree->Branch((nam+"_pz").c_str(),             &c->pz));
+  branches.push_back(m_tree->Branch((nam+"_contribBegin").c_str(),   &c->contribBegin));
+  branches.push_back(m_tree->Branch((nam+"_contribTrackID").c_str(), &c->contribTrackID));
+  branches.push_back(m_tree->Branch((nam+"_contribPDG").c_str(),     &c->contribPDG));
+  branches.push_back(m_tree->Branch((nam+"_contribDeposit").c_str(), &c->contribDeposit));
+  branches.push_back(m_tree->Branch((nam+"_contribTime").c_str(),    &c->contribTime));
+  // Collections appearing late: fill empty entries for the previous events
+  for( TBranch* b : branches )  {
+    for( Long64_t n = m_tree->GetEntries(); n > 0; --n )
+      b->Fill();
+  }
+  m_collections.insert(make_pair(nam, c));
+  return c;
+}
+
+/// Map the Geant4 track identifier to the MC particle identifier
+int Geant4Output2ROOTColumns::trackID(int g4_id)  const  {
+  return (m_handleMCTruth && m_truth) ? m_truth->particleID(g4_id) : g4_id;
+}
+
+/// Callback to store the Monte-Carlo particles
+void Geant4Output2ROOTColumns::saveEvent(OutputContext<G4Event>& /* ctxt */)  {
+  Geant4ParticleMap* parts = context()->event().extension<Geant4ParticleMap>(false);
+  Particles* c = &m_particles;
+  c->clear();
+  if ( m_file && parts )  {
+    const Geant4ParticleMap::ParticleMap& pm = parts->particles();
+    size_t npart = pm.size();
+    c->id.reserve(npart);
+    c->parentsBegin.reserve(npart);
+    c->daughtersBegin.reserve(npart);
+    for( const auto& i : pm )  {
+      const Geant4Particle* p = i.second;
+      c->id.push_back(p->id);
+      c->g4Parent.push_back(p->g4Parent);
+      c->pdgID.push_back(p->pdgID);
+      c->status.push_back(p->status);
+      c->genStatus.push_back(p->genStatus);
+      c->charge.push_back(p->charge);
+      c->mass.push_back(p->mass);
+      c->time.push_back(p->time);
+      c->vx.push_back(p->vsx);
+      c->vy.push_back(p->vsy);
+      c->vz.push_back(p->vsz);
+      c->px.push_back(p->psx);
+      c->py.push_back(p->psy);
+      c->pz.push_back(p->psz);
+      c->endx.push_back(p->vex);
+      c->endy.push_back(p->vey);
+      c->endz.push_back(p->vez);
+      c->endpx.push_back(p->pex);
+      c->endpy.push_back(p->pey);
+      c->endpz.push_back(p->pez);
+      c->parentsBegin.push_back(int(c->parents.size()));
+      c->parents.insert(c->parents.end(), p->parents.begin(), p->parents.end());
+      c->daughtersBegin.push_back(int(c->daughters.size()));
+      c->daughters.insert(c->daughters.end(), p->daughters.begin(), p->daughters.end());
+    }
+  }
+}
+
+/// Callback to store each Geant4 hit collection
+void Geant4Output2ROOTColumns::saveCollection(OutputContext<G4Event>& /* ctxt */, G4VHitsCollection* collection)  {
+  Geant4HitCollection* coll = dynamic_cast<Geant4HitCollection*>(collection);
+  if ( m_file && coll )  {
+    Columns* c = columns(collection->GetName());
+    size_t nhits = coll->GetSize();
+    c->clear();
+    c->filled = true;
+    c->cellID.reserve(nhits);
+    c->energy.reserve(nhits);
+    c->x.reserve(nhits);
+    c->y.reserve(nhits);
+    c->z.reserve(nhits);
+    c->time.reserve(nhits);
+    c->px.reserve(nhits);
+    c->py.reserve(nhits);
+    c->pz.reserve(nhits);
+    c->contribBegin.reserve(nhits);
+    for(size_t i=0; i<nhits; ++i)   {
+      Geant4HitData* h = coll->hit(i);
+      Geant4Tracker::Hit*     trk_hit = dynamic_cast<Geant4Tracker::Hit*>(h);
+      Geant4Calorimeter::Hit* cal_hit = trk_hit ? 0 : dynamic_cast<Geant4Calorimeter::Hit*>(h);
+      if ( !trk_hit && !cal_hit )  {
+        continue;
+      }
+      const Position& pos = trk_hit ? trk_hit->position : cal_hit->position;
+      c->cellID.push_back(h->cellID);
+      c->x.push_back(pos.X());
+      c->y.push_back(pos.Y());
+      c->z.push_back(pos.Z());
+      c->contribBegin.push_back(int(c->contribTrackID.size()));
+      if ( trk_hit )  {
+        const Geant4HitData::Contribution& t = trk_hit->truth;
+        c->energy.push_back(trk_hit->energyDeposit);
+        c->time.push_back(t.time);
+        c->px.push_back(trk_hit->momentum.X());
+        c->py.push_back(trk_hit->momentum.Y());
+        c->pz.push_back(trk_hit->momentum.Z());
+        c->contribTrackID.push_back(trackID(t.trackID));
+        c->contribPDG.push_back(t.pdgID);
+        c->contribDeposit.push_back(t.deposit);
+        c->contribTime.push_back(t.time);
+        continue;
+      }
+      double t_min = cal_hit->truth.empty() ? 0e0 : cal_hit->truth.front().time;
+      for( const Geant4HitData::Contribution& t : cal_hit->truth )  {
+        t_min = min(t_min, t.time);
+        c->contribTrackID.push_back(trackID(t.trackID));
+        c->contribPDG.push_back(t.pdgID);
+        c->contribDeposit.push_back(t.deposit);
+        c->contribTime.push_back(t.time);
+      }
+      c->energy.push_back(cal_hit->energyDeposit);
+      c->time.push_back(t_min);
+      c->px.push_back(0e0);
+      c->py.push_back(0e0);
+      c->pz.push_back(0e0);
+    }
+  }
+}
+
+/// Commit data at end of filling procedure
+void Geant4Output2ROOTColumns::commit(OutputContext<G4Event>& ctxt)  {
+  if ( m_file )  {
+    // Collections not present in this event are written as empty arrays
+    for( auto& c : m_collections )  {
+      if ( !c.second->filled ) c.second->clear();
+    }
+    TDirectory::TContext dir_ctxt(m_file);
+    int nb = m_tree->Fill();
+    if ( nb < 0 )  {
+      except("Failed to write ROOT columns to tree %s!", m_section.c_str());
+    }
+    m_numBytes += nb;
+    ++m_numEvents;
+    for( auto& c : m_collections )
+      c.second->filled = false;
+  }
+  Geant4OutputAction::commit(ctxt);
+}
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4Output2ROOTColumns)
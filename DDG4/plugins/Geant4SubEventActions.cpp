@@ -0,0 +1,629 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+#ifndef DD4HEP_DDG4_GEANT4SUBEVENTACTIONS_H
+#define DD4HEP_DDG4_GEANT4SUBEVENTACTIONS_H
+
+// Framework include files
+#include "DDG4/Geant4EventAction.h"
+#include "DDG4/Geant4GeneratorAction.h"
+#include "DDG4/Geant4HitCollection.h"
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Geant4Action to distribute the interactions of one event to several sub-events
+    /** Replaces the Geant4InteractionMerger in the generator sequence.
+     *
+     *  A physics event is simulated as SubEvents consecutive Geant4 events, which
+     *  the run manager dispatches to different worker threads. Event i belongs
+     *  to physics event i/SubEvents and is its sub-event i%SubEvents. The number of
+     *  Geant4 events to be processed is hence SubEvents times the number of
+     *  physics events.
+     *
+     *  If the number of Geant4 events is not a multiple of SubEvents, the last
+     *  physics event consists of the remaining sub-events.
+     *
+     *  The input actions are adopted by the splitter instead of the generator
+     *  sequence, either with adopt() or by name with the property "Inputs" from
+     *  the globally registered actions. They are executed once per physics event
+     *  by the first of its sub-events to start. The interactions read are
+     *  distributed round-robin to the sub-events. The other sub-events only wait
+     *  if they start while the input is being read. An event identifier set by
+     *  the input actions is reset to the sub-event number. Each sub-event finally
+     *  merges its share like the Geant4InteractionMerger.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4InteractionSplitter : public Geant4GeneratorAction    {
+    protected:
+      /// Property: Number of sub-events per physics event
+      int m_numSubEvents;
+      /// Property: Names of globally registered input actions
+      std::vector<std::string> m_inputNames;
+      /// The input actions executed once per physics event
+      Actors<Geant4GeneratorAction> m_inputs;
+
+    public:
+      /// Standard constructor
+      Geant4InteractionSplitter(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4InteractionSplitter();
+      /// Adopt an input action. Only executed once per physics event
+      void adopt(Geant4GeneratorAction* action);
+      /// Adopt the input actions given by name
+      void adoptInputs();
+      /// Set or update client context
+      virtual void updateContext(Geant4Context* ctxt)  override;
+      /// Set or update client for the use in a new thread fiber
+      virtual void configureFiber(Geant4Context* thread_context)  override;
+      /// Event generation action callback
+      virtual void operator()(G4Event* event)  override;
+    };
+
+    /// Geant4Action to merge the results of the sub-events of a physics event
+    /** Counterpart of the Geant4InteractionSplitter in the event action sequence.
+     *
+     *  The output actions are adopted by the merger instead of the event action
+     *  sequence, either with adopt() or by name with the property "Outputs" from
+     *  the globally registered actions. At the end of each sub-event the MC truth
+     *  of the hits is expressed in particle identifiers. Then the hits and the
+     *  particles are handed over to a store shared by all threads. The sub-event
+     *  finishing last merges the data of all sub-events into its own record and
+     *  calls the output actions with the physics event number as event identifier.
+     *
+     *  The sub-events are merged in the order of their index, independent of the
+     *  order in which they finished, so the merged record is reproducible:
+     *  - Calorimeter hits with the same cell identifier are combined. Tracker hits
+     *    are appended to the collection of the same name.
+     *  - The particle identifiers of each sub-event are shifted by the number
+     *    of particles merged before. The track equivalents of the merged record
+     *    are the identity.
+     *
+     *  Hits are copied by the merging thread, because the hit memory is managed
+     *  by per-thread pools. The originals are deleted by their own thread at its
+     *  next end-of-event. Only Geant4Tracker and Geant4Calorimeter hits are merged.
+     *  Sub-events never completed, e.g. after an aborted event, are reported when
+     *  the merger is deleted.
+     *
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4SubEventMerger : public Geant4EventAction    {
+    protected:
+      typedef Geant4HitWrapper::Wrapper Wrapper;
+      /// Property: Number of sub-events per physics event
+      int m_numSubEvents;
+      /// Property: Names of globally registered output actions
+      std::vector<std::string> m_outputNames;
+      /// The output actions executed once per physics event
+      Actors<Geant4EventAction> m_outputs;
+
+      /// Copy hits of another sub-event into a collection. Returns the number of hits not merged
+      std::size_t mergeHits(Geant4HitCollection* collection, const std::vector<Wrapper>& hits, int offset);
+
+    public:
+      /// Standard constructor
+      Geant4SubEventMerger(Geant4Context* context, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4SubEventMerger();
+      /// Adopt an output action. Only executed when all sub-events are merged
+      void adopt(Geant4EventAction* action);
+      /// Adopt the output actions given by name
+      void adoptOutputs();
+      /// Set or update client context
+      virtual void updateContext(Geant4Context* ctxt)  override;
+      /// Set or update client for the use in a new thread fiber
+      virtual void configureFiber(Geant4Context* thread_context)  override;
+      /// Begin-of-event callback
+      virtual void begin(const G4Event* event)  override;
+      /// End-of-event callback
+      virtual void end(const G4Event* event)  override;
+    };
+
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+#endif /* DD4HEP_DDG4_GEANT4SUBEVENTACTIONS_H */
+
+//====================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//====================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Primitives.h"
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4InputHandling.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4Primary.h"
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4Data.h"
+
+// Geant 4 includes
+#include "G4HCofThisEvent.hh"
+#include "G4RunManager.hh"
+#include "G4Event.hh"
+#include "G4Run.hh"
+
+// C/C++ include files
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+namespace {
+
+  typedef Geant4PrimaryEvent::Interaction Interaction;
+
+  /// Number of sub-events of a physics event. The last physics event of a run may be incomplete
+  int numberOfSubEvents(int phys, int num_sub)  {
+    const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+    int num_events = run ? run->GetNumberOfEventToBeProcessed() : 0;
+    if ( num_events > 0 && (phys+1)*num_sub > num_events )  {
+      return max(1, num_events - phys*num_sub);
+    }
+    return num_sub;
+  }
+
+  /// Interactions of the physics events waiting to be picked up by their sub-events
+  class InteractionStore  {
+  public:
+    /// Interactions per sub-event of one physics event
+    class Entry  {
+    public:
+      vector<vector<Interaction*> > shares;
+      /// Number of sub-events still to pick up their interactions
+      int  pending = 0;
+      /// Flag set once the interactions are published
+      bool ready = false;
+    };
+    mutex              lock;
+    condition_variable published;
+    map<int, Entry>    entries;
+
+    /// Access the store shared by all threads
+    static InteractionStore& instance()  {
+      static InteractionStore s;
+      return s;
+    }
+    /// Claim the reading of the input. Returns true for the first sub-event of a physics event
+    bool claim(int event, int num_sub)  {
+      lock_guard<mutex> protect(lock);
+      pair<map<int, Entry>::iterator, bool> r = entries.insert(make_pair(event, Entry()));
+      if ( r.second ) (*r.first).second.pending = num_sub;
+      return r.second;
+    }
+    /// Publish the interactions of a physics event
+    void publish(int event, vector<vector<Interaction*> >& shares)  {
+      lock_guard<mutex> protect(lock);
+      Entry& e = entries[event];
+      e.shares.swap(shares);
+      e.shares.resize(e.pending);
+      e.ready = true;
+      published.notify_all();
+    }
+    /// Take the interactions of one sub-event. Waits only while the input is read
+    vector<Interaction*> take(int event, int sub_event)  {
+      vector<Interaction*> result;
+      unique_lock<mutex> protect(lock);
+      map<int, Entry>::iterator i = entries.find(event);
+      published.wait(protect, [i] { return (*i).second.ready; });
+      if ( size_t(sub_event) < (*i).second.shares.size() )  {
+        result.swap((*i).second.shares[sub_event]);
+      }
+      if ( --(*i).second.pending == 0 ) entries.erase(i);
+      return result;
+    }
+  };
+
+  /// Hits and particles of one sub-event waiting to be merged
+  class SubEventPart  {
+  public:
+    typedef Geant4HitWrapper::Wrapper Wrapper;
+    /// Thread which allocated the hits
+    thread::id                      owner;
+    /// Hits by collection name
+    map<string, vector<Wrapper> >   hits;
+    /// Particles with identifiers local to the sub-event
+    Geant4ParticleMap::ParticleMap  particles;
+
+    /// Default destructor: delete the hits. Must be called by the owner thread
+    ~SubEventPart()  {
+      for(auto& c : hits)  {
+        for(Wrapper& w : c.second)
+          if ( w.first && w.second ) (*w.second->cast.destroy)(w.first);
+      }
+      detail::releaseObjects(particles);
+    }
+  };
+
+  /// Sub-events of the physics events waiting for the last sub-event to finish
+  class SubEventStore  {
+  public:
+    /// Number of finished sub-events and their data indexed by the sub-event number
+    typedef pair<int, vector<SubEventPart*> > Entry;
+    mutex                                  lock;
+    map<int, Entry>                        entries;
+    /// Merged parts to be deleted by their owner thread
+    map<thread::id, vector<SubEventPart*> > consumed;
+
+    /// Access the store shared by all threads
+    static SubEventStore& instance()  {
+      static SubEventStore s;
+      return s;
+    }
+    /// Delete the parts of the calling thread, which were merged by other threads
+    void reclaim()  {
+      vector<SubEventPart*> parts;  {
+        lock_guard<mutex> protect(lock);
+        map<thread::id, vector<SubEventPart*> >::iterator i = consumed.find(this_thread::get_id());
+        if ( i == consumed.end() ) return;
+        parts.swap((*i).second);
+      }
+      for(SubEventPart* p : parts) delete p;
+    }
+    /// Hand merged parts back to their owner threads
+    void release(vector<SubEventPart*>& parts)  {
+      lock_guard<mutex> protect(lock);
+      for(SubEventPart* p : parts)
+        if ( p ) consumed[p->owner].push_back(p);
+      parts.clear();
+    }
+    /// Hand the parts of incomplete physics events back to their owners. Returns their event numbers
+    vector<int> releaseIncomplete()  {
+      vector<int> events;
+      lock_guard<mutex> protect(lock);
+      for(auto& e : entries)  {
+        events.push_back(e.first);
+        for(SubEventPart* p : e.second.second)
+          if ( p ) consumed[p->owner].push_back(p);
+      }
+      entries.clear();
+      return events;
+    }
+  };
+}
+
+/// Standard constructor
+Geant4InteractionSplitter::Geant4InteractionSplitter(Geant4Context* ctxt, const string& nam)
+  : Geant4GeneratorAction(ctxt,nam)
+{
+  declareProperty("SubEvents", m_numSubEvents = 1);
+  declareProperty("Inputs",    m_inputNames);
+  m_needsControl = true;
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4InteractionSplitter::~Geant4InteractionSplitter()  {
+  m_inputs(&Geant4GeneratorAction::release);
+  m_inputs.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Adopt an input action. Only executed once per physics event
+void Geant4InteractionSplitter::adopt(Geant4GeneratorAction* action)   {
+  if ( action )  {
+    action->addRef();
+    m_inputs.add(action);
+    return;
+  }
+  except("+++ Attempt to add an invalid input action!");
+}
+
+/// Adopt the input actions given by name
+void Geant4InteractionSplitter::adoptInputs()   {
+  for(const string& nam : m_inputNames)  {
+    Geant4GeneratorAction* action = dynamic_cast<Geant4GeneratorAction*>(context()->kernel().globalAction(nam));
+    if ( !action )  {
+      except("+++ The input action %s is no generator action!", nam.c_str());
+    }
+    adopt(action);
+  }
+  m_inputNames.clear();
+}
+
+/// Set or update client context
+void Geant4InteractionSplitter::updateContext(Geant4Context* ctxt)    {
+  m_context = ctxt;
+  m_inputs.updateContext(ctxt);
+}
+
+/// Set or update client for the use in a new thread fiber
+void Geant4InteractionSplitter::configureFiber(Geant4Context* thread_context)   {
+  // The inputs given by name must be known before they can be configured
+  adoptInputs();
+  m_inputs(&Geant4Action::configureFiber, thread_context);
+}
+
+/// Event generation action callback
+void Geant4InteractionSplitter::operator()(G4Event* event)  {
+  InteractionStore&  store = InteractionStore::instance();
+  Geant4PrimaryEvent* prim = context()->event().extension<Geant4PrimaryEvent>();
+  int num_sub   = max(1, m_numSubEvents);
+  int event_id  = event->GetEventID();
+  int phys      = event_id / num_sub;
+  int sub       = event_id % num_sub;
+  int num_parts = numberOfSubEvents(phys, num_sub);
+
+  if ( store.claim(phys, num_parts) )  {
+    vector<vector<Interaction*> > shares(num_parts);
+    try  {
+      adoptInputs();
+      m_inputs(&Geant4GeneratorAction::operator(), event);
+    }
+    catch(...)  {
+      // Do not leave the other sub-events waiting
+      event->SetEventID(event_id);
+      store.publish(phys, shares);
+      throw;
+    }
+    // Input actions may renumber the event: the sub-event numbering must stay
+    event->SetEventID(event_id);
+    vector<Interaction*> inter = prim->interactions();
+    for(size_t i=0; i<inter.size(); ++i)
+      shares[i%num_parts].push_back(prim->release(inter[i]->mask));
+    store.publish(phys, shares);
+  }
+  vector<Interaction*> interactions = store.take(phys, sub);
+  for(Interaction* i : interactions)
+    prim->add(i->mask, i);
+  debug("+++ Event:%d is sub-event %d of %d of physics event %d with %d interactions.",
+        event_id, sub, num_parts, phys, int(interactions.size()));
+  mergeInteractions(this, context());
+}
+
+/// Standard constructor
+Geant4SubEventMerger::Geant4SubEventMerger(Geant4Context* ctxt, const string& nam)
+  : Geant4EventAction(ctxt,nam)
+{
+  declareProperty("SubEvents", m_numSubEvents = 1);
+  declareProperty("Outputs",   m_outputNames);
+  m_needsControl = true;
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4SubEventMerger::~Geant4SubEventMerger()  {
+  SubEventStore& store = SubEventStore::instance();
+  vector<int> incomplete = store.releaseIncomplete();
+  for(int phys : incomplete)  {
+    error("+++ Physics event %d was never completed: its sub-events are lost.", phys);
+  }
+  store.reclaim();
+  m_outputs(&Geant4Action::release);
+  m_outputs.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Adopt an output action. Only executed when all sub-events are merged
+void Geant4SubEventMerger::adopt(Geant4EventAction* action)   {
+  if ( action )  {
+    action->addRef();
+    m_outputs.add(action);
+    return;
+  }
+  except("+++ Attempt to add an invalid output action!");
+}
+
+/// Adopt the output actions given by name
+void Geant4SubEventMerger::adoptOutputs()   {
+  for(const string& nam : m_outputNames)  {
+    Geant4EventAction* action = dynamic_cast<Geant4EventAction*>(context()->kernel().globalAction(nam));
+    if ( !action )  {
+      except("+++ The output action %s is no event action!", nam.c_str());
+    }
+    adopt(action);
+  }
+  m_outputNames.clear();
+}
+
+/// Set or update client context
+void Geant4SubEventMerger::updateContext(Geant4Context* ctxt)    {
+  m_context = ctxt;
+  m_outputs.updateContext(ctxt);
+}
+
+/// Set or update client for the use in a new thread fiber
+void Geant4SubEventMerger::configureFiber(Geant4Context* thread_context)   {
+  // The outputs register their run callbacks here: adopt them by name first
+  adoptOutputs();
+  m_outputs(&Geant4Action::configureFiber, thread_context);
+}
+
+/// Begin-of-event callback
+void Geant4SubEventMerger::begin(const G4Event* event)  {
+  adoptOutputs();
+  m_outputs(&Geant4EventAction::begin, event);
+}
+
+/// Copy hits of another sub-event into a collection. Returns the number of hits not merged
+size_t Geant4SubEventMerger::mergeHits(Geant4HitCollection* coll, const vector<Wrapper>& hits, int offset)  {
+  typedef Geant4Calorimeter::Hit CalorimeterHit;
+  typedef Geant4Tracker::Hit     TrackerHit;
+  Geant4HitWrapper::HitManipulator* calo_type    = Geant4HitWrapper::manipulator<CalorimeterHit>();
+  Geant4HitWrapper::HitManipulator* tracker_type = Geant4HitWrapper::manipulator<TrackerHit>();
+  size_t num_lost = 0;
+
+  for(const Wrapper& w : hits)  {
+    if ( !w.first ) continue;
+    if ( w.second == calo_type )  {
+      const CalorimeterHit* src = (const CalorimeterHit*)w.first;
+      CalorimeterHit* hit = coll->findByKey<CalorimeterHit>(src->cellID);
+      if ( !hit )  {
+        hit = new CalorimeterHit(src->position);
+        hit->cellID = src->cellID;
+        hit->flag   = src->flag;
+        hit->g4ID   = src->g4ID;
+        coll->add(src->cellID, hit);
+      }
+      hit->energyDeposit += src->energyDeposit;
+      for(Geant4HitData::Contribution c : src->truth)  {
+        if ( c.trackID >= 0 ) c.trackID += offset;
+        hit->truth.push_back(c);
+      }
+    }
+    else if ( w.second == tracker_type )  {
+      const TrackerHit* src = (const TrackerHit*)w.first;
+      TrackerHit* hit = new TrackerHit();
+      *hit = *src;
+      hit->cellID        = src->cellID;
+      hit->flag          = src->flag;
+      hit->g4ID          = src->g4ID;
+      hit->energyDeposit = src->energyDeposit;
+      if ( hit->truth.trackID >= 0 ) hit->truth.trackID += offset;
+      coll->add(hit);
+    }
+    else  {
+      ++num_lost;
+    }
+  }
+  return num_lost;
+}
+
+/// End-of-event callback
+void Geant4SubEventMerger::end(const G4Event* event)  {
+  typedef Geant4ParticleMap::ParticleMap      ParticleMap;
+  typedef Geant4ParticleMap::TrackEquivalents TrackEquivalents;
+  SubEventStore&     store = SubEventStore::instance();
+  G4HCofThisEvent*   hce   = event->GetHCofThisEvent();
+  Geant4ParticleMap* truth = context()->event().extension<Geant4ParticleMap>(false);
+  int num_sub   = max(1, m_numSubEvents);
+  int event_id  = event->GetEventID();
+  int phys      = event_id / num_sub;
+  int sub       = event_id % num_sub;
+  int num_parts = numberOfSubEvents(phys, num_sub);
+  map<string, Geant4HitCollection*> collections;
+  vector<SubEventPart*> parts;
+
+  // Hits of earlier sub-events merged by other threads may be deleted now
+  store.reclaim();
+  if ( truth && !truth->isValid() ) truth = 0;
+
+  // (1) Express the MC truth of the hits in particle identifiers of this sub-event
+  if ( hce )  {
+    vector<int*> track_ids;
+    for(int i=0, n=hce->GetNumberOfCollections(); i<n; ++i)  {
+      Geant4HitCollection* coll = dynamic_cast<Geant4HitCollection*>(hce->GetHC(i));
+      if ( coll )  {
+        collections[coll->GetName()] = coll;
+        for(size_t j=0, nhits=coll->GetSize(); j<nhits; ++j)
+          Geant4HitData::trackIDs(coll->hit(j), track_ids);
+      }
+    }
+    if ( truth ) truth->remapTrackIDs(track_ids);
+  }
+
+  // (2) Hand the data of this sub-event to the store. Unless it is the last to finish, done.
+  SubEventPart* part = new SubEventPart();
+  part->owner = this_thread::get_id();
+  for(auto& c : collections)  {
+    vector<Wrapper>& hits = part->hits[c.first];
+    for(size_t j=0, nhits=c.second->GetSize(); j<nhits; ++j)
+      hits.push_back(c.second->hit(j).releaseData());
+    c.second->clear();
+  }
+  if ( truth ) part->particles.swap(truth->particleMap);
+  {
+    lock_guard<mutex> protect(store.lock);
+    SubEventStore::Entry& e = store.entries[phys];
+    if ( e.second.empty() ) e.second.resize(num_parts, 0);
+    e.second[sub] = part;
+    if ( ++e.first < num_parts )  {
+      debug("+++ Event:%d Stored sub-event %d of physics event %d [%d of %d finished].",
+            event_id, sub, phys, e.first, num_parts);
+      return;
+    }
+    parts.swap(e.second);
+    store.entries.erase(phys);
+  }
+
+  // (3) Merge all sub-events into this event in the order of the sub-event number
+  ParticleMap particles;
+  int    offset   = 0;
+  size_t num_lost = 0;
+  for(SubEventPart* p : parts)  {
+    if ( !p ) continue;
+    for(auto& c : p->hits)  {
+      map<string, Geant4HitCollection*>::iterator i = collections.find(c.first);
+      if ( i == collections.end() )  {
+        num_lost += c.second.size();
+        continue;
+      }
+      num_lost += mergeHits((*i).second, c.second, offset);
+    }
+    int num_particles = p->particles.empty() ? 0 : p->particles.rbegin()->first + 1;
+    if ( truth )  {
+      for(auto& ip : p->particles)  {
+        Geant4Particle* q = ip.second;
+        set<int> parents, daughters;
+        for(int id : q->parents)   parents.insert(parents.end(), id+offset);
+        for(int id : q->daughters) daughters.insert(daughters.end(), id+offset);
+        q->parents.swap(parents);
+        q->daughters.swap(daughters);
+        q->id += offset;
+        particles.insert(particles.end(), make_pair(q->id, q));
+      }
+      p->particles.clear();
+    }
+    offset += num_particles;
+  }
+  if ( truth )  {
+    // The hits refer to particles now: the track equivalents are the identity
+    TrackEquivalents equivalents;
+    for(const auto& ip : particles)
+      equivalents.insert(equivalents.end(), make_pair(ip.first, ip.first));
+    truth->adopt(particles, equivalents);
+  }
+  if ( num_lost > 0 )  {
+    warning("+++ Event:%d %lu hits of the sub-events could not be merged.",
+            event_id, num_lost);
+  }
+  if ( num_parts < num_sub )  {
+    warning("+++ Event:%d Physics event %d is incomplete: only %d of %d sub-events were processed.",
+            event_id, phys, num_parts, num_sub);
+  }
+  info("+++ Event:%d Merged %d sub-events of physics event %d. Particles: %d",
+       event_id, num_parts, phys, offset);
+
+  // (4) Now the record is complete: write it under the physics event number
+  //     and hand the merged data back to the owners
+  G4Event* evt = const_cast<G4Event*>(event);
+  evt->SetEventID(phys);
+  try  {
+    m_outputs(&Geant4EventAction::end, event);
+  }
+  catch(...)  {
+    evt->SetEventID(event_id);
+    store.release(parts);
+    throw;
+  }
+  evt->SetEventID(event_id);
+  store.release(parts);
+}
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4InteractionSplitter)
+DECLARE_GEANT4ACTION(Geant4SubEventMerger)
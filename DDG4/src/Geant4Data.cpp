@@ -26,6 +26,34 @@ using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::sim;
 
+namespace {
+  /// Per-thread pools for the hits created by the standard sensitive actions
+  /** Hits are allocated for every step. The pools keep the freed chunks
+   *  of the previous events and avoid the malloc/free for every hit.
+   */
+  G4ThreadLocal G4Allocator<Geant4Tracker::Hit>*     TrackerHitAllocator = 0;
+  G4ThreadLocal G4Allocator<Geant4Calorimeter::Hit>* CalorimeterHitAllocator = 0;
+
+  /// Allocate a hit from the per-thread pool. Derived classes use the global heap.
+  template <typename T> void* pool_allocate(G4Allocator<T>*& allocator, size_t size)  {
+    if ( size != sizeof(T) )
+      return ::operator new(size);
+    if ( !allocator )
+      allocator = new G4Allocator<T>;
+    return allocator->MallocSingle();
+  }
+
+  /// Return a hit to the per-thread pool
+  template <typename T> void pool_free(G4Allocator<T>*& allocator, void* ptr, size_t size)  {
+    if ( size != sizeof(T) )
+      ::operator delete(ptr);
+    else if ( !allocator )   // Allocated by another thread, which did not yet allocate any hit
+      (allocator = new G4Allocator<T>)->FreeSingle((T*)ptr);
+    else
+      allocator->FreeSingle((T*)ptr);
+  }
+}
+
 /// Default constructor
 SimpleRun::SimpleRun()
   : runID(-1), numEvents(0) {
@@ -89,6 +117,17 @@ Geant4HitData::Contribution Geant4HitData::extractContribution(const G4Step* ste
   return contrib;
 }
 
+/// Append the addresses of the track identifiers of all MC contributions of a tracker or calorimeter hit
+void Geant4HitData::trackIDs(Geant4HitData* hit, std::vector<int*>& track_ids)  {
+  if ( Geant4Tracker::Hit* trk_hit = dynamic_cast<Geant4Tracker::Hit*>(hit) )  {
+    track_ids.push_back(&trk_hit->truth.trackID);
+  }
+  else if ( Geant4Calorimeter::Hit* cal_hit = dynamic_cast<Geant4Calorimeter::Hit*>(hit) )  {
+    for( Contribution& c : cal_hit->truth )
+      track_ids.push_back(&c.trackID);
+  }
+}
+
 /// Default constructor
 Geant4Tracker::Hit::Hit()
 : Geant4HitData(), position(), momentum(), length(0.0), truth(), energyDeposit(0.0) {
@@ -106,6 +145,16 @@ Geant4Tracker::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
 
+/// Pooled allocation from a per-thread fixed size allocator
+void* Geant4Tracker::Hit::operator new(size_t size)  {
+  return pool_allocate(TrackerHitAllocator, size);
+}
+
+/// Return the memory to the per-thread allocator
+void Geant4Tracker::Hit::operator delete(void* ptr, size_t size)  {
+  pool_free(TrackerHitAllocator, ptr, size);
+}
+
 /// Assignment operator
 Geant4Tracker::Hit& Geant4Tracker::Hit::operator=(const Hit& c) {
   if ( &c != this )  {
@@ -158,3 +207,13 @@ Geant4Calorimeter::Hit::Hit(const Position& pos)
 Geant4Calorimeter::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
+
+/// Pooled allocation from a per-thread fixed size allocator
+void* Geant4Calorimeter::Hit::operator new(size_t size)  {
+  return pool_allocate(CalorimeterHitAllocator, size);
+}
+
+/// Return the memory to the per-thread allocator
+void Geant4Calorimeter::Hit::operator delete(void* ptr, size_t size)  {
+  pool_free(CalorimeterHitAllocator, ptr, size);
+}
@@ -34,3 +34,38 @@ void Geant4Field::GetFieldValue(const double pos[4], double *field) const {
   field[2] *= fac2;
   //::printf("Pos: %7.4f %7.4f %7.4f --> %9g %9g %9g\n",p[0],p[1],p[2],field[0],field[1],field[2]);
 }
+
+/// Constructor. The cache distance is given in Geant4 units
+Geant4CachedField::Geant4CachedField(OverlayedField field, double distance)
+  : Geant4Field(field), m_distance2(distance*distance)
+{
+  reset();
+}
+
+/// Reset the cache and the statistics counters
+void Geant4CachedField::reset()   {
+  m_position[0] = m_position[1] = m_position[2] = 0e0;
+  m_value[0] = m_value[1] = m_value[2] = 0e0;
+  m_valid = false;
+  m_numHits = m_numMisses = 0;
+}
+
+void Geant4CachedField::GetFieldValue(const double pos[4], double *field) const {
+  double dx = pos[0]-m_position[0], dy = pos[1]-m_position[1], dz = pos[2]-m_position[2];
+  if ( m_valid && dx*dx + dy*dy + dz*dz <= m_distance2 )  {
+    field[0] = m_value[0];
+    field[1] = m_value[1];
+    field[2] = m_value[2];
+    ++m_numHits;
+    return;
+  }
+  Geant4Field::GetFieldValue(pos, field);
+  m_position[0] = pos[0];
+  m_position[1] = pos[1];
+  m_position[2] = pos[2];
+  m_value[0] = field[0];
+  m_value[1] = field[1];
+  m_value[2] = field[2];
+  m_valid = true;
+  ++m_numMisses;
+}
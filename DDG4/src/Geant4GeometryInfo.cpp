@@ -12,6 +12,7 @@
 //==========================================================================
 
 // Framework include files
+#include "G4VTouchable.hh"
 #include "G4VPhysicalVolume.hh"
 #include "DDG4/Geant4GeometryInfo.h"
 
@@ -61,3 +62,90 @@ void Geant4GeometryInfo::setWorld(const TGeoNode* node)    {
   }
   m_world = g4;
 }
+
+/// Number of indexed placement paths
+size_t Geant4PathIndex::size()  const   {
+  size_t count = 0;
+  for( const auto& e : m_table )
+    count += e.depth > 0 ? 1 : 0;
+  return count;
+}
+
+/// Build the index from the map of placement paths
+void Geant4PathIndex::build(const map<Geant4PlacementPath, VolumeID>& paths)   {
+  size_t capacity = 16, num_volumes = 0;
+  while ( capacity < 2*paths.size() ) capacity <<= 1;
+  for( const auto& p : paths ) num_volumes += p.first.size();
+  m_table.assign(capacity, Entry());
+  m_volumes.clear();
+  m_volumes.reserve(num_volumes);
+  m_mask = capacity - 1;
+  for( const auto& p : paths )   {
+    const Geant4PlacementPath& path = p.first;
+    if ( path.empty() ) continue;
+    size_t h = 0;
+    for( const auto* pv : path ) h = hash(h, pv);
+    size_t slot = h & m_mask;
+    while ( m_table[slot].depth > 0 ) slot = (slot+1) & m_mask;
+    Entry& e   = m_table[slot];
+    e.hash     = h;
+    e.depth    = path.size();
+    e.offset   = m_volumes.size();
+    e.volumeID = p.second;
+    m_volumes.insert(m_volumes.end(), path.begin(), path.end());
+  }
+}
+
+/// Locate the table entry of a path given its hash and an element accessor
+template <typename ACCESSOR> const Geant4PathIndex::Entry*
+Geant4PathIndex::locate(size_t h, unsigned depth, const ACCESSOR& acc) const  {
+  for( size_t slot = h & m_mask; ; slot = (slot+1) & m_mask )  {
+    const Entry& e = m_table[slot];
+    if ( e.depth == 0 )
+      return 0;
+    if ( e.hash == h && e.depth == depth )  {
+      const G4VPhysicalVolume* const* vols = &m_volumes[e.offset];
+      unsigned i = 0;
+      while ( i < depth && vols[i] == acc(i) ) ++i;
+      if ( i == depth )
+        return &e;
+    }
+  }
+}
+
+namespace {
+  /// Element accessor for placement paths
+  struct PathAccessor  {
+    const Geant4PathIndex::Geant4PlacementPath& path;
+    PathAccessor(const Geant4PathIndex::Geant4PlacementPath& p) : path(p) {}
+    const G4VPhysicalVolume* operator()(unsigned i) const {  return path[i];  }
+  };
+  /// Element accessor for touchable histories
+  struct TouchableAccessor  {
+    const G4VTouchable* touchable;
+    TouchableAccessor(const G4VTouchable* t) : touchable(t) {}
+    const G4VPhysicalVolume* operator()(unsigned i) const {  return touchable->GetVolume(i);  }
+  };
+}
+
+/// Lookup by placement path. Returns false if the path is not known
+bool Geant4PathIndex::find(const Geant4PlacementPath& path, VolumeID& volume_id)  const   {
+  if ( m_table.empty() || path.empty() ) return false;
+  size_t h = 0;
+  for( const auto* pv : path ) h = hash(h, pv);
+  const Entry* e = locate(h, path.size(), PathAccessor(path));
+  if ( e ) volume_id = e->volumeID;
+  return e != 0;
+}
+
+/// Lookup by touchable history. Returns false if the path is not known
+bool Geant4PathIndex::find(const G4VTouchable* touchable, VolumeID& volume_id)  const   {
+  if ( m_table.empty() || !touchable ) return false;
+  int depth = touchable->GetHistoryDepth();
+  if ( depth <= 0 ) return false;
+  size_t h = 0;
+  for( int i = 0; i < depth; ++i ) h = hash(h, touchable->GetVolume(i));
+  const Entry* e = locate(h, depth, TouchableAccessor(touchable));
+  if ( e ) volume_id = e->volumeID;
+  return e != 0;
+}
@@ -17,6 +17,9 @@
 #include "DDG4/Geant4Data.h"
 #include "G4Allocator.hh"
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep;
 using namespace dd4hep::sim;
 
@@ -73,6 +76,65 @@ Geant4HitWrapper::Wrapper Geant4HitWrapper::releaseData() {
   return w;
 }
 
+constexpr size_t Geant4HitCollection::Keys::npos;
+
+/// Accumulate the statistics of another index
+void Geant4HitCollection::Keys::Statistics::add(const Statistics& s)   {
+  peakSize  = std::max(peakSize, s.peakSize);
+  maxProbe  = std::max(maxProbe, s.maxProbe);
+  lookups  += s.lookups;
+  probes   += s.probes;
+  rehashes += s.rehashes;
+}
+
+/// Rebuild the table with a new capacity (power of 2)
+void Geant4HitCollection::Keys::rehash(size_t capacity)   {
+  std::vector<VolumeID> keys(capacity, 0);
+  std::vector<size_t>   values(capacity, npos);
+  size_t mask = capacity - 1;
+  for (size_t i = 0, n = m_values.size(); i < n; ++i)   {
+    if ( m_values[i] != npos )  {
+      size_t j = hash(m_keys[i]) & mask;
+      while ( values[j] != npos ) j = (j + 1) & mask;
+      keys[j]   = m_keys[i];
+      values[j] = m_values[i];
+    }
+  }
+  m_keys.swap(keys);
+  m_values.swap(values);
+  m_mask = mask;
+  ++m_stat.rehashes;
+}
+
+/// Prepare the table to hold the requested number of keys without growing
+void Geant4HitCollection::Keys::reserve(size_t num_keys)   {
+  size_t capacity = 16;
+  while ( capacity < 2*num_keys ) capacity <<= 1;
+  if ( capacity > m_values.size() )
+    rehash(capacity);
+}
+
+/// Remove all keys. The capacity is kept
+void Geant4HitCollection::Keys::clear()   {
+  if ( m_size > 0 )  {
+    std::fill(m_values.begin(), m_values.end(), npos);
+    m_size = 0;
+  }
+}
+
+/// Insert a new key. Returns false if the key is already present
+bool Geant4HitCollection::Keys::insert(VolumeID key, size_t value)   {
+  if ( 2*(m_size+1) > m_values.size() )
+    rehash(m_values.empty() ? 16 : 2*m_values.size());
+  size_t i = slot(key);
+  if ( m_values[i] != npos )
+    return false;
+  m_keys[i]   = key;
+  m_values[i] = value;
+  if ( ++m_size > m_stat.peakSize ) m_stat.peakSize = m_size;
+  return true;
+}
+
 /// Default destructor
 Geant4HitCollection::Compare::~Compare()  {
 }
@@ -124,12 +186,18 @@ void* Geant4HitCollection::findHit(const Compare& cmp)  {
 
 /// Find hit in a collection by comparison of the key
 Geant4HitWrapper* Geant4HitCollection::findHitByKey(VolumeID key)   {
-  Keys::const_iterator i=m_keys.find(key);
-  if ( i == m_keys.end() ) return 0;
-  m_lastHit = (*i).second;
+  size_t idx = m_keys.find(key);
+  if ( idx == Keys::npos ) return 0;
+  m_lastHit = idx;
   return &m_hits.at(m_lastHit);
 }
 
+/// Reserve space for the expected number of hits and keys
+void Geant4HitCollection::reserve(size_t num_hits)   {
+  m_hits.reserve(num_hits);
+  m_keys.reserve(num_hits);
+}
+
 /// Release all hits from the Geant4 container and pass ownership to the caller
 void Geant4HitCollection::releaseData(const ComponentCast& cast, std::vector<void*>* result) {
   for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
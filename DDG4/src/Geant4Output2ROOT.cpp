@@ -18,39 +18,91 @@
 #include "DDG4/Geant4HitCollection.h"
 #include "DDG4/Geant4Output2ROOT.h"
 #include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4ThreadPool.h"
+#include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4Data.h"
 // Geant4 include files
 #include "G4HCofThisEvent.hh"
+#include "G4Threading.hh"
+#include "G4Event.hh"
 
 // ROOT include files
 #include "TFile.h"
 #include "TTree.h"
+#include "TROOT.h"
 #include "TBranch.h"
 
+// C/C++ include files
+#include <algorithm>
+#include <chrono>
+
 using namespace dd4hep::sim;
 using namespace dd4hep;
 using namespace std;
 
+namespace {
+  /// Release a MC particle after writing
+  void release_particle(void* ptr)  {
+    ((Geant4Particle*)ptr)->release();
+  }
+}
+
 /// Standard constructor
 Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const string& nam)
-  : Geant4OutputAction(ctxt, nam), m_file(0), m_tree(0) {
+  : Geant4OutputAction(ctxt, nam), m_file(0), m_tree(0), m_remapPool(0), m_record(0),
+    m_writing(0), m_ioThread(0), m_stop(false),
+    m_numEvents(0), m_numBytes(0), m_eventSeconds(0e0), m_ioSeconds(0e0) {
   declareProperty("Section", m_section = "EVENT");
   declareProperty("HandleMCTruth", m_handleMCTruth = true);
+  declareProperty("FilePerThread", m_filePerThread = false);
+  declareProperty("QueueSize", m_queueSize = 0);
+  declareProperty("RemapThreads", m_remapThreads = 1);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4Output2ROOT::~Geant4Output2ROOT() {
   InstanceCount::decrement(this);
+  stop();
+  detail::deletePtr(m_remapPool);
+  destroy(m_record);
+  m_record = 0;
+  if ( !m_pending.empty() )  {
+    printout(WARNING,name(),"+++ %ld events were not finished and are not written.",m_pending.size());
+  }
+  // Normally the event threads delete their events at the end of the run (see endRun)
+  for(auto& p : m_pending) destroy(p.second);
+  m_pending.clear();
+  for(auto* r : m_written) destroy(r);
+  m_written.clear();
   if (m_file) {
     TDirectory::TContext ctxt(m_file);
     m_tree->Write();
     m_file->Close();
     m_tree = 0;
+    double mb = 1024e0*1024e0;
+    double evt_sec = m_eventSeconds > 0e0 ? m_eventSeconds : 1e-9;
+    double io_sec  = m_ioSeconds > 0e0 ? m_ioSeconds : evt_sec;
+    printout(INFO,name(),"+++ Wrote %ld events: %.2f MB uncompressed, %.2f MB to file %s",
+             m_numEvents, double(m_numBytes)/mb, double(m_file->GetBytesWritten())/mb,
+             m_file->GetName());
+    printout(INFO,name(),"+++ Event threads: %.3f s in output (%.1f events/s, %.2f MB/s)%s",
+             m_eventSeconds, double(m_numEvents)/evt_sec, double(m_numBytes)/mb/evt_sec,
+             m_queueSize > 0 ? "" : " [synchronous]");
+    if ( m_queueSize > 0 )  {
+      printout(INFO,name(),"+++ I/O thread:    %.3f s filling  (%.1f events/s, %.2f MB/s)",
+               m_ioSeconds, double(m_numEvents)/io_sec, double(m_numBytes)/mb/io_sec);
+    }
     detail::deletePtr (m_file);
   }
 }
 
+/// Set or update client for the use in a new thread fiber
+void Geant4Output2ROOT::configureFiber(Geant4Context* thread_ctxt)  {
+  Geant4OutputAction::configureFiber(thread_ctxt);
+  thread_ctxt->eventAction().callAtFinal(this, &Geant4Output2ROOT::endEvent);
+}
+
 /// Create/access tree by name
 TTree* Geant4Output2ROOT::section(const string& nam) {
   Sections::const_iterator i = m_sections.find(nam);
@@ -67,85 +119,319 @@ TTree* Geant4Output2ROOT::section(const string& nam) {
 void Geant4Output2ROOT::beginRun(const G4Run* run) {
   if (!m_file && !m_output.empty()) {
     TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
-    m_file = TFile::Open(m_output.c_str(), "RECREATE", "dd4hep Simulation data");
+    string fname = m_output;
+    int thread_id = G4Threading::G4GetThreadId();
+    if ( m_filePerThread && thread_id >= 0 )  {
+      // A shared action is owned by the master, but called by all worker threads
+      if ( context()->kernel().isMaster() )  {
+        except("+++ FilePerThread requires an output action per worker thread. "
+               "Create the action in the worker setup and do not share it.");
+      }
+      size_t idx = fname.rfind(".root");
+      string tag = "." + to_string(thread_id);
+      if ( idx == string::npos ) fname += tag;
+      else fname.insert(idx, tag);
+    }
+    m_file = TFile::Open(fname.c_str(), "RECREATE", "dd4hep Simulation data");
     if (m_file->IsZombie()) {
       detail::deletePtr (m_file);
-      throw runtime_error("Failed to open ROOT output file:'" + m_output + "'");
+      throw runtime_error("Failed to open ROOT output file:'" + fname + "'");
     }
     m_tree = section("EVENT");
+    if ( m_queueSize > 0 )  {
+      ROOT::EnableThreadSafety();
+      m_stop = false;
+      m_ioThread = new thread(&Geant4Output2ROOT::write, this);
+      printout(INFO,name(),"+++ Started I/O thread for %s [Queue size: %d events]",
+               fname.c_str(), m_queueSize);
+    }
   }
   Geant4OutputAction::beginRun(run);
 }
 
+/// Callback at the end of the run: delete the written events of the calling thread
+void Geant4Output2ROOT::endRun(const G4Run* run) {
+  if ( m_ioThread )  {
+    vector<EventRecord*> records;  {
+      thread::id self = this_thread::get_id();
+      auto own = [self](const EventRecord* r) { return r->thread == self; };
+      unique_lock<mutex> lock(m_queueLock);
+      m_haveWritten.wait(lock, [this,&own]()  {
+          return !(m_writing && own(m_writing)) && none_of(m_queue.begin(), m_queue.end(), own);
+        });
+      // Events of this thread, which never reached the final end-of-event, e.g. aborted events
+      for(PendingEvents::iterator i=m_pending.begin(); i!=m_pending.end(); )  {
+        if ( own((*i).second) )  {
+          records.push_back((*i).second);
+          i = m_pending.erase(i);
+          continue;
+        }
+        ++i;
+      }
+    }
+    for(EventRecord* r : records) destroy(r);
+    destroyWritten();
+  }
+  Geant4OutputAction::endRun(run);
+}
+
+/// Geant4 end-of-event callback. Measures the time spent in the output
+void Geant4Output2ROOT::end(const G4Event* event)  {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  Geant4OutputAction::end(event);
+  double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  lock_guard<mutex> lock(m_queueLock);
+  m_eventSeconds += sec;
+}
+
+/// Access the ROOT class of a collection type
+TClass* Geant4Output2ROOT::rootClass(const ComponentCast& type)  {
+  Classes::const_iterator i = m_classes.find(&type.type);
+  if ( i != m_classes.end() )  {
+    return (*i).second;
+  }
+  TClass* cl = TBuffer::GetClass(type.type);
+  if ( !cl )  {
+    throw runtime_error("No ROOT TClass object availible for object type:" + typeName(type.type));
+  }
+  m_classes.insert(make_pair(&type.type, cl));
+  return cl;
+}
+
 /// Fill single EVENT branch entry (Geant4 collection data)
 int Geant4Output2ROOT::fill(const string& nam, const ComponentCast& type, void* ptr) {
   if (m_file) {
-    TBranch* b = 0;
-    Branches::const_iterator i = m_branches.find(nam);
-    if (i == m_branches.end()) {
-      TClass* cl = TBuffer::GetClass(type.type);
-      if (cl) {
-        b = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0);
-        b->SetAutoDelete(false);
-        m_branches.insert(make_pair(nam, b));
-      }
-      else {
-        throw runtime_error("No ROOT TClass object availible for object type:" + typeName(type.type));
-      }
+    if ( m_ioThread )  {
+      throw runtime_error("Cannot fill ROOT collection " + nam + ": the tree is owned by the I/O thread.");
     }
-    else {
-      b = (*i).second;
+    return fillBranch(nam, rootClass(type), ptr);
+  }
+  return 0;
+}
+
+/// Fill single branch entry. Branches with less entries are padded
+int Geant4Output2ROOT::fillBranch(const string& nam, TClass* cl, void* ptr) {
+  TBranch* b = 0;
+  Branches::const_iterator i = m_branches.find(nam);
+  if (i == m_branches.end()) {
+    b = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0);
+    b->SetAutoDelete(false);
+    m_branches.insert(make_pair(nam, b));
+  }
+  else {
+    b = (*i).second;
+  }
+  Long64_t evt = b->GetEntries(), nevt = b->GetTree()->GetEntries(), num = nevt - evt;
+  if (nevt > evt) {
+    b->SetAddress(0);
+    while (num > 0) {
+      b->Fill();
+      --num;
     }
-    Long64_t evt = b->GetEntries(), nevt = b->GetTree()->GetEntries(), num = nevt - evt;
-    if (nevt > evt) {
-      b->SetAddress(0);
+  }
+  b->SetAddress(&ptr);
+  int nbytes = b->Fill();
+  if (nbytes < 0) {
+    throw runtime_error("Failed to write ROOT collection:" + nam + "!");
+  }
+  m_numBytes += nbytes;
+  return nbytes;
+}
+
+/// Add a collection to the event record handed to the I/O thread
+Geant4Output2ROOT::Collection& Geant4Output2ROOT::addCollection(const string& nam, const ComponentCast& type) {
+  if ( !m_record )  {
+    m_record = new EventRecord();
+    m_record->thread = this_thread::get_id();
+  }
+  m_record->collections.push_back(Collection());
+  Collection& c = m_record->collections.back();
+  c.name = nam;
+  c.cls  = rootClass(type);
+  return c;
+}
+
+/// Pad all branches to the number of entries of the event tree and close the entry
+void Geant4Output2ROOT::commitEntry() {
+  TObjArray* a = m_tree->GetListOfBranches();
+  Long64_t evt = m_tree->GetEntries() + 1;
+  Int_t nb = a->GetEntriesFast();
+  /// Fill NULL pointers to all branches, which have less entries than the Event branch
+  for (Int_t i = 0; i < nb; ++i) {
+    TBranch* br_ptr = (TBranch*) a->UncheckedAt(i);
+    Long64_t br_evt = br_ptr->GetEntries();
+    if (br_evt < evt) {
+      Long64_t num = evt - br_evt;
+      br_ptr->SetAddress(0);
       while (num > 0) {
-        b->Fill();
+        br_ptr->Fill();
         --num;
       }
     }
-    b->SetAddress(&ptr);
-    int nbytes = b->Fill();
-    if (nbytes < 0) {
-      throw runtime_error("Failed to write ROOT collection:" + nam + "!");
-    }
-    return nbytes;
   }
-  return 0;
+  m_tree->SetEntries(evt);
+  ++m_numEvents;
 }
 
 /// Commit data at end of filling procedure
 void Geant4Output2ROOT::commit(OutputContext<G4Event>& ctxt) {
   if (m_file) {
-    TObjArray* a = m_tree->GetListOfBranches();
-    Long64_t evt = m_tree->GetEntries() + 1;
-    Int_t nb = a->GetEntriesFast();
-    /// Fill NULL pointers to all branches, which have less entries than the Event branch
-    for (Int_t i = 0; i < nb; ++i) {
-      TBranch* br_ptr = (TBranch*) a->UncheckedAt(i);
-      Long64_t br_evt = br_ptr->GetEntries();
-      if (br_evt < evt) {
-        Long64_t num = evt - br_evt;
-        br_ptr->SetAddress(0);
-        while (num > 0) {
-          br_ptr->Fill();
-          --num;
-        }
+    if ( m_ioThread )  {
+      // The hits are taken once all event actions are done: see endEvent
+      EventRecord* record = m_record;
+      if ( !record )  {
+        record = new EventRecord();
+        record->thread = this_thread::get_id();
       }
+      m_record = 0;
+      lock_guard<mutex> lock(m_queueLock);
+      m_pending[ctxt.context] = record;
+    }
+    else  {
+      commitEntry();
     }
-    m_tree->SetEntries(evt);
   }
   Geant4OutputAction::commit(ctxt);
 }
 
+/// Final end-of-event callback: take the event data and hand them to the I/O thread
+void Geant4Output2ROOT::endEvent(const G4Event* event) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  EventRecord* record = 0;  {
+    lock_guard<mutex> lock(m_queueLock);
+    PendingEvents::iterator i = m_pending.find(event);
+    if ( i == m_pending.end() ) return;
+    record = (*i).second;
+    m_pending.erase(i);
+  }
+  for(auto& c : record->collections)  {
+    if ( c.hits )  {
+      c.hits->releaseHitsUnchecked(c.objects);
+      c.hits = 0;
+    }
+  }
+  push(record);
+  destroyWritten();
+  double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  lock_guard<mutex> lock(m_queueLock);
+  m_eventSeconds += sec;
+}
+
+/// Hand the event data to the I/O thread. Waits only if the queue is full
+void Geant4Output2ROOT::push(EventRecord* record) {
+  unique_lock<mutex> lock(m_queueLock);
+  m_haveSpace.wait(lock, [this]() { return int(m_queue.size()) < m_queueSize; });
+  m_queue.push_back(record);
+  m_haveData.notify_one();
+}
+
+/// Delete the objects of an event record
+void Geant4Output2ROOT::destroy(EventRecord* record) {
+  if ( record )  {
+    for(const auto& c : record->collections)  {
+      if ( c.destroy )  {
+        for(void* obj : c.objects) (*c.destroy)(obj);
+      }
+    }
+    delete record;
+  }
+}
+
+/// Delete the written events of the calling thread
+void Geant4Output2ROOT::destroyWritten() {
+  vector<EventRecord*> records;  {
+    lock_guard<mutex> lock(m_queueLock);
+    thread::id self = this_thread::get_id();
+    auto last = partition(m_written.begin(), m_written.end(),
+                          [self](const EventRecord* r) { return r->thread != self; });
+    records.assign(last, m_written.end());
+    m_written.erase(last, m_written.end());
+  }
+  for(EventRecord* r : records) destroy(r);
+}
+
+/// Body of the I/O thread: fill the queued events to the event tree
+void Geant4Output2ROOT::write() {
+  for(;;)  {
+    EventRecord* record = 0;  {
+      unique_lock<mutex> lock(m_queueLock);
+      m_haveData.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+      if ( m_queue.empty() ) break;
+      record = m_writing = m_queue.front();
+      m_queue.pop_front();
+      m_haveSpace.notify_one();
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    try  {
+      for(auto& c : record->collections)
+        fillBranch(c.name, c.cls, &c.objects);
+      commitEntry();
+    }
+    catch(const exception& e)   {
+      printout(ERROR,name(),"+++ Exception while writing event: %s",e.what());
+    }
+    catch(...)   {
+      printout(ERROR,name(),"+++ UNKNOWN Exception while writing event.");
+    }
+    double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    // The objects are deleted by the thread, which created them
+    lock_guard<mutex> lock(m_queueLock);
+    m_ioSeconds += sec;
+    m_written.push_back(record);
+    m_writing = 0;
+    m_haveWritten.notify_all();
+  }
+}
+
+/// Drain the event queue and stop the I/O thread
+void Geant4Output2ROOT::stop() {
+  if ( m_ioThread )  {  {
+      lock_guard<mutex> lock(m_queueLock);
+      m_stop = true;
+      m_haveData.notify_all();
+    }
+    m_ioThread->join();
+    detail::deletePtr(m_ioThread);
+  }
+}
+
 /// Callback to store the Geant4 event
-void Geant4Output2ROOT::saveEvent(OutputContext<G4Event>& /* ctxt */) {
+void Geant4Output2ROOT::saveEvent(OutputContext<G4Event>& ctxt) {
   Geant4ParticleMap* parts = context()->event().extension<Geant4ParticleMap>();
+  G4HCofThisEvent* hce = ctxt.context->GetHCofThisEvent();
+  if ( m_handleMCTruth && m_truth && hce )   {
+    // Remap the track identifiers of all hit collections in one bulk pass
+    vector<int*> track_ids;
+    for(int i=0, n=hce->GetNumberOfCollections(); i<n; ++i)  {
+      Geant4HitCollection* coll = dynamic_cast<Geant4HitCollection*>(hce->GetHC(i));
+      if ( coll )  {
+        for(size_t j=0, nhits=coll->GetSize(); j<nhits; ++j)
+          Geant4HitData::trackIDs(coll->hit(j), track_ids);
+      }
+    }
+    try  {
+      if ( !m_remapPool && m_remapThreads > 1 )  {
+        m_remapPool = new Geant4ThreadPool(m_remapThreads-1);
+      }
+      m_truth->remapTrackIDs(track_ids, m_remapPool);
+    }
+    catch(...)   {
+      printout(ERROR,name(),"+++ Exception while remapping the MC truth of the hit collections.");
+    }
+  }
   if ( parts )   {
     typedef Geant4HitWrapper::HitManipulator Manip;
     typedef Geant4ParticleMap::ParticleMap ParticleMap;
     Manip* manipulator = Geant4HitWrapper::manipulator<Geant4Particle>();
     const ParticleMap& pm = parts->particles();
+    if ( m_file && m_ioThread )  {
+      // Keep the particles alive until they are written
+      Collection& c = addCollection("MCParticles",manipulator->vec_type);
+      c.destroy = release_particle;
+      for(ParticleMap::const_iterator i=pm.begin(); i!=pm.end(); ++i)
+        c.objects.push_back((*i).second->addRef());
+      return;
+    }
     vector<void*> particles;
     for(ParticleMap::const_iterator i=pm.begin(); i!=pm.end(); ++i)    {
       particles.push_back((ParticleMap::mapped_type*)(*i).second);
@@ -160,33 +446,15 @@ void Geant4Output2ROOT::saveCollection(OutputContext<G4Event>& /* ctxt */, G4VHi
   string hc_nam = collection->GetName();
   vector<void*> hits;
   if (coll) {
-    coll->getHitsUnchecked(hits);
-    size_t nhits = coll->GetSize();
-    if ( m_handleMCTruth && m_truth && nhits > 0 )   {
-      try  {
-        for(size_t i=0; i<nhits; ++i)   {
-          Geant4HitData* h = coll->hit(i);
-          Geant4Tracker::Hit* trk_hit = dynamic_cast<Geant4Tracker::Hit*>(h);
-          if ( 0 != trk_hit )   {
-            Geant4HitData::Contribution& t = trk_hit->truth;
-            int trackID = t.trackID;
-            t.trackID = m_truth->particleID(trackID);
-          }
-          Geant4Calorimeter::Hit* cal_hit = dynamic_cast<Geant4Calorimeter::Hit*>(h);
-          if ( 0 != cal_hit )   {
-            Geant4HitData::Contributions& c = cal_hit->truth;
-            for(Geant4HitData::Contributions::iterator j=c.begin(); j!=c.end(); ++j)  {
-              Geant4HitData::Contribution& t = *j;
-              int trackID = t.trackID;
-              t.trackID = m_truth->particleID(trackID);
-            }
-          }
-        }
-      }
-      catch(...)   {
-        printout(ERROR,name(),"+++ Exception while saving collection %s.",hc_nam.c_str());
-      }
+    if ( m_file && m_ioThread )  {
+      // The hits are taken from the collection at the end of the event
+      Collection& c = addCollection(hc_nam, coll->vector_type());
+      c.destroy = coll->type().destroy;
+      c.hits    = coll;
+      return;
     }
+    // The MC truth of the hits was already remapped in bulk by saveEvent
+    coll->getHitsUnchecked(hits);
     fill(hc_nam, coll->vector_type(), &hits);
   }
 }
@@ -16,6 +16,7 @@
 #include "DD4hep/Primitives.h"
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4ThreadPool.h"
 #include "TDatabasePDG.h"
 #include "TParticlePDG.h"
 #include "G4ParticleTable.hh"
@@ -400,10 +401,8 @@ void Geant4ParticleMap::dump()  const  {
 /// Adopt particle maps
 void Geant4ParticleMap::adopt(ParticleMap& pm, TrackEquivalents& equiv)    {
   clear();
-  particleMap = pm;
-  equivalentTracks = equiv;
-  pm.clear();
-  equiv.clear();
+  particleMap.swap(pm);
+  equivalentTracks.swap(equiv);
   //dump();
 }
 
@@ -421,3 +420,54 @@ int Geant4ParticleMap::particleID(int g4_id, bool) const   {
   dump();
   return -1;
 }
+
+/// Replace in bulk Geant4 track identifiers by the equivalent particle identifiers
+size_t Geant4ParticleMap::remapTrackIDs(const std::vector<int*>& track_ids, Geant4ThreadPool* pool)  const   {
+  using namespace std;
+  // The track identifiers are dense: flat lookup table (-1: unknown) of the current equivalents
+  vector<int> particle_ids;
+  if ( !equivalentTracks.empty() && equivalentTracks.begin()->first >= 0 )  {
+    particle_ids.assign(equivalentTracks.rbegin()->first+1, -1);
+    for(const auto& e : equivalentTracks) particle_ids[e.first] = e.second;
+  }
+  size_t num_ids = track_ids.size();
+  size_t num_chunks = pool ? min(pool->size()+1, num_ids/1024+1) : 1;
+  vector<size_t> missing(num_chunks, 0);
+  auto remap = [this, &particle_ids, &track_ids, &missing, num_ids, num_chunks](size_t chunk)  {
+    size_t first = chunk*num_ids/num_chunks, last = (chunk+1)*num_ids/num_chunks;
+    size_t num_slots = particle_ids.size();
+    for(size_t i=first; i<last; ++i)  {
+      int& id = *track_ids[i];
+      // Tracks already found to be unknown are not reported again
+      if ( id == -1 ) continue;
+      if ( num_slots > 0 )  {
+        if ( id >= 0 && size_t(id) < num_slots && particle_ids[id] >= 0 )  {
+          id = particle_ids[id];
+          continue;
+        }
+      }
+      else  {
+        TrackEquivalents::const_iterator iequiv = equivalentTracks.find(id);
+        if ( iequiv != equivalentTracks.end() )  {
+          id = (*iequiv).second;
+          continue;
+        }
+      }
+      id = -1;
+      ++missing[chunk];
+    }
+  };
+  if ( num_chunks > 1 )
+    pool->run(num_chunks, remap);
+  else
+    remap(0);
+
+  size_t num_missing = 0;
+  for(size_t m : missing) num_missing += m;
+  if ( num_missing > 0 )  {
+    printout(ERROR,"Geant4ParticleMap","+++ No Equivalent particle for %lu of %lu tracks."
+             " Monte Carlo truth record looks broken!",num_missing,num_ids);
+    dump();
+  }
+  return num_missing;
+}
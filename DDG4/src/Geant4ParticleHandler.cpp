@@ -115,9 +115,8 @@ bool Geant4ParticleHandler::adopt(Geant4Action* action)    {
 
 /// Clear particle maps
 void Geant4ParticleHandler::clear()  {
-  detail::releaseObjects(m_particleMap);
-  m_particleMap.clear();
-  m_equivalentTracks.clear();
+  m_particles.releaseParticles();
+  m_particles.clear();
 }
 
 /// Mark a Geant4 track to be kept for later MC truth analysis
@@ -218,7 +217,7 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
       except("+++ Tracking preaction: Primary particle without generator particle!");
     }
     reason |= (G4PARTICLE_PRIMARY|G4PARTICLE_ABOVE_ENERGY_THRESHOLD);
-    m_particleMap[h.id()] = prim_part->addRef();
+    m_particles.insert(h.id(), prim_part->addRef());
   }
 
   if ( prim_part )   {
@@ -339,15 +338,16 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
   // - to be kept due to creator process
   //
   if ( !mask.isNull() )   {
-    m_equivalentTracks[g4_id] = g4_id;
-    ParticleMap::iterator ip = m_particleMap.find(g4_id);
+    m_particles.setEquivalent(g4_id, g4_id);
+    Particle* part = m_particles.get(g4_id);
     if ( mask.isSet(G4PARTICLE_PRIMARY) )   {
-      ph.dump2(outputLevel()-1,name(),"Add Primary",h.id(),ip!=m_particleMap.end());
+      ph.dump2(outputLevel()-1,name(),"Add Primary",h.id(),part != 0);
     }
     // Create a new MC particle from the current track information saved in the pre-tracking action
-    Particle* part = 0;
-    if ( ip==m_particleMap.end() ) part = m_particleMap[g4_id] = new Particle();
-    else part = (*ip).second;
+    if ( !part )  {
+      part = new Particle();
+      m_particles.insert(g4_id, part);
+    }
     part->get_data(m_currTrack);
   }
   else   {
@@ -356,17 +356,12 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     // We will not store them on the record, but have to memorise the
     // track identifier in order to restore the history for the created hits.
     int pid = m_currTrack.g4Parent;
-    m_equivalentTracks[g4_id] = pid;
+    m_particles.setEquivalent(g4_id, pid);
     // Need to find the last stored particle and OR this particle's mask
     // with the mask of the last stored particle
-    TrackEquivalents::const_iterator iequiv, iend = m_equivalentTracks.end();
-    ParticleMap::iterator ip;
-    for(ip=m_particleMap.find(pid); ip == m_particleMap.end(); ip=m_particleMap.find(pid))  {
-      if ((iequiv=m_equivalentTracks.find(pid)) == iend) break;  // ERROR
-      pid = (*iequiv).second;
-    }
-    if ( ip != m_particleMap.end() )
-      (*ip).second->reason |= track_reason;
+    Particle* last = m_particles.equivalentParticle(pid);
+    if ( last )
+      last->reason |= track_reason;
     else
       ph.dumpWithVertex(outputLevel()+3,name(),"FATAL: No real particle parent present");
   }
@@ -378,8 +373,7 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
   info("+++ Event %d Begin event action. Access event related information.",event->GetEventID());
   m_primaryMap = context()->event().extension<Geant4PrimaryMap>();
   m_globalParticleID = interaction->nextPID();
-  m_particleMap.clear();
-  m_equivalentTracks.clear();
+  m_particles.clear();
   /// Call the user particle handler
   if ( m_userHandler )  {
     m_userHandler->begin(event);
@@ -388,8 +382,9 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
 
 /// Debugging: Dump Geant4 particle map
 void Geant4ParticleHandler::dumpMap(const char* tag)  const  {
-  for(ParticleMap::const_iterator iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Geant4ParticleHandle((*i).second).dump4(INFO,name(),tag);
+  for(int id=0, n=m_particles.slots(); id<n; ++id)  {
+    if ( Particle* p = m_particles.get(id) )
+      Geant4ParticleHandle(p).dump4(INFO,name(),tag);
   }
 }
 
@@ -397,10 +392,14 @@ void Geant4ParticleHandler::dumpMap(const char* tag)  const  {
 void Geant4ParticleHandler::endEvent(const G4Event* event)  {
   int count = 0;
   int level = outputLevel();
+  vector<int> candidates;
+  /// The keep decision is taken once for all particles. Further passes only
+  /// re-evaluate the few particles whose decision depended on removed ones.
   do {
     if ( level <= VERBOSE ) dumpMap("Particle");
-    debug("+++ Iteration:%d Tracks:%d Equivalents:%d",++count,m_particleMap.size(),m_equivalentTracks.size());
-  } while( recombineParents() > 0 );
+    debug("+++ Iteration:%d Tracks:%lu Equivalents:%lu Candidates:%lu",++count,
+          m_particles.size(),m_particles.numEquivalents(),candidates.size());
+  } while( recombineParents(candidates) > 0 );
 
   if ( level <= VERBOSE ) dumpMap("Recombined");
   // Rebase the simulated tracks, so that they fit to the generator particles
@@ -415,8 +414,11 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
   setVertexEndpointBit();
 
   // Now export the data to the final record.
+  ParticleMap       particles;
+  TrackEquivalents  equivalents;
   Geant4ParticleMap* part_map = context()->event().extension<Geant4ParticleMap>();
-  part_map->adopt(m_particleMap, m_equivalentTracks);
+  m_particles.exportTo(particles, equivalents);
+  part_map->adopt(particles, equivalents);
   m_primaryMap = 0;
   clear();
 }
@@ -424,9 +426,8 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
 /// Rebase the simulated tracks, so that they fit to the generator particles
 void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   /// No we have to update the map of equivalent tracks and assign the 'equivalentTrack' entry
-  TrackEquivalents equivalents, orgParticles;
-  ParticleMap      finalParticles;
-  ParticleMap::const_iterator ipar, iend, i;
+  Geant4ParticleTable finalParticles;
+  ParticleMap::const_iterator iend, i;
   int count;
 
   Geant4PrimaryInteraction* interaction = context()->event().extension<Geant4PrimaryInteraction>();
@@ -436,38 +437,33 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   //       It is assumed the mapping is ZERO based without holes.
   for(count = 0, iend=pm.end(), i=pm.begin(); i!=iend; ++i)  {
     Particle* p = (*i).second;
-    orgParticles[p->id] = p->id;
-    finalParticles[p->id] = p;
+    finalParticles.insert(p->id, p);
     if ( p->id > count ) count = p->id;
     if ( (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
       p->addRef();
     }
   }
   // (1.1) Define the new particle mapping for the simulated tracks
-  for(++count, iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
-    if ( (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
-      //if ( orgParticles.find(p->id) == orgParticles.end() )  {
-      orgParticles[p->id] = count;
-      finalParticles[count] = p;
+  ++count;
+  for(int g4_id=0, n=m_particles.slots(); g4_id<n; ++g4_id)  {
+    Particle* p = m_particles.get(g4_id);
+    if ( p && (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
+      finalParticles.insert(count, p);
       p->id = count;
       ++count;
     }
   }
   // (2) Re-evaluate the corresponding geant4 track equivalents using the new mapping
-  for(TrackEquivalents::iterator ie=m_equivalentTracks.begin(),ie_end=m_equivalentTracks.end(); ie!=ie_end; ++ie)  {
-    int g4_equiv = (*ie).first;
-    while( (ipar=m_particleMap.find(g4_equiv)) == m_particleMap.end() )  {
-      TrackEquivalents::const_iterator iequiv = m_equivalentTracks.find(g4_equiv);
-      if ( iequiv == ie_end )  {
-        break;  // ERROR !! Will be handled by printout below because ipar==end()
-      }
-      g4_equiv = (*iequiv).second;
+  for(int g4_id=0, n=m_particles.equivalentSlots(); g4_id<n; ++g4_id)  {
+    int equiv = m_particles.equivalent(g4_id);
+    if ( equiv == Geant4ParticleTable::NO_EQUIVALENT )  {
+      continue;
     }
-    TrackEquivalents::mapped_type equiv = (*ie).second;
-    if ( ipar != m_particleMap.end() )   {
-      equivalents[(*ie).first] = (*ipar).second->id;  // requires (1) !
-      Geant4ParticleHandle p = (*ipar).second;
+    int g4_equiv = g4_id;
+    Particle* q = m_particles.equivalentParticle(g4_id, &g4_equiv);
+    if ( q )   {
+      finalParticles.setEquivalent(g4_id, q->id);  // requires (1) !
+      Geant4ParticleHandle p = q;
       const G4ParticleDefinition* def = p.definition();
       int pdg = int(fabs(def->GetPDGEncoding())+0.1);
       if ( pdg != 0 && pdg<36 && !(pdg > 10 && pdg < 17) && pdg != 22 )  {
@@ -486,14 +482,17 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   // (3) Compute the particle's parents and daughters.
   //     Replace the original Geant4 track with the
   //     equivalent particle still present in the record.
-  for(iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
-    if ( p->g4Parent > 0 )  {
-      int equiv_id = equivalents[p->g4Parent];
-      if ( (ipar=finalParticles.find(equiv_id)) != finalParticles.end() )  {
-        Particle* q = (*ipar).second;
-        q->daughters.insert(p->id);
-        p->parents.insert(q->id);
+  for(int g4_id=0, n=m_particles.slots(); g4_id<n; ++g4_id)  {
+    Particle* p = m_particles.get(g4_id);
+    if ( p && p->g4Parent > 0 )  {
+      int equiv_id = finalParticles.equivalent(p->g4Parent);
+      // Parents without equivalent are attached to particle 0 as the map based record did
+      if ( equiv_id == Geant4ParticleTable::NO_EQUIVALENT )  {
+        finalParticles.setEquivalent(p->g4Parent, equiv_id = 0);
+      }
+      Particle* q = finalParticles.get(equiv_id);
+      if ( q )  {
+        finalParticles.addRelation(q->id, p->id);
       }
       else   {
         error("+++ Inconsistency in particle record: Geant4 parent %d "
@@ -502,8 +501,8 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
       }
     }
   }
-  m_equivalentTracks = equivalents;
-  m_particleMap = finalParticles;
+  finalParticles.buildRelations();
+  m_particles.swap(finalParticles);
 }
 
 /// Default callback to be answered if the particle should be kept if NO user handler is installed
@@ -535,12 +534,18 @@ bool Geant4ParticleHandler::defaultKeepParticle(Particle& particle)   {
 
 /// Clean the monte carlo record. Remove all unwanted stuff.
 /// This is the core of the object executed at the end of each event action.
-int Geant4ParticleHandler::recombineParents()  {
-  set<int> remove;
+int Geant4ParticleHandler::recombineParents(vector<int>& candidates)  {
+  vector<int> remove, dependents, merged;
+  bool all = candidates.empty();
+  int  num = all ? m_particles.slots() : int(candidates.size());
 
   /// Need to start from BACK, to clean first the latest produced stuff.
-  for(ParticleMap::reverse_iterator i=m_particleMap.rbegin(); i!=m_particleMap.rend(); ++i)  {
-    Particle* p = (*i).second;
+  /// Geant4 creates daughters after their parents: in the first pass all
+  /// masks of removed daughters are merged before the parent is looked at.
+  for(int k=num-1; k >= 0; --k)  {
+    int g4_id = all ? k : candidates[k];
+    Particle* p = m_particles.get(g4_id);
+    if ( !p ) continue;
     PropertyMask mask(p->reason);
     // Allow the user to force the particle handling either by
     // or the reason mask with G4PARTICLE_KEEP_USER or
@@ -572,12 +577,13 @@ int Geant4ParticleHandler::recombineParents()  {
       //continue;
     }
     else if ( mask.isSet(G4PARTICLE_KEEP_PROCESS) )  {
-      ParticleMap::iterator ip = m_particleMap.find(p->g4Parent);
-      if ( ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      Particle* parent_part = m_particles.get(p->g4Parent);
+      if ( parent_part )   {
         PropertyMask parent_mask(parent_part->reason);
         if ( parent_mask.isSet(G4PARTICLE_ABOVE_ENERGY_THRESHOLD) )   {
           parent_mask.set(G4PARTICLE_KEEP_PARENT);
+          // The decision depends on the parent: re-evaluate if the parent gets removed
+          dependents.push_back(g4_id);
           continue;
         }
       }
@@ -587,12 +593,10 @@ int Geant4ParticleHandler::recombineParents()  {
 
     /// Remove this track from the list and also do the cleanup in the parent's children list
     if ( remove_me )  {
-      int g4_id = (*i).first;
-      ParticleMap::iterator ip = m_particleMap.find(p->g4Parent);
-      remove.insert(g4_id);
-      m_equivalentTracks[g4_id] = p->g4Parent;
-      if ( ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      Particle* parent_part = m_particles.get(p->g4Parent);
+      remove.push_back(g4_id);
+      m_particles.setEquivalent(g4_id, p->g4Parent);
+      if ( parent_part )   {
         PropertyMask(parent_part->reason).set(mask.value());
         parent_part->steps += p->steps;
         parent_part->secondaries += p->secondaries;
@@ -600,17 +604,30 @@ int Geant4ParticleHandler::recombineParents()  {
         if ( m_userHandler )  {
           m_userHandler->combine(*p, *parent_part);
         }
+        // The parent was already looked at with the old mask: re-evaluate it
+        if ( !all || p->g4Parent > g4_id )  {
+          merged.push_back(p->g4Parent);
+        }
       }
     }
   }
-  for(set<int>::const_iterator r=remove.begin(); r!=remove.end();++r)  {
-    ParticleMap::iterator ir = m_particleMap.find(*r);
-    if ( ir != m_particleMap.end() )  {
-      (*ir).second->release();
-      m_particleMap.erase(ir);
-    }
+  for(vector<int>::const_iterator r=remove.begin(); r!=remove.end();++r)  {
+    Particle* p = m_particles.remove(*r);
+    if ( p ) p->release();
+  }
+  /// Only particles still present, which depend on a removed parent or
+  /// which inherited the mask of a removed daughter, need another pass
+  candidates.clear();
+  for(vector<int>::const_iterator r=dependents.begin(); r!=dependents.end();++r)  {
+    Particle* p = m_particles.get(*r);
+    if ( p && !m_particles.get(p->g4Parent) ) candidates.push_back(*r);
+  }
+  for(vector<int>::const_iterator r=merged.begin(); r!=merged.end();++r)  {
+    if ( m_particles.get(*r) ) candidates.push_back(*r);
   }
-  return int(remove.size());
+  sort(candidates.begin(), candidates.end());
+  candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+  return int(candidates.size());
 }
 
 /// Check the record consistency
@@ -618,15 +635,16 @@ void Geant4ParticleHandler::checkConsistency()  const   {
   int num_errors = 0;
 
   /// First check the consistency of the particle map itself
-  for(ParticleMap::const_iterator j, i=m_particleMap.begin(); i!=m_particleMap.end(); ++i)  {
-    Geant4ParticleHandle p((*i).second);
+  for(int id=0, n=m_particles.slots(); id<n; ++id)  {
+    if ( !m_particles.get(id) ) continue;
+    Geant4ParticleHandle p(m_particles.get(id));
     PropertyMask mask(p->reason);
     PropertyMask status(p->status);
     set<int>& daughters = p->daughters;
     // For all particles, the set of daughters must be contained in the record.
     for(set<int>::const_iterator id=daughters.begin(); id!=daughters.end(); ++id)   {
       int id_dau = *id;
-      if ( (j=m_particleMap.find(id_dau)) == m_particleMap.end() )   {
+      if ( !m_particles.get(id_dau) )   {
         ++num_errors;
         error("+++ Particle:%d Daughter %d is not in particle map!",p->id,id_dau);
       }
@@ -634,12 +652,10 @@ void Geant4ParticleHandler::checkConsistency()  const   {
     // We assume that particles from the generator have consistent parents
     // For all other particles except the primaries, the parent must be contained in the record.
     if ( !mask.isSet(G4PARTICLE_PRIMARY) && !status.anySet(G4PARTICLE_GEN_STATUS) )  {
-      TrackEquivalents::const_iterator eq_it = m_equivalentTracks.find(p->g4Parent);
+      int  parent_id = m_particles.equivalent(p->g4Parent);
       bool in_map = false, in_parent_list = false;
-      int parent_id = -1;
-      if ( eq_it != m_equivalentTracks.end() )   {
-        parent_id = (*eq_it).second;
-        in_map = (j=m_particleMap.find(parent_id)) != m_particleMap.end();
+      if ( parent_id != Geant4ParticleTable::NO_EQUIVALENT )   {
+        in_map = m_particles.get(parent_id) != 0;
         in_parent_list = p->parents.find(parent_id) != p->parents.end();
       }
       if ( !in_map || !in_parent_list )  {
@@ -662,16 +678,17 @@ void Geant4ParticleHandler::checkConsistency()  const   {
 
 void Geant4ParticleHandler::setVertexEndpointBit() {
 
-  ParticleMap& pm = m_particleMap;
-  ParticleMap::const_iterator iend, i;
-  for(iend=pm.end(), i=pm.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
+  for(int id=0, n=m_particles.slots(); id<n; ++id)  {
+    Particle* p = m_particles.get(id);
 
-    if( p->parents.empty() ) {
+    if( !p || p->parents.empty() ) {
       continue;
     }
 
-    Geant4Particle *parent(pm[ *p->parents.begin() ]);
+    Geant4Particle *parent(m_particles.get(*p->parents.begin()));
+    if( !parent ) {
+      continue;
+    }
     const double X( parent->vex - p->vsx );
     const double Y( parent->vey - p->vsy );
     const double Z( parent->vez - p->vsz );
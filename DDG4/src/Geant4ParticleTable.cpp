@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4ParticleTable.h"
+
+// C/C++ include files
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep::sim;
+
+/// Default constructor
+Geant4ParticleTable::Geant4ParticleTable() : m_size(0), m_numEquivalents(0)  {
+}
+
+/// Insert particle. An existing entry is overwritten
+void Geant4ParticleTable::insert(int id, Particle* p)   {
+  if ( size_t(id) >= m_particles.size() )  {
+    m_particles.resize(id+1, 0);
+  }
+  if ( !m_particles[id] ) ++m_size;
+  m_particles[id] = p;
+}
+
+/// Remove particle from the table without releasing it
+Geant4ParticleTable::Particle* Geant4ParticleTable::remove(int id)   {
+  Particle* p = get(id);
+  if ( p )  {
+    m_particles[id] = 0;
+    --m_size;
+  }
+  return p;
+}
+
+/// Set the equivalent of a track
+void Geant4ParticleTable::setEquivalent(int g4_id, int equiv)   {
+  if ( size_t(g4_id) >= m_equivalents.size() )  {
+    m_equivalents.resize(g4_id+1, int(NO_EQUIVALENT));
+  }
+  if ( m_equivalents[g4_id] == NO_EQUIVALENT ) ++m_numEquivalents;
+  m_equivalents[g4_id] = equiv;
+}
+
+/// Follow the track equivalents until a particle in the table is found. Returns NULL if none
+Geant4ParticleTable::Particle* Geant4ParticleTable::equivalentParticle(int g4_id, int* last_id) const   {
+  for(int id = g4_id; ; )  {
+    Particle* p = get(id);
+    int next = p ? id : equivalent(id);
+    // Particle found, unknown track or track pointing to itself without particle: end of chain
+    if ( p || next == NO_EQUIVALENT || next == id )  {
+      if ( last_id ) *last_id = id;
+      return p;
+    }
+    id = next;
+  }
+}
+
+/// Sort the registered relations into index ranges and update the particle's parents and daughters
+void Geant4ParticleTable::buildRelations()   {
+  size_t num_slots = m_particles.size();
+  // Counting sort of the links by parent: daughters of particle i
+  // end up in m_daughters[m_firstDaughter[i] ... m_firstDaughter[i+1])
+  m_firstDaughter.assign(num_slots+1, 0);
+  for(const auto& l : m_links)  {
+    if ( size_t(l.first) < num_slots ) ++m_firstDaughter[l.first+1];
+  }
+  for(size_t i=0; i<num_slots; ++i)
+    m_firstDaughter[i+1] += m_firstDaughter[i];
+  m_daughters.resize(m_firstDaughter[num_slots]);
+  vector<int> fill(m_firstDaughter.begin(), m_firstDaughter.end()-1);
+  for(const auto& l : m_links)  {
+    if ( size_t(l.first) < num_slots ) m_daughters[fill[l.first]++] = l.second;
+  }
+  // Now update the particles. The ranges are ordered, hence the
+  // insertion into the sets is done at the end in constant time.
+  for(size_t i=0; i<num_slots; ++i)  {
+    Particle* q = m_particles[i];
+    int first = m_firstDaughter[i], last = m_firstDaughter[i+1];
+    if ( !q || first == last ) continue;
+    sort(m_daughters.begin()+first, m_daughters.begin()+last);
+    for(int k=first; k<last; ++k)  {
+      int id_dau = m_daughters[k];
+      q->daughters.insert(q->daughters.end(), id_dau);
+      if ( Particle* p = get(id_dau) )  {
+        p->parents.insert(p->parents.end(), int(i));
+      }
+    }
+  }
+  m_links.clear();
+}
+
+/// Release all particles and remove them from the table
+void Geant4ParticleTable::releaseParticles()   {
+  for(Particle*& p : m_particles)  {
+    if ( p ) p->release();
+    p = 0;
+  }
+  m_size = 0;
+}
+
+/// Clear the table without releasing the particles. Allocated memory is kept
+void Geant4ParticleTable::clear()   {
+  m_particles.clear();
+  m_equivalents.clear();
+  m_links.clear();
+  m_firstDaughter.clear();
+  m_daughters.clear();
+  m_size = 0;
+  m_numEquivalents = 0;
+}
+
+/// Exchange the content with another table
+void Geant4ParticleTable::swap(Geant4ParticleTable& other)   {
+  m_particles.swap(other.m_particles);
+  m_equivalents.swap(other.m_equivalents);
+  m_links.swap(other.m_links);
+  m_firstDaughter.swap(other.m_firstDaughter);
+  m_daughters.swap(other.m_daughters);
+  std::swap(m_size, other.m_size);
+  std::swap(m_numEquivalents, other.m_numEquivalents);
+}
+
+/// Move the content to the maps of the final record. The table is cleared
+void Geant4ParticleTable::exportTo(ParticleMap& particles, TrackEquivalents& equivalents)   {
+  // Identifiers are visited in ascending order: append at the end of the maps
+  for(size_t i=0; i<m_particles.size(); ++i)  {
+    if ( m_particles[i] ) particles.insert(particles.end(), make_pair(int(i), m_particles[i]));
+  }
+  for(size_t i=0; i<m_equivalents.size(); ++i)  {
+    if ( m_equivalents[i] != NO_EQUIVALENT ) equivalents.insert(equivalents.end(), make_pair(int(i), m_equivalents[i]));
+  }
+  clear();
+}
@@ -121,6 +121,17 @@ Geant4PrimaryEvent::Interaction* Geant4PrimaryEvent::get(int mask) const   {
   return 0;
 }
 
+/// Remove an interaction from the event and pass ownership to the caller
+Geant4PrimaryEvent::Interaction* Geant4PrimaryEvent::release(int mask)   {
+  Interactions::iterator i = m_interactions.find(mask);
+  if ( i != m_interactions.end() )  {
+    Interaction* interaction = (*i).second;
+    m_interactions.erase(i);
+    return interaction;
+  }
+  return 0;
+}
+
 /// Retrieve all intractions
 std::vector<Geant4PrimaryEvent::Interaction*> Geant4PrimaryEvent::interactions() const   {
   std::vector<Interaction*> v;
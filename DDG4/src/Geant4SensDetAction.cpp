@@ -17,6 +17,7 @@
 #include "DD4hep/InstanceCount.h"
 #include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4Mapping.h"
+#include "DDG4/Geant4RunAction.h"
 #include "DDG4/Geant4SensDetAction.h"
 #include "DDG4/Geant4StepHandler.h"
 #include "DDG4/Geant4VolumeManager.h"
@@ -24,6 +25,7 @@
 
 // Geant4 include files
 #include <G4Step.hh>
+#include <G4VTouchable.hh>
 #include <G4SDManager.hh>
 #include <G4VSensitiveDetector.hh>
 
@@ -94,6 +96,8 @@ Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElem
     throw runtime_error(format("Geant4Sensitive", "DDG4: Detector elemnt for %s is invalid.", nam.c_str()));
   }
   declareProperty("HitCreationMode", m_hitCreationMode = SIMPLE_MODE);
+  declareProperty("UseTouchableCache", m_useTouchableCache = false);
+  declareProperty("CollectionCapacity", m_collectionCapacity = 0);
   m_sequence  = context()->kernel().sensitiveAction(m_detector.name());
   m_sensitive = description_ref.sensitiveDetector(det.name());
   m_readout   = m_sensitive.readout();
@@ -102,6 +106,11 @@ Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElem
 
 /// Standard destructor
 Geant4Sensitive::~Geant4Sensitive() {
+  if ( m_endRunRegistered )  {
+    // The run action sequence may already be gone: do not create it again
+    Geant4RunActionSequence* seq = context()->kernel().runAction(false);
+    if ( seq ) seq->removeCallbacks(this);
+  }
   m_filters(&Geant4Filter::release);
   m_filters.clear();
   InstanceCount::decrement(this);
@@ -213,19 +222,94 @@ void Geant4Sensitive::mark(const G4Step* step) const  {
   if ( truth ) truth->mark(step);
 }
 
+/// Check if the touchable matches the cached entry
+bool Geant4Sensitive::TouchableCache::match(const G4VTouchable* touchable)  const  {
+  if ( depth != touchable->GetHistoryDepth() )
+    return false;
+  for( int i = 0; i < depth; ++i )  {
+    if ( volumes[i] != touchable->GetVolume(i) || replicas[i] != touchable->GetReplicaNumber(i) )
+      return false;
+  }
+  return true;
+}
+
+/// Update the cache with a new touchable
+void Geant4Sensitive::TouchableCache::set(const G4VTouchable* touchable, VolumeID vid)  {
+  int n = touchable->GetHistoryDepth();
+  if ( n > int(MAX_DEPTH) )  {
+    depth = -1;
+    return;
+  }
+  for( int i = 0; i < n; ++i )  {
+    volumes[i]  = touchable->GetVolume(i);
+    replicas[i] = touchable->GetReplicaNumber(i);
+  }
+  depth    = n;
+  volumeID = vid;
+}
+
+/// Callback at the end of the run: print the touchable cache statistics
+void Geant4Sensitive::endRun(const G4Run* /* run */)  {
+  if ( m_useTouchableCache )   {
+    unsigned long total = m_touchableCache.hits + m_touchableCache.misses;
+    info("+++ Touchable cache: %lu lookups %lu hits %lu misses. Hit rate: %.1f %%",
+         total, m_touchableCache.hits, m_touchableCache.misses,
+         total ? 100e0*double(m_touchableCache.hits)/double(total) : 0e0);
+  }
+  for( const auto& s : m_keyStatistics )   {
+    const Geant4HitCollection::Keys::Statistics& k = s.second;
+    if ( k.lookups > 0 )   {
+      print("+++ Hit key index of %s: %ld lookups Peak size:%ld Mean probe length:%.2f "
+            "Max.probe length:%ld Rehashes:%ld", s.first.c_str(),
+            k.lookups, k.peakSize, double(k.probes)/double(k.lookups), k.maxProbe, k.rehashes);
+    }
+  }
+}
+
+/// Register the end-of-run callback printing the statistics if not yet done
+void Geant4Sensitive::registerEndRun()  {
+  if ( !m_endRunRegistered )  {
+    // Properties are set after construction: register the statistics printout on first use
+    runAction().callAtEnd(this, &Geant4Sensitive::endRun);
+    m_endRunRegistered = true;
+  }
+}
+
+/// Accumulate the hit key index statistics of a collection at the end of the event
+void Geant4Sensitive::addKeyStatistics(const string& collection, const Geant4HitCollection::Keys::Statistics& stat)  {
+  registerEndRun();
+  m_keyStatistics[collection].add(stat);
+}
+
+/// Returns the volumeID of the touchable. Uses the touchable cache if enabled
+VolumeID Geant4Sensitive::volumeID(const G4VTouchable* touchable)  {
+  if ( m_useTouchableCache )  {
+    registerEndRun();
+    if ( m_touchableCache.match(touchable) )  {
+      ++m_touchableCache.hits;
+      return m_touchableCache.volumeID;
+    }
+    ++m_touchableCache.misses;
+  }
+  Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
+  VolumeID id = volMgr.volumeID(touchable);
+  if ( m_useTouchableCache )  {
+    m_touchableCache.set(touchable, id);
+  }
+  return id;
+}
+
 /// Returns the volumeID of the sensitive volume corresponding to the step
 long long int Geant4Sensitive::volumeID(const G4Step* s) {
   Geant4StepHandler step(s);
-  Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID id = volMgr.volumeID(step.preTouchable());
+  VolumeID id = volumeID(step.preTouchable());
   return id;
 }
 
 /// Returns the cellID(volumeID+local coordinate encoding) of the sensitive volume corresponding to the step
 long long int Geant4Sensitive::cellID(const G4Step* s) {
   Geant4StepHandler h(s);
-  Geant4VolumeManager volMgr = Geant4Mapping::instance().volumeManager();
-  VolumeID volID = volMgr.volumeID(h.preTouchable());
+  VolumeID volID = volumeID(h.preTouchable());
   if ( m_segmentation.isValid() )  {
     G4ThreeVector global = 0.5 * ( h.prePosG4()+h.postPosG4());
     G4ThreeVector local  = h.preTouchable()->GetHistory()->GetTopTransform().TransformPoint(global);
@@ -370,6 +454,9 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
   for (size_t count = 0; count < m_collections.size(); ++count) {
     const HitCollection& cr = m_collections[count];
     Geant4HitCollection* c = (*cr.second.second)(name(), cr.first, cr.second.first);
+    Geant4Sensitive* owner = cr.second.first;
+    if ( owner && owner->collectionCapacity() > 0 )
+      c->reserve(owner->collectionCapacity());
     int id = m_detector->GetCollectionID(count);
     m_hce->AddHitsCollection(id, c);
   }
@@ -381,6 +468,14 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
 void Geant4SensDetActionSequence::end(G4HCofThisEvent* hce) {
   m_end(hce);
   m_actors(&Geant4Sensitive::end, hce);
+  // Collect the key index statistics for tuning the collection capacity
+  for (size_t count = 0; count < m_collections.size(); ++count) {
+    const HitCollection& cr = m_collections[count];
+    Geant4Sensitive* owner = cr.second.first;
+    G4VHitsCollection*   hc = hce ? hce->GetHC(m_detector->GetCollectionID(count)) : 0;
+    Geant4HitCollection* c  = dynamic_cast<Geant4HitCollection*>(hc);
+    if ( owner && c ) owner->addKeyStatistics(cr.first, c->keys().statistics());
+  }
   // G4HCofThisEvent must be availible until end-event. m_hce = 0;
 }
 
@@ -0,0 +1,76 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4ThreadPool.h"
+
+using namespace std;
+using namespace dd4hep::sim;
+
+/// Initializing constructor. Starts the threads
+Geant4ThreadPool::Geant4ThreadPool(size_t num_threads)   {
+  m_threads.reserve(num_threads);
+  for(size_t i=0; i<num_threads; ++i)
+    m_threads.emplace_back(&Geant4ThreadPool::worker, this);
+}
+
+/// Default destructor. Stops and joins the threads
+Geant4ThreadPool::~Geant4ThreadPool()   {
+  {
+    lock_guard<mutex> lock(m_lock);
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for(auto& t : m_threads) t.join();
+}
+
+/// Take the next chunk and process it. Called with m_lock held
+bool Geant4ThreadPool::processChunk(unique_lock<mutex>& lock)   {
+  if ( !m_work || m_nextChunk >= m_numChunks )  {
+    return false;
+  }
+  const Work* work = m_work;
+  size_t chunk = m_nextChunk++;
+  lock.unlock();
+  (*work)(chunk);
+  lock.lock();
+  if ( --m_pending == 0 )  {
+    m_done.notify_all();
+  }
+  return true;
+}
+
+/// Thread body
+void Geant4ThreadPool::worker()   {
+  unique_lock<mutex> lock(m_lock);
+  while( !m_stop )  {
+    if ( !processChunk(lock) )  {
+      m_start.wait(lock);
+    }
+  }
+}
+
+/// Process num_chunks chunks of work. Returns when all chunks are finished
+void Geant4ThreadPool::run(size_t num_chunks, const Work& work)   {
+  lock_guard<mutex> run_lock(m_runLock);
+  unique_lock<mutex> lock(m_lock);
+  m_work      = &work;
+  m_numChunks = num_chunks;
+  m_nextChunk = 0;
+  m_pending   = num_chunks;
+  if ( num_chunks > 1 )  {
+    m_start.notify_all();
+  }
+  while( processChunk(lock) )  {
+  }
+  m_done.wait(lock, [this] { return m_pending == 0; });
+  m_work = 0;
+}
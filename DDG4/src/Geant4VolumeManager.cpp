@@ -190,6 +190,7 @@ Geant4VolumeManager::Geant4VolumeManager(Detector& description, Geant4GeometryIn
   if (info && info->valid && info->g4Paths.empty()) {
     Populator p(description, *info);
     p.populate(description.world());
+    info->g4PathIndex.build(info->g4Paths);
     return;
   }
   throw runtime_error(format("Geant4VolumeManager", "Attempt populate from invalid Geant4 geometry info [Invalid-Info]"));
@@ -220,6 +221,9 @@ bool Geant4VolumeManager::checkValidity() const {
 /// Access CELLID by placement path
 VolumeID Geant4VolumeManager::volumeID(const vector<const G4VPhysicalVolume*>& path) const {
   if (!path.empty() && checkValidity()) {
+    VolumeID vid = NonExisting;
+    if ( ptr()->g4PathIndex.find(path, vid) )
+      return vid;
     const auto& m = ptr()->g4Paths;
     auto i = m.find(path);
     if (i != m.end())
@@ -236,6 +240,10 @@ VolumeID Geant4VolumeManager::volumeID(const vector<const G4VPhysicalVolume*>& p
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const {
+  VolumeID vid = NonExisting;
+  /// Fast path: hash lookup directly on the touchable history without building the path
+  if ( checkValidity() && ptr()->g4PathIndex.find(touchable, vid) )
+    return vid;
   Geant4TouchableHandler handler(touchable);
   return volumeID(handler.placementPath());
 }
@@ -0,0 +1,114 @@
+#ifndef rec_CellIDNavigationCache_H_
+#define rec_CellIDNavigationCache_H_
+
+#include "DD4hep/Detector.h"
+#include "DD4hep/Segmentations.h"
+#include "DD4hep/MatrixHelpers.h"
+#include "DD4hep/VolumeManager.h"
+
+#include <vector>
+
+class TGeoShape ;
+
+namespace dd4hep {
+  namespace rec {
+
+    typedef DDSegmentation::CellID CellID;
+
+    /** Navigation cache for fast global position to cellID lookups.
+     *
+     *  All sensitive placements known to the VolumeManager are stored together with
+     *  their precomputed VolumeID, the compact volume-to-world transformation and
+     *  their bounding box in world coordinates. A uniform voxel grid over the
+     *  sensitive placements selects the candidates for a given point, hence neither
+     *  TGeoManager::FindNode nor the string based path reconstruction are needed.
+     *
+     *  The cache is immutable once built: it may be shared between threads.
+     *  It reflects the nominal geometry at construction time.
+     */
+    class CellIDNavigationCache {
+
+    public:
+
+      /// One sensitive placement with everything needed to compute the cellID
+      struct Entry {
+	/// Volume ID of the placement
+	VolumeID         volumeID{} ;
+	/// Nominal volume -> world transformation
+	detail::matrix::Affine3x4 toWorld{} ;
+	/// Bounding box in world coordinates: xmin, ymin, zmin, xmax, ymax, zmax
+	double           box[6]{} ;
+	/// The solid of the placed volume
+	const TGeoShape* solid = 0 ;
+	/// The placed volume: points inside its daughters do not belong to the entry
+	const TGeoVolume* volume = 0 ;
+	/// The segmentation of the readout
+	Segmentation     segmentation{} ;
+      };
+
+      /// The constructor - takes the main description object.
+      CellIDNavigationCache( Detector& description ) ;
+
+      /// No default constructor
+      CellIDNavigationCache() = delete ;
+
+      /// No copy constructor
+      CellIDNavigationCache(const CellIDNavigationCache& copy) = delete ;
+
+      /// Default destructor
+      ~CellIDNavigationCache() = default ;
+
+      /// No assignment operator
+      CellIDNavigationCache& operator=(const CellIDNavigationCache& copy) = delete ;
+
+      /** Find the sensitive placement containing the global point.
+       *  Returns NULL if no sensitive placement is found. Like TGeoManager::FindNode
+       *  a point inside a daughter of the sensitive volume does not belong to it.
+       *  On success the local coordinates of the point are filled.
+       */
+      const Entry* findEntry( const Position& global, double local[3] ) const ;
+
+      /** Return the cellID for the given global position.
+       *  Returns 0 if no sensitive placement contains the point.
+       */
+      CellID cellID( const Position& global ) const ;
+
+      /// Number of cached sensitive placements
+      std::size_t size() const { return _entries.size() ; }
+
+      /** True if all sensitive placements of the volume manager are cached.
+       *  Then a point not found in the cache is in no sensitive placement and
+       *  no further search is needed.
+       */
+      bool isComplete() const { return _complete ; }
+
+      /// Number of voxels along x, y and z
+      const int* gridSize() const { return _nbins ; }
+
+    protected:
+
+      /// Fill the entries from the volume manager
+      void fillEntries( const VolumeManager& mgr ) ;
+
+      /// Build the voxel grid over the entries
+      void buildGrid() ;
+
+      /// Voxel index along one axis; -1 if outside the grid
+      int bin( int axis, double x ) const ;
+
+      std::vector<Entry>        _entries{} ;
+      /// Flag if no sensitive placement was skipped while filling the entries
+      bool                      _complete = true ;
+      /// Voxel grid: candidates of voxel i are _candidates[ _offsets[i] ... _offsets[i+1] )
+      std::vector<unsigned>     _offsets{} ;
+      std::vector<unsigned>     _candidates{} ;
+      /// Grid origin, inverse voxel size and number of voxels per axis
+      double                    _origin[3]{} ;
+      double                    _invStep[3]{} ;
+      int                       _nbins[3]{} ;
+    };
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // rec_CellIDNavigationCache_H_
@@ -7,13 +7,17 @@
 
 #include "DDSegmentation/Segmentation.h"
 
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace dd4hep {
   namespace rec {
 
+    class CellIDNavigationCache ;
+
     typedef DDSegmentation::CellID CellID;
     typedef DDSegmentation::VolumeID VolumeID;
 
@@ -52,13 +56,44 @@ namespace dd4hep {
        */
       Position position(const CellID& cellID) const;
 
+      /** Return the nominal global positions for an array of cellIDs of sensitive volumes.
+       *  Equivalent to calling positionNominal() for every cellID: the cells are grouped
+       *  by their volume context, the readout and the composed volume-to-world
+       *  transformation are looked up once per group and applied to all cells of the
+       *  group in one tight loop. The output array must hold at least count entries.
+       */
+      void positionsNominal(const CellID* cellIDs, std::size_t count, Position* positions) const;
+
+      /** Return the nominal global positions for a vector of cellIDs of sensitive volumes.
+       *  The output vector is resized to the number of cellIDs.
+       */
+      void positionsNominal(const std::vector<CellID>& cellIDs, std::vector<Position>& positions) const;
+
 
       /** Return the global cellID for the given global position.
        *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  If a navigation cache is set, it is queried first. The slow
+       *  TGeoManager based search is only used if the cache has no answer
+       *  and does not hold all sensitive placements.
        */
       CellID cellID(const Position& global) const;
 
+      /** Set the (shareable, thread-safe) navigation cache used for fast
+       *  global position to cellID lookups. Pass an empty pointer to disable it.
+       */
+      void setNavigationCache( std::shared_ptr<const CellIDNavigationCache> cache ) ;
+
+      /// Access the navigation cache - may be empty
+      std::shared_ptr<const CellIDNavigationCache> navigationCache() const { return _navigationCache ; }
+
+      /** Use the transformations cached by the volume manager contexts for the
+       *  nominal positions. By default the transformations are computed per call.
+       */
+      void setUseTransformationCache( bool value ) { _useTransformationCache = value ; }
+
+      /// Access the flag to use the cached volume manager context transformations
+      bool useTransformationCache() const { return _useTransformationCache ; }
+
 
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
@@ -104,6 +139,8 @@ namespace dd4hep {
     protected:
       VolumeManager _volumeManager{} ;
       const Detector* _description ;
+      std::shared_ptr<const CellIDNavigationCache> _navigationCache{} ;
+      bool _useTransformationCache = false ;
 
     };
 
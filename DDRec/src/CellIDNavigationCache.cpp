@@ -0,0 +1,235 @@
+#include "DDRec/CellIDNavigationCache.h"
+
+#include "DD4hep/Printout.h"
+#include "DD4hep/detail/VolumeManagerInterna.h"
+
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dd4hep {
+
+  using namespace detail ;
+
+  namespace rec {
+
+    namespace {
+      /// Maximal number of voxels along one axis
+      const int    MAX_BINS_PER_AXIS  = 256 ;
+      /// Average number of candidates per voxel we aim for
+      const double CANDIDATES_PER_BIN = 0.25 ;
+
+      /// True if the point given in the frame of the volume is inside one of its daughters
+      bool insideDaughter( const TGeoVolume* vol, const double* local ){
+	for( int i = 0, n = vol->GetNdaughters() ; i < n ; ++i ){
+	  const TGeoNode* dau = vol->GetNode( i ) ;
+	  double d[3] ;
+	  dau->MasterToLocal( local, d ) ;
+	  if( dau->GetVolume()->GetShape()->Contains( d ) )
+	    return true ;
+	}
+	return false ;
+      }
+    }
+
+    CellIDNavigationCache::CellIDNavigationCache( Detector& description ){
+
+      VolumeManager mgr = VolumeManager::getVolumeManager( description ) ;
+
+      fillEntries( mgr ) ;
+
+      buildGrid() ;
+
+      printout( INFO, "CellIDNavigationCache", "+++ Cached %ld sensitive placements in %d x %d x %d voxels [%ld references]%s.",
+		_entries.size(), _nbins[0], _nbins[1], _nbins[2], _candidates.size(),
+		_complete ? "" : " Some placements are not cached: misses are searched with TGeo" ) ;
+    }
+
+
+    void CellIDNavigationCache::fillEntries( const VolumeManager& mgr ){
+
+      const VolumeManagerObject& o = *mgr.ptr() ;
+
+      std::vector<const VolumeManagerObject*> objects ;
+      objects.push_back( &o ) ;
+      for( const auto& sub : o.subdetectors )
+	objects.push_back( sub.second.ptr() ) ;
+
+      for( const auto* obj : objects ){
+	for( const auto& v : obj->volumes ){
+
+	  const VolumeManagerContext* context = v.second ;
+	  PlacedVolume pv = context->volumePlacement() ;
+
+	  if( ! pv.isValid() || ! pv.volume().isSensitive() )
+	    continue ;
+
+	  SensitiveDetector sd = pv.volume().sensitiveDetector() ;
+	  if( ! sd.isValid() || ! sd.readout().isValid() ){
+	    _complete = false ;
+	    continue ;
+	  }
+
+	  const TGeoBBox* bbox = dynamic_cast<const TGeoBBox*>( pv.volume().solid().ptr() ) ;
+	  if( bbox == 0 ){
+	    _complete = false ;
+	    continue ;
+	  }
+
+	  Entry e ;
+	  e.volumeID     = context->identifier ;
+	  e.toWorld      = context->toWorld() ;
+	  e.solid        = bbox ;
+	  e.volume       = pv.volume().ptr() ;
+	  e.segmentation = sd.readout().segmentation() ;
+
+	  // world bounding box from the 8 corners of the local bounding box
+	  const double* org = bbox->GetOrigin() ;
+	  const double  d[3] = { bbox->GetDX(), bbox->GetDY(), bbox->GetDZ() } ;
+	  for( int i = 0 ; i < 3 ; ++i ){
+	    e.box[i]   =  HUGE_VAL ;
+	    e.box[i+3] = -HUGE_VAL ;
+	  }
+	  for( int c = 0 ; c < 8 ; ++c ){
+	    double l[3], g[3] ;
+	    l[0] = org[0] + ( (c&1) ? d[0] : -d[0] ) ;
+	    l[1] = org[1] + ( (c&2) ? d[1] : -d[1] ) ;
+	    l[2] = org[2] + ( (c&4) ? d[2] : -d[2] ) ;
+	    e.toWorld.localToMaster( l, g ) ;
+	    for( int i = 0 ; i < 3 ; ++i ){
+	      e.box[i]   = std::min( e.box[i],   g[i] ) ;
+	      e.box[i+3] = std::max( e.box[i+3], g[i] ) ;
+	    }
+	  }
+	  _entries.push_back( e ) ;
+	}
+      }
+    }
+
+
+    void CellIDNavigationCache::buildGrid(){
+
+      double lo[3] = {  HUGE_VAL,  HUGE_VAL,  HUGE_VAL } ;
+      double hi[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL } ;
+
+      for( const auto& e : _entries ){
+	for( int i = 0 ; i < 3 ; ++i ){
+	  lo[i] = std::min( lo[i], e.box[i] ) ;
+	  hi[i] = std::max( hi[i], e.box[i+3] ) ;
+	}
+      }
+
+      if( _entries.empty() ){
+	for( int i = 0 ; i < 3 ; ++i ){
+	  _origin[i] = 0. ; _invStep[i] = 0. ; _nbins[i] = 1 ;
+	}
+	_offsets.assign( 2, 0 ) ;
+	return ;
+      }
+
+      // voxel size such that the grid holds about CANDIDATES_PER_BIN entries per voxel
+      double volume = 1. ;
+      for( int i = 0 ; i < 3 ; ++i )
+	volume *= std::max( hi[i] - lo[i], 1e-6 ) ;
+      double step = std::cbrt( volume * CANDIDATES_PER_BIN / double( _entries.size() ) ) ;
+
+      std::size_t nTotal = 1 ;
+      for( int i = 0 ; i < 3 ; ++i ){
+	double extent = std::max( hi[i] - lo[i], 1e-6 ) ;
+	_nbins[i]   = std::max( 1, std::min( MAX_BINS_PER_AXIS, int( std::ceil( extent / step ) ) ) ) ;
+	_origin[i]  = lo[i] ;
+	_invStep[i] = double( _nbins[i] ) / extent ;
+	nTotal *= _nbins[i] ;
+      }
+
+      // two passes: count the references per voxel, then fill them (CSR layout)
+      std::vector<unsigned> counts( nTotal + 1, 0 ) ;
+      for( int pass = 0 ; pass < 2 ; ++pass ){
+
+	if( pass == 1 ){
+	  _offsets.assign( nTotal + 1, 0 ) ;
+	  for( std::size_t i = 0 ; i < nTotal ; ++i )
+	    _offsets[i+1] = _offsets[i] + counts[i] ;
+	  _candidates.assign( _offsets[nTotal], 0 ) ;
+	  std::copy( _offsets.begin(), _offsets.end() - 1, counts.begin() ) ;
+	}
+
+	for( unsigned n = 0 ; n < _entries.size() ; ++n ){
+	  const Entry& e = _entries[n] ;
+	  int b0[3], b1[3] ;
+	  for( int i = 0 ; i < 3 ; ++i ){
+	    b0[i] = std::max( 0, std::min( _nbins[i] - 1, int( ( e.box[i]   - _origin[i] ) * _invStep[i] ) ) ) ;
+	    b1[i] = std::max( 0, std::min( _nbins[i] - 1, int( ( e.box[i+3] - _origin[i] ) * _invStep[i] ) ) ) ;
+	  }
+	  for( int ix = b0[0] ; ix <= b1[0] ; ++ix ){
+	    for( int iy = b0[1] ; iy <= b1[1] ; ++iy ){
+	      for( int iz = b0[2] ; iz <= b1[2] ; ++iz ){
+		std::size_t voxel = ( std::size_t( ix ) * _nbins[1] + iy ) * _nbins[2] + iz ;
+		if( pass == 0 )
+		  ++counts[voxel] ;
+		else
+		  _candidates[ counts[voxel]++ ] = n ;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+
+
+    int CellIDNavigationCache::bin( int axis, double x ) const {
+      double f = ( x - _origin[axis] ) * _invStep[axis] ;
+      if( f < 0. || f >= double( _nbins[axis] ) )
+	return -1 ;
+      return int( f ) ;
+    }
+
+
+    const CellIDNavigationCache::Entry*
+    CellIDNavigationCache::findEntry( const Position& global, double local[3] ) const {
+
+      double g[3] ;
+      global.GetCoordinates( g ) ;
+
+      int ix = bin( 0, g[0] ), iy = bin( 1, g[1] ), iz = bin( 2, g[2] ) ;
+      if( ix < 0 || iy < 0 || iz < 0 )
+	return 0 ;
+
+      std::size_t voxel = ( std::size_t( ix ) * _nbins[1] + iy ) * _nbins[2] + iz ;
+
+      for( unsigned k = _offsets[voxel], kend = _offsets[voxel+1] ; k < kend ; ++k ){
+
+	const Entry& e = _entries[ _candidates[k] ] ;
+
+	if( g[0] < e.box[0] || g[0] > e.box[3] ||
+	    g[1] < e.box[1] || g[1] > e.box[4] ||
+	    g[2] < e.box[2] || g[2] > e.box[5] )
+	  continue ;
+
+	e.toWorld.masterToLocal( g, local ) ;
+
+	// the deepest node containing the point must be the sensitive volume itself.
+	// Sensitive daughters have their own entries, non-sensitive ones no cellID
+	if( e.solid->Contains( local ) && ! insideDaughter( e.volume, local ) )
+	  return &e ;
+      }
+      return 0 ;
+    }
+
+
+    CellID CellIDNavigationCache::cellID( const Position& global ) const {
+
+      double l[3] ;
+      const Entry* e = findEntry( global, l ) ;
+
+      if( e == 0 )
+	return 0 ;
+
+      return e->segmentation.cellID( Position( l[0], l[1], l[2] ), global, e->volumeID ) ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
@@ -1,11 +1,15 @@
 
 #include "DDRec/CellIDPositionConverter.h"
+#include "DDRec/CellIDNavigationCache.h"
 
 #include "DD4hep/Detector.h"
 #include "DD4hep/detail/VolumeManagerInterna.h"
 
 #include "TGeoManager.h"
 
+#include <algorithm>
+#include <map>
+
 namespace dd4hep {
   namespace rec {
 
@@ -59,11 +63,16 @@ namespace dd4hep {
       
       local.GetCoordinates(l);
 
-      const TGeoMatrix& volToElement = context->toElement();
-      volToElement.LocalToMaster(l, e);
+      // composition of volToElement and elementToGlobal
+      if( _useTransformationCache ) {
+	context->cachedWorld().localToMaster(l, g);
+      } else {
+	const TGeoMatrix& volToElement = context->toElement();
+	volToElement.LocalToMaster(l, e);
 
-      const TGeoMatrix& elementToGlobal = det.nominal().worldTransformation();
-      elementToGlobal.LocalToMaster(e, g);
+	const TGeoMatrix& elementToGlobal = det.nominal().worldTransformation();
+	elementToGlobal.LocalToMaster(e, g);
+      }
 
 
       return Position(g[0], g[1], g[2]);
@@ -72,9 +81,99 @@ namespace dd4hep {
 
 
 
+    void CellIDPositionConverter::positionsNominal(const std::vector<CellID>& cells,
+						   std::vector<Position>& positions) const {
+      positions.resize( cells.size() ) ;
+      positionsNominal( cells.data(), cells.size(), positions.data() ) ;
+    }
+
+    void CellIDPositionConverter::positionsNominal(const CellID* cells, std::size_t count,
+						   Position* positions) const {
+      if( count == 0 )
+	return ;
+
+      // look up all contexts first and group the cells by context
+      std::vector<const VolumeManagerContext*> contexts( count ) ;
+      std::vector<std::size_t> order( count ) ;
+      for( std::size_t i = 0 ; i < count ; ++i ){
+	contexts[i] = findContext( cells[i] ) ;
+	order[i] = i ;
+      }
+      std::stable_sort( order.begin(), order.end(),
+			[&contexts]( std::size_t a, std::size_t b ){ return contexts[a] < contexts[b] ; } ) ;
+
+      // structure-of-arrays buffers for the local and global coordinates
+      std::vector<double> lx( count ), ly( count ), lz( count ) ;
+      std::vector<double> gx( count ), gy( count ), gz( count ) ;
+
+      // the readout search is recursive - do it once per DetElement
+      std::map<const void*, Segmentation> segmentations ;
+
+      for( std::size_t begin = 0, end = 0 ; begin < count ; begin = end ){
+
+	const VolumeManagerContext* context = contexts[ order[begin] ] ;
+	for( end = begin + 1 ; end < count && contexts[ order[end] ] == context ; ++end ) {}
+
+	if( context == NULL ){
+	  for( std::size_t k = begin ; k < end ; ++k )
+	    positions[ order[k] ] = Position() ;
+	  continue ;
+	}
+
+	DetElement det = context->element ;
+	auto iseg = segmentations.find( det.ptr() ) ;
+	if( iseg == segmentations.end() )
+	  iseg = segmentations.insert( std::make_pair( det.ptr(), findReadout( det ).segmentation() ) ).first ;
+	Segmentation seg = iseg->second ;
+
+	// composed volume -> world transformation of this context
+	const detail::matrix::Affine3x4 toWorld = _useTransformationCache ? context->cachedWorld() : context->toWorld() ;
+	const double* a = toWorld.m ;
+
+	for( std::size_t k = begin ; k < end ; ++k ){
+	  Position local = seg.position( cells[ order[k] ] ) ;
+	  lx[k] = local.X() ;
+	  ly[k] = local.Y() ;
+	  lz[k] = local.Z() ;
+	}
+
+	// plain affine transformation of all cells of the group: vectorizable
+	const double r0 = a[0], r1 = a[1], r2 = a[2],  t0 = a[3] ;
+	const double r3 = a[4], r4 = a[5], r5 = a[6],  t1 = a[7] ;
+	const double r6 = a[8], r7 = a[9], r8 = a[10], t2 = a[11] ;
+	const double* x = lx.data() ;
+	const double* y = ly.data() ;
+	const double* z = lz.data() ;
+	double* ox = gx.data() ;
+	double* oy = gy.data() ;
+	double* oz = gz.data() ;
+	for( std::size_t k = begin ; k < end ; ++k ){
+	  ox[k] = t0 + r0*x[k] + r1*y[k] + r2*z[k] ;
+	  oy[k] = t1 + r3*x[k] + r4*y[k] + r5*z[k] ;
+	  oz[k] = t2 + r6*x[k] + r7*y[k] + r8*z[k] ;
+	}
+
+	for( std::size_t k = begin ; k < end ; ++k )
+	  positions[ order[k] ] = Position( gx[k], gy[k], gz[k] ) ;
+      }
+    }
+
+
+    void CellIDPositionConverter::setNavigationCache( std::shared_ptr<const CellIDNavigationCache> cache ){
+      _navigationCache = cache ;
+    }
+
+
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
       CellID result(0) ;
+
+      if( _navigationCache ){
+	result = _navigationCache->cellID( global ) ;
+	// a miss of a complete cache is final: no sensitive placement contains the point
+	if( result != 0 || _navigationCache->isComplete() )
+	  return result ;
+      }
       
       TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
       
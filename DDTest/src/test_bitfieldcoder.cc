@@ -3,6 +3,8 @@
 #include <iostream>
 #include <assert.h>
 #include <cmath>
+#include <chrono>
+#include <vector>
 
 #include "DDSegmentation/BitFieldCoder.h"
 
@@ -66,6 +68,94 @@ int main(int /* argc */, char** /* argv */ ){
     test( bf2.get( field, bf2.index( "y")),    -16710 , " acces field value: y" );
 
 
+    // precompiled accessors must give the same results
+    const BitFieldAccessor layer = bf2.accessor( "layer" ) ;
+    const BitFieldAccessor x     = bf2.accessor( "x" ) ;
+    const BitFieldAccessor y     = bf2.accessor( bf2.index( "y" ) ) ;
+
+    test( layer.value( field ) ,  373 , " accessor field value: layer" );
+    test( x.value( field ) ,     -310 , " accessor field value: x" );
+    test( y.value( field ) ,   -16710 , " accessor field value: y" );
+    test( bf2.accessor( "unknown" ).isValid() , false , " accessor of unknown field is invalid" );
+
+    // accessor for a fixed layout built at compile time
+    constexpr BitFieldAccessor side( 5, -2 ) ;
+    static_assert( side.mask() == 0x60ULL , " compile time accessor mask" ) ;
+    test( side.value( field ) ,  1 , " constexpr accessor field value: side" );
+
+    long64 field2 = 0 ;
+    bf2.accessor( "system" ).set( field2, 30 ) ;
+    bf2.accessor( "side"   ).set( field2, 1 ) ;
+    layer.set( field2, 373 ) ;
+    bf2.accessor( "module" ).set( field2, 254 ) ;
+    bf2.accessor( "sensor" ).set( field2, 202 ) ;
+    x.set( field2, -310 ) ;
+    y.set( field2, -16710 ) ;
+
+    test( field2 , field , " same value from accessor initialization " ); 
+
+    bool thrown = false ;
+    try {  x.set( field2, 1L<<20 ) ; } catch( std::exception& ) { thrown = true ; }
+    test( thrown , true , " accessor set out of range throws" );
+
+
+    // batch access over arrays of cell IDs
+    const size_t nIds = 1000000 ;
+    std::vector<long64> ids( nIds, 0 ), xs( nIds ), ys( nIds ), values( nIds ) ;
+    for( size_t i=0 ; i<nIds ; ++i ) {
+      xs[i] = long64( i % 65536 ) - 32768 ;
+      ys[i] = long64( ( i * 7 ) % 65536 ) - 32768 ;
+    }
+    x.encode( ids.data(), nIds, xs.data() ) ;
+    y.encode( ids.data(), nIds, ys.data() ) ;
+    y.decode( ids.data(), nIds, values.data() ) ;
+
+    size_t nBad = 0 ;
+    for( size_t i=0 ; i<nIds ; ++i ) {
+      nBad += ( values[i] != ys[i] ) + ( bf2.get( ids[i], "x" ) != xs[i] ) ;
+    }
+    test( nBad , size_t(0) , " batch encode/decode of x and y" );
+
+
+    // benchmark: access by name, by index and by precompiled accessor
+    typedef std::chrono::high_resolution_clock clock ;
+    long64 sum[3] = { 0, 0, 0 } ;
+    size_t ix = bf2.index( "x" ), iy = bf2.index( "y" ) ;
+
+    clock::time_point t0 = clock::now() ;
+    for( size_t i=0 ; i<nIds ; ++i ) {
+      long64 id = 0 ;
+      bf2.set( id, "x", xs[i] ) ;
+      bf2.set( id, "y", ys[i] ) ;
+      sum[0] += bf2.get( id, "x" ) + bf2.get( id, "y" ) ;
+    }
+    clock::time_point t1 = clock::now() ;
+    for( size_t i=0 ; i<nIds ; ++i ) {
+      long64 id = 0 ;
+      bf2.set( id, ix, xs[i] ) ;
+      bf2.set( id, iy, ys[i] ) ;
+      sum[1] += bf2.get( id, ix ) + bf2.get( id, iy ) ;
+    }
+    clock::time_point t2 = clock::now() ;
+    for( size_t i=0 ; i<nIds ; ++i ) {
+      long64 id = 0 ;
+      x.set( id, xs[i] ) ;
+      y.set( id, ys[i] ) ;
+      sum[2] += x.value( id ) + y.value( id ) ;
+    }
+    clock::time_point t3 = clock::now() ;
+
+    test( sum[1] , sum[0] , " benchmark: same results by name and by index" );
+    test( sum[2] , sum[0] , " benchmark: same results by name and by accessor" );
+
+    std::stringstream sstr ;
+    sstr << " benchmark [ns per set/get cycle of 2 fields]: by name: "
+	 << std::chrono::duration<double,std::nano>( t1-t0 ).count() / nIds
+	 << " by index: " << std::chrono::duration<double,std::nano>( t2-t1 ).count() / nIds
+	 << " by accessor: " << std::chrono::duration<double,std::nano>( t3-t2 ).count() / nIds ;
+    test.log( sstr.str() ) ;
+
+
     // --------------------------------------------------------------------
 
 
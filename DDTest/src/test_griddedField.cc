@@ -0,0 +1,85 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/FieldTypes.h"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <exception>
+
+using dd4hep::GriddedField;
+
+static dd4hep::DDTest test( "GriddedField" ) ;
+
+namespace {
+  /// Linear function: reproduced exactly by the trilinear interpolation
+  double linear(double x, double y, double z, double scale)  {
+    return scale * (x + 10e0*y + 100e0*z);
+  }
+
+  /// Cartesian grid of 4x4x4 nodes with unit spacing. The field is (f, 2f, 3f)
+  void fillGrid(GriddedField& f, double scale)  {
+    std::vector<double> table;
+    for( int k = 0; k < 4; ++k )
+      for( int j = 0; j < 4; ++j )
+        for( int i = 0; i < 4; ++i )  {
+          double b = linear(i, j, k, scale);
+          double row[6] = { double(i), double(j), double(k), b, 2e0*b, 3e0*b };
+          table.insert(table.end(), row, row+6);
+        }
+    f.fill(table.data(), table.size()/6, 1e0, 1e0);
+  }
+
+  /// Check the field of the map at a point inside the grid
+  bool inside(GriddedField& f, double x, double y, double z, double scale)  {
+    double pos[3] = { x, y, z }, field[3] = { 0e0, 0e0, 0e0 };
+    double b = linear(x, y, z, scale);
+    f.fieldComponents(pos, field);
+    return std::fabs(field[0] - b) < 1e-9 && std::fabs(field[1] - 2e0*b) < 1e-9 && std::fabs(field[2] - 3e0*b) < 1e-9;
+  }
+
+  /// Check that the map adds nothing at a point outside the grid
+  bool outside(GriddedField& f, double x, double y, double z)  {
+    double pos[3] = { x, y, z }, field[3] = { 0e0, 0e0, 0e0 };
+    f.fieldComponents(pos, field);
+    return field[0] == 0e0 && field[1] == 0e0 && field[2] == 0e0;
+  }
+}
+
+/// Check the interpolation and the per-thread cell cache of the gridded field map
+int main() {
+  try{
+    GriddedField grid;
+    fillGrid(grid, 1e0);
+    test( inside(grid, 0.5, 0.5, 0.5, 1e0), true, " Point inside the grid" );
+    test( outside(grid, 99.0, 1.5, 1.5), true, " Point outside the grid" );
+    // The last lookup left the grid on the x axis after the z and y cells were found.
+    // The next lookup in exactly that cell must not use the offset of the first cell.
+    test( inside(grid, 0.5, 1.5, 1.5, 1e0), true, " Point inside after a partial miss" );
+    test( inside(grid, 0.25, 1.75, 1.5, 1e0), true, " Point in the cached cell" );
+    test( inside(grid, 3.0, 3.0, 3.0, 1e0), true, " Point on the upper grid boundary" );
+    test( outside(grid, 1.5, 1.5, -0.5), true, " Point below the grid" );
+    test( outside(grid, std::numeric_limits<double>::quiet_NaN(), 1.5, 1.5), true, " Undefined point" );
+
+    // Alternating lookups in several maps, including maps sharing a cache slot
+    std::vector<std::unique_ptr<GriddedField> > maps;
+    for( int i = 0; i < 9; ++i )  {
+      maps.emplace_back(new GriddedField());
+      fillGrid(*maps.back(), double(i+2));
+    }
+    bool ok = true;
+    for( int n = 0; n < 20; ++n )  {
+      double x = 0.5 + double(n % 3), y = 2.5 - double(n % 3);
+      ok = ok && inside(*maps[0], x, y, 1.5, 2e0);
+      ok = ok && inside(*maps[8], y, x, 1.5, 10e0);
+      ok = ok && inside(*maps[n % 9], x, x, 0.5, double(n % 9 + 2));
+      ok = ok && outside(*maps[n % 9], x, y, 9.5);
+    }
+    test( ok, true, " Alternating lookups in several maps" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4HitCollection.h"
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <exception>
+
+typedef dd4hep::sim::Geant4HitCollection::Keys Keys;
+
+static dd4hep::DDTest test( "HitCollectionKeys" ) ;
+
+/// Compare the hash index of the hit keys with std::map
+int main() {
+  try{
+    std::mt19937_64 rndm(4711);
+    Keys keys;
+    std::map<long long int, size_t> reference;
+
+    // Random cell identifiers and some with the same low bits, which collide in the table
+    for( size_t i = 0; i < 20000; ++i )  {
+      long long int key = (i % 4 == 0) ? (long long int)(i << 32) : (long long int)rndm();
+      bool inserted = reference.insert(std::make_pair(key, i)).second;
+      if ( keys.insert(key, i) != inserted )  {
+        test.error( "insert result differs from std::map" );
+        break;
+      }
+    }
+    test( keys.size(), reference.size(), " Number of keys" );
+    test( 2*keys.size() <= keys.capacity(), true, " Load factor at most 50 %" );
+
+    size_t found = 0;
+    for( const auto& r : reference )
+      found += keys.find(r.first) == r.second ? 1 : 0;
+    test( found, reference.size(), " All keys found with their hit index" );
+
+    size_t unknown = 0, notFound = 0;
+    for( size_t i = 0; i < 20000; ++i )  {
+      long long int key = (long long int)rndm();
+      if ( reference.find(key) != reference.end() ) continue;
+      ++unknown;
+      if ( keys.find(key) == Keys::npos ) ++notFound;
+    }
+    test( notFound, unknown, " Unknown keys are not found" );
+
+    // A second insertion of a known key is refused and keeps the first index
+    const auto& first = *reference.begin();
+    test( keys.insert(first.first, 999999), false, " Duplicate key refused" );
+    test( keys.find(first.first), first.second, " Duplicate key keeps first index" );
+
+    // Clearing keeps the capacity, the index is reusable
+    size_t capacity = keys.capacity();
+    keys.clear();
+    test( keys.empty(), true, " Index empty after clear" );
+    test( keys.capacity(), capacity, " Capacity kept after clear" );
+    test( keys.find(first.first), Keys::npos, " Cleared key not found" );
+    test( keys.insert(first.first, 1), true, " Insert after clear" );
+    test( keys.find(first.first), size_t(1), " Find after clear" );
+
+    // Reserved indices do not grow while filled up to the reserved size
+    Keys reserved;
+    reserved.reserve(1000);
+    size_t rehashes = reserved.statistics().rehashes;
+    for( size_t i = 0; i < 1000; ++i ) reserved.insert((long long int)rndm(), i);
+    test( reserved.statistics().rehashes, rehashes, " No growth within the reserved size" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,157 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4ParticleTable.h"
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <exception>
+
+using dd4hep::sim::Geant4Particle;
+using dd4hep::sim::Geant4ParticleTable;
+
+typedef Geant4ParticleTable::ParticleMap      ParticleMap;
+typedef Geant4ParticleTable::TrackEquivalents TrackEquivalents;
+
+static dd4hep::DDTest test( "ParticleTable" ) ;
+
+namespace {
+  /// Simulated tracks of one event: kept tracks have a particle, dropped ones an equivalent
+  struct Record  {
+    std::map<int,int>  parents;     // g4 id -> g4 parent
+    std::map<int,int>  equivalents; // g4 id -> g4 equivalent
+    std::map<int,int>  ids;         // g4 id -> particle id of kept tracks
+  };
+
+  /// Random track tree. Some parents are unknown, like tracks the handler never saw
+  Record makeRecord(std::mt19937& rndm, int num_tracks)  {
+    Record r;
+    for( int g4_id = 1, count = 0; g4_id <= num_tracks; ++g4_id )  {
+      int parent = g4_id <= 5 ? 0 : int(rndm() % g4_id);
+      if ( g4_id > 5 && rndm() % 50 == 0 ) parent = num_tracks + 1000 + g4_id;
+      r.parents[g4_id] = parent;
+      if ( g4_id <= 5 || rndm() % 3 == 0 )  {
+        r.equivalents[g4_id] = g4_id;
+        r.ids[g4_id] = count++;
+      }
+      else if ( parent > 0 )  {
+        r.equivalents[g4_id] = parent;
+      }
+    }
+    return r;
+  }
+
+  /// Create the particles of the kept tracks, keyed by the g4 identifier
+  void makeParticles(const Record& r, ParticleMap& particles)  {
+    for( const auto& i : r.ids )  {
+      Geant4Particle* p = new Geant4Particle(i.second);
+      p->g4Parent = r.parents.at(i.first);
+      particles[i.first] = p;
+    }
+  }
+
+  void release(ParticleMap& particles)  {
+    for( auto& i : particles ) i.second->release();
+    particles.clear();
+  }
+}
+
+/// Compare the track equivalent and relation handling of the particle table with the map based code
+int main() {
+  try{
+    std::mt19937 rndm(4711);
+    for( int event = 0; event < 20; ++event )  {
+      Record r = makeRecord(rndm, 200 + 50*event);
+      ParticleMap oldParticles, newParticles;
+      makeParticles(r, oldParticles);
+      makeParticles(r, newParticles);
+
+      // Map based record as used before by Geant4ParticleHandler::rebaseSimulatedTracks
+      TrackEquivalents oldEquivalents;
+      ParticleMap      oldFinal;
+      std::map<int,int> oldLastKnown;
+      int oldErrors = 0;
+      for( const auto& i : oldParticles ) oldFinal[i.second->id] = i.second;
+      for( TrackEquivalents::const_iterator ie=r.equivalents.begin(); ie!=r.equivalents.end(); ++ie )  {
+        ParticleMap::const_iterator ipar;
+        int g4_equiv = (*ie).first;
+        while( (ipar=oldParticles.find(g4_equiv)) == oldParticles.end() )  {
+          TrackEquivalents::const_iterator iequiv = r.equivalents.find(g4_equiv);
+          if ( iequiv == r.equivalents.end() ) break;
+          g4_equiv = (*iequiv).second;
+        }
+        if ( ipar != oldParticles.end() ) oldEquivalents[(*ie).first] = (*ipar).second->id;
+        oldLastKnown[(*ie).first] = g4_equiv;
+      }
+      for( const auto& i : oldParticles )  {
+        Geant4Particle* p = i.second;
+        if ( p->g4Parent > 0 )  {
+          int equiv_id = oldEquivalents[p->g4Parent];
+          ParticleMap::const_iterator ipar = oldFinal.find(equiv_id);
+          if ( ipar != oldFinal.end() )  {
+            (*ipar).second->daughters.insert(p->id);
+            p->parents.insert((*ipar).second->id);
+          }
+          else  {
+            ++oldErrors;
+          }
+        }
+      }
+
+      // The same steps with the particle table
+      Geant4ParticleTable table, final;
+      std::map<int,int> newLastKnown;
+      int newErrors = 0;
+      for( const auto& i : newParticles )  {
+        table.insert(i.first, i.second);
+        final.insert(i.second->id, i.second);
+      }
+      for( const auto& i : r.equivalents )
+        table.setEquivalent(i.first, i.second);
+      for( int g4_id = 0, n = table.equivalentSlots(); g4_id < n; ++g4_id )  {
+        if ( table.equivalent(g4_id) == Geant4ParticleTable::NO_EQUIVALENT ) continue;
+        int g4_equiv = g4_id;
+        Geant4Particle* q = table.equivalentParticle(g4_id, &g4_equiv);
+        if ( q ) final.setEquivalent(g4_id, q->id);
+        newLastKnown[g4_id] = g4_equiv;
+      }
+      for( int g4_id = 0, n = table.slots(); g4_id < n; ++g4_id )  {
+        Geant4Particle* p = table.get(g4_id);
+        if ( p && p->g4Parent > 0 )  {
+          int equiv_id = final.equivalent(p->g4Parent);
+          if ( equiv_id == Geant4ParticleTable::NO_EQUIVALENT )
+            final.setEquivalent(p->g4Parent, equiv_id = 0);
+          Geant4Particle* q = final.get(equiv_id);
+          if ( q ) final.addRelation(q->id, p->id);
+          else ++newErrors;
+        }
+      }
+      final.buildRelations();
+
+      ParticleMap      exported;
+      TrackEquivalents newEquivalents;
+      final.exportTo(exported, newEquivalents);
+      table.clear();
+
+      test( newLastKnown == oldLastKnown, true, " Last known track of the equivalent chains" );
+      test( newEquivalents == oldEquivalents, true, " Rebased track equivalents" );
+      test( newErrors, oldErrors, " Particles without parent in the record" );
+      test( exported.size(), oldFinal.size(), " Number of particles exported" );
+      bool sameRelations = true;
+      for( const auto& i : oldFinal )  {
+        ParticleMap::const_iterator j = exported.find(i.first);
+        if ( j == exported.end() ||
+             i.second->parents != (*j).second->parents ||
+             i.second->daughters != (*j).second->daughters )  {
+          sameRelations = false;
+        }
+      }
+      test( sameRelations, true, " Parents and daughters of all particles" );
+      release(oldParticles);
+      release(newParticles);
+    }
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,212 @@
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/CartesianGridXYZ.h"
+#include "DDSegmentation/PolarGridRPhi.h"
+#include "DDSegmentation/PolarGridRPhi2.h"
+#include "DDSegmentation/ProjectiveCylinder.h"
+#include "DD4hep/DDTest.h"
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <cmath>
+#include <exception>
+
+
+static dd4hep::DDTest test( "SegmentationNeighbours" ) ;
+
+using namespace dd4hep::DDSegmentation;
+
+namespace {
+  /// Check if the buffer contains the cell with the given indices
+  bool hasCell(const Segmentation& seg, const CellNeighbours& nb, const char* f1, long long v1, const char* f2, long long v2) {
+    CellID cID = 0;
+    seg.decoder()->set(cID, f1, v1);
+    seg.decoder()->set(cID, f2, v2);
+    return nb.contains(cID);
+  }
+}
+
+int main() {
+  try{
+    CartesianGridXYZ seg("system:8,x:-8,y:-8,z:8");
+    const BitFieldCoder* bc = seg.decoder();
+    CellID cID = 0;
+    bc->set(cID, "x", 5);
+    bc->set(cID, "y", -3);
+    bc->set(cID, "z", 7);
+
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(6),  " CG_XYZ: face neighbours of an inner cell" );
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, EDGE_NEIGHBOURS), size_t(18), " CG_XYZ: edge neighbours of an inner cell" );
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, ALL_NEIGHBOURS),  size_t(26), " CG_XYZ: all neighbours of an inner cell" );
+    test( nb.full(), " CG_XYZ: buffer is full" );
+    test( nb.contains(cID), false, " CG_XYZ: cell is not its own neighbour" );
+
+    std::set<CellID> nbSet;
+    seg.neighbours(cID, nbSet);
+    test( nbSet.size(), size_t(6), " CG_XYZ: neighbours as set" );
+
+    // corner cell: x at the upper, z at the lower end of the field range
+    bc->set(cID, "x", 127);
+    bc->set(cID, "z", 0);
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(4),  " CG_XYZ: face neighbours of a corner cell" );
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, ALL_NEIGHBOURS),  size_t(11), " CG_XYZ: all neighbours of a corner cell" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    CartesianGridXY seg("system:8,x:-8,y:-8");
+    CellID cID = 0;
+    seg.decoder()->set(cID, "x", -128);
+    seg.decoder()->set(cID, "y", 4);
+
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, ALL_NEIGHBOURS), size_t(5), " CG_XY: all neighbours of a border cell" );
+    test( hasCell(seg, nb, "x", -127, "y", 5), " CG_XY: diagonal neighbour" );
+    test( hasCell(seg, nb, "x", 127, "y", 4), false, " CG_XY: no wrap around of a cartesian index" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    // Identifiers changed after construction must not use the accessors of the old fields
+    CartesianGridXYZ seg("system:8,x:-8,y:-8,z:8,a:-8,b:-8");
+    seg.parameter("identifier_x")->setValue("a");
+    seg.setFieldNameY("b");
+    CellID cID = seg.cellID(Vector3D(3., -2., 5.), Vector3D(), 0);
+    const BitFieldCoder* bc = seg.decoder();
+    test( bc->get(cID, "a") == 3 && bc->get(cID, "b") == -2 && bc->get(cID, "z") == 5, " CG_XYZ: renamed fields set" );
+    test( bc->get(cID, "x") == 0 && bc->get(cID, "y") == 0, " CG_XYZ: old fields untouched" );
+    Vector3D pos = seg.position(cID);
+    test( pos.X == 3. && pos.Y == -2. && pos.Z == 5., " CG_XYZ: position from renamed fields" );
+
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(6), " CG_XYZ: face neighbours with renamed fields" );
+    CellID next = cID;
+    bc->set(next, "a", 4);
+    test( nb.contains(next), " CG_XYZ: neighbour in the renamed field" );
+    next = cID;
+    bc->set(next, "x", 1);
+    test( nb.contains(next), false, " CG_XYZ: no neighbour in the old field" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    PolarGridRPhi seg("system:8,r:8,phi:-8");
+    seg.setGridSizeR(10.);
+    seg.setGridSizePhi(2.*M_PI/8.);
+    CellID cID = 0;
+    seg.decoder()->set(cID, "r", 0);
+    seg.decoder()->set(cID, "phi", 4);
+
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(3), " RPhi: face neighbours at r=0" );
+    test( hasCell(seg, nb, "r", 0, "phi", -3), " RPhi: phi wraps around" );
+    test( hasCell(seg, nb, "r", 0, "phi", 3), " RPhi: phi neighbour" );
+    test( hasCell(seg, nb, "r", 1, "phi", 4), " RPhi: r neighbour" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    PolarGridRPhi2 seg("system:8,r:8,phi:8");
+    std::vector<double> rValues, phiValues;
+    rValues.push_back(10.);
+    rValues.push_back(20.);
+    rValues.push_back(30.);
+    rValues.push_back(40.);
+    phiValues.push_back(M_PI/18.);
+    phiValues.push_back(M_PI/6.);
+    phiValues.push_back(M_PI/9.);
+    seg.setGridRValues(rValues);
+    seg.setGridPhiValues(phiValues);
+
+    CellID cID = 0;
+    seg.decoder()->set(cID, "r", 1);
+    seg.decoder()->set(cID, "phi", 0);
+
+    // the cell covers 3 cells of the inner ring and overlaps 2 cells of the outer ring
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(7), " RPhi2: face neighbours" );
+    test( hasCell(seg, nb, "r", 1, "phi", 11), " RPhi2: phi wraps around" );
+    test( hasCell(seg, nb, "r", 0, "phi", 0), " RPhi2: first inner ring neighbour" );
+    test( hasCell(seg, nb, "r", 0, "phi", 2), " RPhi2: last inner ring neighbour" );
+    test( hasCell(seg, nb, "r", 2, "phi", 0), " RPhi2: outer ring neighbour" );
+    test( hasCell(seg, nb, "r", 2, "phi", 1), " RPhi2: partly overlapping outer ring neighbour" );
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, ALL_NEIGHBOURS), size_t(10), " RPhi2: all neighbours" );
+    test( hasCell(seg, nb, "r", 0, "phi", 35), " RPhi2: inner corner neighbour wraps around" );
+    test( hasCell(seg, nb, "r", 0, "phi", 3), " RPhi2: inner corner neighbour" );
+    test( hasCell(seg, nb, "r", 2, "phi", 17), " RPhi2: outer corner neighbour wraps around" );
+    test( hasCell(seg, nb, "r", 2, "phi", 2), false, " RPhi2: no neighbour beyond the phi range" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    // every cell is a neighbour of its neighbours, also for phi bins not aligned between the rings
+    PolarGridRPhi2 seg("system:8,r:8,phi:8");
+    std::vector<double> rValues, phiValues;
+    const int bins[5] = { 7, 5, 12, 12, 36 };
+    for( int i = 0; i < 6; ++i ) rValues.push_back(10. + 10.*i);
+    for( int i = 0; i < 5; ++i ) phiValues.push_back(2.*M_PI/bins[i]);
+    seg.setGridRValues(rValues);
+    seg.setGridPhiValues(phiValues);
+    const BitFieldCoder* bc = seg.decoder();
+    const int connectivity[2] = { FACE_NEIGHBOURS, ALL_NEIGHBOURS };
+    bool symmetric = true;
+    size_t numNeighbours = 0;
+    for( int c = 0; c < 2; ++c ) {
+      for( int r = 0; r < 5; ++r ) {
+        for( int p = 0; p < bins[r]; ++p ) {
+          CellID cID = 0;
+          bc->set(cID, "r", r);
+          bc->set(cID, "phi", p);
+          CellNeighbours nb;
+          numNeighbours += seg.fillNeighbours(cID, nb, connectivity[c]);
+          for( const CellID& n : nb ) {
+            CellNeighbours back;
+            seg.fillNeighbours(n, back, connectivity[c]);
+            symmetric = symmetric && back.contains(cID);
+          }
+        }
+      }
+    }
+    test( numNeighbours > 0, " RPhi2: neighbours found" );
+    test( symmetric, " RPhi2: neighbour relation is symmetric" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  try{
+    ProjectiveCylinder seg("system:8,theta:8,phi:-8");
+    seg.setThetaBins(4);
+    seg.setPhiBins(6);
+    CellID cID = 0;
+    seg.decoder()->set(cID, "theta", 0);
+    seg.decoder()->set(cID, "phi", -3);
+
+    CellNeighbours nb;
+    test( seg.fillNeighbours(cID, nb, FACE_NEIGHBOURS), size_t(3), " PC: face neighbours at the pole" );
+    test( hasCell(seg, nb, "theta", 0, "phi", 2), " PC: phi wraps around" );
+    nb.clear();
+    test( seg.fillNeighbours(cID, nb, ALL_NEIGHBOURS), size_t(5), " PC: all neighbours at the pole" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4ThreadPool.h"
+
+#include <iostream>
+#include <atomic>
+#include <random>
+#include <exception>
+
+using dd4hep::sim::Geant4ParticleMap;
+using dd4hep::sim::Geant4ThreadPool;
+
+static dd4hep::DDTest test( "TrackRemapping" ) ;
+
+namespace {
+  /// Remap a copy of the track identifiers. Returns the remapped identifiers
+  std::vector<int> remap(const Geant4ParticleMap& truth, const std::vector<int>& tracks, Geant4ThreadPool* pool)  {
+    std::vector<int> ids(tracks);
+    std::vector<int*> track_ids;
+    for( int& id : ids ) track_ids.push_back(&id);
+    truth.remapTrackIDs(track_ids, pool);
+    return ids;
+  }
+
+  /// Remapping by lookup in the map of track equivalents
+  std::vector<int> reference(const Geant4ParticleMap& truth, const std::vector<int>& tracks)  {
+    std::vector<int> ids;
+    for( int id : tracks )  {
+      Geant4ParticleMap::TrackEquivalents::const_iterator i = truth.equivalents().find(id);
+      ids.push_back(i == truth.equivalents().end() ? -1 : (*i).second);
+    }
+    return ids;
+  }
+}
+
+/// Compare the bulk remapping of hit track identifiers with the map of track equivalents
+int main() {
+  try{
+    // Every chunk of every run is processed exactly once by the reused threads
+    Geant4ThreadPool pool(3);
+    std::vector<std::atomic<int> > calls(64);
+    bool once = true;
+    for( size_t run = 0; run < 100; ++run )  {
+      for( auto& c : calls ) c = 0;
+      size_t num_chunks = 1 + run % calls.size();
+      pool.run(num_chunks, [&calls](size_t chunk) { ++calls[chunk]; });
+      for( size_t i = 0; i < calls.size(); ++i )
+        once = once && calls[i] == (i < num_chunks ? 1 : 0);
+    }
+    test( once, true, " Thread pool runs each chunk once" );
+
+    std::mt19937 rndm(4711);
+    Geant4ParticleMap::ParticleMap       particles;
+    Geant4ParticleMap::TrackEquivalents  equivalents;
+    for( int g4_id = 1; g4_id < 20000; ++g4_id )
+      equivalents[g4_id] = int(rndm() % 500);
+    Geant4ParticleMap truth;
+    truth.adopt(particles, equivalents);
+
+    std::vector<int> tracks;
+    for( size_t i = 0; i < 100000; ++i )
+      tracks.push_back(1 + int(rndm() % 19999));
+
+    std::vector<int> expected = reference(truth, tracks);
+    test( remap(truth, tracks, 0) == expected, true, " Serial remapping" );
+    test( remap(truth, tracks, &pool) == expected, true, " Remapping with the thread pool" );
+    test( remap(truth, tracks, &pool) == expected, true, " Remapping with the reused thread pool" );
+
+    // Direct changes of the public map are seen by the next remapping
+    truth.equivalentTracks[tracks[0]] = 4711;
+    truth.equivalentTracks[30000] = 17;
+    tracks.push_back(30000);
+    expected = reference(truth, tracks);
+    test( remap(truth, tracks, &pool) == expected, true, " Remapping after changes of the track equivalents" );
+    test( expected[0], 4711, " Changed equivalent used" );
+    test( expected.back(), 17, " Added equivalent used" );
+
+    truth.equivalentTracks.erase(tracks[1]);
+    std::vector<int> ids(tracks);
+    std::vector<int*> track_ids;
+    for( int& id : ids ) track_ids.push_back(&id);
+    size_t num_unknown = 0;
+    for( int id : tracks ) num_unknown += id == tracks[1] ? 1 : 0;
+    test( truth.remapTrackIDs(track_ids, &pool), num_unknown, " Removed equivalent reported" );
+    test( ids == reference(truth, tracks), true, " Removed equivalent set to -1" );
+
+    // Tracks already found to be unknown are not reported again
+    std::vector<int> unknown(10, -1);
+    track_ids.clear();
+    for( int& id : unknown ) track_ids.push_back(&id);
+    test( truth.remapTrackIDs(track_ids, &pool), size_t(0), " Unknown tracks not reported twice" );
+    test( unknown == std::vector<int>(10, -1), true, " Unknown tracks stay -1" );
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
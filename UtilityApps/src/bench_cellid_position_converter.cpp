@@ -0,0 +1,148 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/DDTest.h"
+
+#include "DD4hep/DD4hepUnits.h"
+#include "DD4hep/BitFieldCoder.h"
+#include "DDRec/CellIDPositionConverter.h"
+
+#include "lcio.h"
+#include "IO/LCReader.h"
+#include "EVENT/LCEvent.h"
+#include "EVENT/LCCollection.h"
+#include "EVENT/SimCalorimeterHit.h"
+
+#include "TTimeStamp.h"
+
+#include <sstream>
+
+using namespace std ;
+using namespace dd4hep ;
+using namespace dd4hep::detail;
+using namespace dd4hep::rec ;
+
+using namespace lcio;
+
+
+static DDTest test( "cellid_position_converter_throughput" ) ;
+
+//=============================================================================
+
+const double epsilon = dd4hep::micrometer ;
+const int nRepeat = 10 ;
+
+
+double dist( const Position& p0, const Position& p1 ){
+  Position p2 = p1 - p0 ;
+  return p2.r() ;
+}
+
+
+int main_wrapper(int argc, char** argv ){
+
+  if( argc < 3 ) {
+    std::cout << " usage: bench_cellid_position_converter compact.xml lcio_file.slcio" << std::endl ;
+    exit(1) ;
+  }
+
+  std::string inFile =  argv[1] ;
+
+  Detector& description = Detector::getInstance();
+
+  description.fromCompact( inFile );
+
+  CellIDPositionConverter idposConv( description )  ;
+
+
+  //---------------------------------------------------------------------
+  //    collect the cellIDs of all SimCalorimeterHits in the lcio file
+  //---------------------------------------------------------------------
+
+  std::string lcioFileName = argv[2] ;
+
+  LCReader* rdr = LCFactory::getInstance()->createLCReader() ;
+  rdr->open( lcioFileName ) ;
+
+  LCEvent* evt = 0 ;
+
+  // ignore all hits from these collections
+  std::set< std::string > subsetIgnore = {"HCalBarrelRPCHits","HCalECRingRPCHits","HCalEndcapRPCHits" } ;
+
+  std::vector<CellID> cells ;
+
+  while( ( evt = rdr->readNextEvent() ) != 0 ){
+
+    const std::vector< std::string >& colNames = *evt->getCollectionNames() ;
+
+    for(unsigned icol=0, ncol = colNames.size() ; icol < ncol ; ++icol ){
+
+      LCCollection* col =  evt->getCollection( colNames[ icol ] ) ;
+
+      if( col->getTypeName() != lcio::LCIO::SIMCALORIMETERHIT )
+        continue ;
+
+      if( subsetIgnore.find( colNames[icol] ) !=  subsetIgnore.end() )
+       	continue ;
+
+      std::string cellIDEcoding = col->getParameters().getStringVal("CellIDEncoding") ;
+      dd4hep::BitFieldCoder idDecoder( cellIDEcoding ) ;
+
+      for(int i=0, nHit = col->getNumberOfElements() ; i< nHit ; ++i){
+        SimCalorimeterHit* sHit = (SimCalorimeterHit*) col->getElementAt(i) ;
+	cells.push_back( idDecoder.toLong( sHit->getCellID0() , sHit->getCellID1() ) ) ;
+      }
+    }
+  }
+  rdr->close() ;
+
+  //---------------------------------------------------------------------
+  //    time single cell versus batched conversion
+  //---------------------------------------------------------------------
+
+  std::vector<Position> single( cells.size() ), batch( cells.size() ) ;
+
+  TTimeStamp start ;
+  for(int n=0 ; n < nRepeat ; ++n ){
+    for(size_t i=0 ; i < cells.size() ; ++i )
+      single[i] = idposConv.positionNominal( cells[i] ) ;
+  }
+  TTimeStamp middle ;
+  for(int n=0 ; n < nRepeat ; ++n ){
+    idposConv.positionsNominal( cells, batch ) ;
+  }
+  TTimeStamp stop ;
+
+  unsigned failed = 0 ;
+  for(size_t i=0 ; i < cells.size() ; ++i ){
+    if( dist( single[i], batch[i] ) >= epsilon )
+      ++failed ;
+  }
+  std::stringstream sst ;
+  sst << " batched positions agree with single cell conversion for " << cells.size() << " cells" ;
+  test( failed , 0u , sst.str() ) ;
+
+  double tSingle = middle.AsDouble() - start.AsDouble() ;
+  double tBatch  = stop.AsDouble() - middle.AsDouble() ;
+  double nCells  = double( cells.size() ) * nRepeat ;
+
+  std::cout << "\n ----------------------- summary  ----------------------   " << std::endl ;
+  printf(" %-30s \t %10.0f cells/s \n", "positionNominal",  tSingle > 0. ? nCells / tSingle : 0. ) ;
+  printf(" %-30s \t %10.0f cells/s \n", "positionsNominal", tBatch  > 0. ? nCells / tBatch  : 0. ) ;
+  std::cout << "\n -------------------------------------------------------- " << std::endl ;
+
+  return 0;
+}
+
+//=============================================================================
+#include "main.h"
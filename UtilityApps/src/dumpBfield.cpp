@@ -19,18 +19,70 @@
 #include "DD4hep/Detector.h"
 #include "DD4hep/DD4hepUnits.h"
 
+// C/C++ include files
+#include <chrono>
+#include <cmath>
+#include <random>
+
 using namespace std ;
 using namespace dd4hep ;
 using namespace dd4hep::detail;
 
 //=============================================================================
 
+/// Compare the evaluation of the individual field components with the compiled overlay
+static int benchmark_B_field(Detector& description, const double* range, long num_steps){
+  OverlayedField field = description.field();
+  const std::vector<CartesianField>& components = field.data<OverlayedField::Object>()->magnetic_components;
+  std::vector<double> points(3*num_steps);
+  std::mt19937 generator(4711);
+  for(int i=0; i<3; ++i){
+    std::uniform_real_distribution<double> coord(-range[i], range[i]);
+    for(long j=0; j<num_steps; ++j) points[3*j+i] = coord(generator);
+  }
+  typedef std::chrono::high_resolution_clock clock;
+  double sum_generic = 0e0, sum_compiled = 0e0, max_diff = 0e0;
+  
+  clock::time_point start = clock::now();
+  for(long j=0; j<num_steps; ++j){
+    double b[3] = { 0e0, 0e0, 0e0 };
+    for(const auto& c : components) c.value(&points[3*j], b);
+    sum_generic += b[0] + b[1] + b[2];
+  }
+  clock::time_point middle = clock::now();
+  for(long j=0; j<num_steps; ++j){
+    double b[3];
+    field.magneticField(&points[3*j], b);
+    sum_compiled += b[0] + b[1] + b[2];
+  }
+  clock::time_point stop = clock::now();
+  // Verify both evaluations agree
+  for(long j=0; j<num_steps; j += std::max(1L, num_steps/1000)){
+    double b1[3] = { 0e0, 0e0, 0e0 }, b2[3];
+    for(const auto& c : components) c.value(&points[3*j], b1);
+    field.magneticField(&points[3*j], b2);
+    for(int i=0; i<3; ++i) max_diff = std::max(max_diff, std::fabs(b1[i]-b2[i]));
+  }
+  double t_generic  = std::chrono::duration<double>(middle-start).count();
+  double t_compiled = std::chrono::duration<double>(stop-middle).count();
+  printf("+++ Field components: %ld  Steps: %ld\n", long(components.size()), num_steps);
+  printf("+++ Generic:  %12.0f steps/sec  [checksum: %+15.8e]\n",
+         t_generic  > 0e0 ? num_steps/t_generic  : 0e0, sum_generic/dd4hep::tesla);
+  printf("+++ Compiled: %12.0f steps/sec  [checksum: %+15.8e]\n",
+         t_compiled > 0e0 ? num_steps/t_compiled : 0e0, sum_compiled/dd4hep::tesla);
+  printf("+++ Speedup:  %12.2f  Max. difference: %g Tesla\n",
+         t_compiled > 0e0 ? t_generic/t_compiled : 0e0, max_diff/dd4hep::tesla);
+  return max_diff > 1e-9*dd4hep::tesla ? EINVAL : 0;
+}
 
 static int invoke_dump_B_field(int argc, char** argv ){
   
-  if( argc != 8 ) {
-    std::cout << " usage: dumpBfield compact.xml x y z dx dy dz [in cm]" << std::endl 
+  bool benchmark = argc == 10 && std::string(argv[8]) == "-benchmark";
+  if( argc != 8 && !benchmark ) {
+    std::cout << " usage: dumpBfield compact.xml x y z dx dy dz [in cm] [-benchmark <steps>]" << std::endl 
 	      << "    will dump the B-field in volume [-x:x,-y:y,-z,z] with steps [dx,dy,dz] "
+	      << std::endl
+	      << "    -benchmark: compare the field evaluation speed at <steps> random points of the volume"
 	      << std::endl ;
     
     exit(1) ;
@@ -54,6 +106,11 @@ static int invoke_dump_B_field(int argc, char** argv ){
   Detector& description = Detector::getInstance();
   description.fromCompact( inFile );
   
+  if( benchmark ) {
+    double range[3] = { xRange*dd4hep::cm, yRange*dd4hep::cm, zRange*dd4hep::cm } ;
+    return benchmark_B_field( description, range, std::atol(argv[9]) ) ;
+  }
+
   printf("#######################################################################################################\n");
   printf("       x[cm]             y[cm]           z[cm]           Bx[Tesla]        By[cm]          Bz[cm]       \n");
 
@@ -18,6 +18,7 @@
 #include "DD4hep/DD4hepUnits.h"
 #include "DD4hep/BitFieldCoder.h"
 #include "DDRec/CellIDPositionConverter.h"
+#include "DDRec/CellIDNavigationCache.h"
 
 #include "lcio.h"
 #include "IO/LCReader.h"
@@ -25,6 +26,8 @@
 #include "EVENT/LCCollection.h"
 #include "EVENT/SimCalorimeterHit.h"
 
+#include "TTimeStamp.h"
+
 #include <sstream>
 
 using namespace std ;
@@ -78,6 +81,8 @@ int main_wrapper(int argc, char** argv ){
 
   CellIDPositionConverter idposConv( description )  ;
 
+  CellIDNavigationCache navCache( description ) ;
+
   
   //---------------------------------------------------------------------
   //    open lcio file with SimCalorimeterHits
@@ -101,6 +106,10 @@ int main_wrapper(int argc, char** argv ){
   
   TestMap tMap ;
 
+  // all points compared with the navigation cache: hit positions and points next to them
+  std::vector<Position> points ;
+  unsigned cacheFound = 0 ;
+
   while( ( evt = rdr->readNextEvent() ) != 0 ){
 
     const std::vector< std::string >& colNames = *evt->getCollectionNames() ;
@@ -156,6 +165,22 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].cellid.passed++ ;
 	else
 	  tMap[ colNames[icol] ].cellid.failed++ ;
+
+	// ====== the navigation cache must agree with the TGeoManager based search =========================
+	// also for points next to the hit, which may be in gaps, dead material or other cells
+	const Position probes[2] = { point, point + Position( 0.7*dd4hep::mm, -0.9*dd4hep::mm, 1.1*dd4hep::mm ) } ;
+	for( int k=0 ; k < 2 ; ++k ){
+	  const Position& p  = probes[k] ;
+	  CellID idFromGeo   = ( k == 0 ) ? idFromDecoder : idposConv.cellID( p ) ;
+	  CellID idFromCache = navCache.cellID( p ) ;
+	  std::stringstream sstc ;
+	  sstc << " compare cached ids: " << det.name() << " ( " << p << " ) "
+	       << idDecoder0.valueString(idFromGeo) << "  -  " << idDecoder1.valueString(idFromCache) ;
+	  test( idFromGeo, idFromCache,  sstc.str() ) ;
+	  points.push_back( p ) ;
+	  if( idFromCache != 0 )
+	    ++cacheFound ;
+	}
 	  
 	Position pointFromDecoder = idposConv.position( id ) ;
 
@@ -193,6 +218,28 @@ int main_wrapper(int argc, char** argv ){
 	   name.c_str(), pos_failed , id_failed, total ) ;
 
   }
+
+  // ====== timing of the TGeoManager based search and of the navigation cache ===========================
+  CellID sum = 0 ;
+  TTimeStamp start ;
+  for( const Position& p : points )
+    sum += idposConv.cellID( p ) ;
+  TTimeStamp middle ;
+  for( const Position& p : points )
+    sum -= navCache.cellID( p ) ;
+  TTimeStamp stop ;
+
+  double tGeo   = middle.AsDouble() - start.AsDouble() ;
+  double tCache = stop.AsDouble() - middle.AsDouble() ;
+  double nPoints = double( points.size() ) ;
+
+  printf(" %-30s \t  found: %5d  of total: %5d  ( %5.1f %% )   complete: %s \n",
+	 "navigation cache", cacheFound, unsigned( points.size() ),
+	 nPoints > 0. ? 100. * cacheFound / nPoints : 0., navCache.isComplete() ? "yes" : "no" ) ;
+  printf(" %-30s \t %10.0f points/s \n", "TGeoManager::FindNode", tGeo   > 0. ? nPoints / tGeo   : 0. ) ;
+  printf(" %-30s \t %10.0f points/s \n", "CellIDNavigationCache", tCache > 0. ? nPoints / tCache : 0. ) ;
+  test( sum, CellID(0), " cached and TGeo based cellIDs of all timed points agree" ) ;
+
   std::cout << "\n -------------------------------------------------------- " << std::endl ;
 
   
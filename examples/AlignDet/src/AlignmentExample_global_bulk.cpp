@@ -0,0 +1,145 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -destroy -plugin DD4hep_AlignmentExample_global_bulk \
+   -input     file:${DD4hep_DIR}/examples/AlignDet/compact/AlephTPC.xml \
+   -alignment file:${DD4hep_DIR}/examples/AlignDet/compact/AlephTPC_alignment.xml
+
+   Apply a global alignment file first in the standard mode and then
+   in bulk mode. The global transformations of all placements in the
+   geometry are compared after each step.
+   The alignment file must reset the detector elements it aligns.
+*/
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DDAlign/GlobalAlignmentCache.h"
+
+// ROOT include files
+#include "TGeoManager.h"
+#include "TGeoMatrix.h"
+#include "TGeoNode.h"
+
+// C/C++ include files
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace {
+  /// Global transformations of all placements by path
+  typedef map<string, TGeoHMatrix> Placements;
+
+  /// Collect the global transformations of a node and all its daughters
+  void collect(TGeoNode* node, const string& path, const TGeoHMatrix& mother, Placements& placements)  {
+    string      node_path = path + "/" + node->GetName();
+    TGeoHMatrix world(mother);
+    TGeoVolume* vol = node->GetVolume();
+    world.Multiply(node->GetMatrix());
+    placements[node_path] = world;
+    for(int i=0, n=vol->GetNdaughters(); i<n; ++i)
+      collect(vol->GetNode(i), node_path, world, placements);
+  }
+
+  /// Collect the global transformations of all placements in the geometry
+  Placements collect(Detector& description)  {
+    Placements placements;
+    collect(description.manager().GetTopNode(), "", TGeoHMatrix(), placements);
+    return placements;
+  }
+
+  /// Compare two transformations within numerical precision
+  bool same(const TGeoHMatrix& a, const TGeoHMatrix& b)  {
+    const Double_t* ra = a.GetRotationMatrix(), *rb = b.GetRotationMatrix();
+    const Double_t* ta = a.GetTranslation(),    *tb = b.GetTranslation();
+    for(int i=0; i<9; ++i)
+      if ( std::fabs(ra[i]-rb[i]) > 1e-10 ) return false;
+    for(int i=0; i<3; ++i)
+      if ( std::fabs(ta[i]-tb[i]) > 1e-8 ) return false;
+    return true;
+  }
+}
+
+/// Plugin function: Compare the bulk application of global alignments with the standard mode
+/**
+ *  Factory: DD4hep_AlignmentExample_global_bulk
+ *
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static int alignment_example (Detector& description, int argc, char** argv)  {
+  string input, alignment;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-alignment",argv[i],4) )
+      alignment = argv[++i];
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || alignment.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_AlignmentExample_global_bulk             \n"
+      "     -input     <string>      Geometry file                                   \n"
+      "     -alignment <string>      Global alignment file                           \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+  align::GlobalAlignmentCache* cache = align::GlobalAlignmentCache::install(description);
+  Placements nominal = collect(description);
+
+  // Apply the alignments in the standard mode
+  cache->setBulkMode(false);
+  description.fromXML(alignment);
+  Placements standard = collect(description);
+
+  // Apply the same alignments again in bulk mode
+  cache->setBulkMode(true);
+  description.fromXML(alignment);
+  Placements bulk = collect(description);
+
+  size_t num_aligned = 0, num_diff = 0;
+  for(const auto& p : standard)  {
+    Placements::const_iterator i = bulk.find(p.first);
+    if ( !same(p.second, nominal[p.first]) ) ++num_aligned;
+    if ( i == bulk.end() || !same(p.second, (*i).second) )  {
+      printout(ERROR,"Compare","Placement %s differs in bulk mode.",p.first.c_str());
+      ++num_diff;
+    }
+  }
+  if ( bulk.size() != standard.size() )  {
+    printout(ERROR,"Compare","Bulk mode: %ld placements instead of %ld.",bulk.size(),standard.size());
+    ++num_diff;
+  }
+  printout(INFO,"Summary","Compared %ld placements: %ld aligned, %ld differences between bulk and standard mode.",
+           standard.size(), num_aligned, num_diff);
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_AlignmentExample_global_bulk,alignment_example)
@@ -45,7 +45,7 @@ using namespace dd4hep::AlignmentExamples;
 static int alignment_example (Detector& description, int argc, char** argv)  {
 
   string input;
-  int    num_iov = 10, num_runs = 10;
+  int    num_iov = 10, num_runs = 10, num_threads = 0, num_chunk = 32;
   bool   arg_error = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
@@ -54,6 +54,10 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
       num_iov = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-runs",argv[i],4) )
       num_runs = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-chunk",argv[i],4) )
+      num_chunk = ::atol(argv[++i]);
     else
       arg_error = true;
   }
@@ -65,6 +69,8 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
+      "     -threads <number>        Compute alignments level by level in threads.   \n"
+      "     -chunk   <number>        Minimal number of alignments per thread [32].   \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -122,7 +128,9 @@ static int alignment_example (Detector& description, int argc, char** argv)  {
     ConditionsManager::Result cres = manager.prepare(req_iov,*sl);
     // Now compute the tranformation matrices
     AlignmentsCalculator calculator;
-    AlignmentsCalculator::Result ares = calculator.compute(deltas,*sl);
+    AlignmentsCalculator::Result ares = num_threads > 0
+      ? calculator.compute(deltas,*sl,num_threads,num_chunk)
+      : calculator.compute(deltas,*sl);
     TTimeStamp stop;
     total_cres += cres;
     total_ares += ares;
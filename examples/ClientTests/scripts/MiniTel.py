@@ -26,6 +26,8 @@ def run():
 
   # Configure field
   field = geant4.setupTrackingField(prt=True)
+  if len(sys.argv) >= 3 and sys.argv[2] =="cache":
+    field.cache_distance = 0.1*mm
   # Configure I/O
   evt_root = geant4.setupROOTOutput('RootOutput','MiniTel_'+time.strftime('%Y-%m-%d_%H-%M'),mc_truth=True)
   # Setup particle gun
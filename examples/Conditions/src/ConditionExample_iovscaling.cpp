@@ -0,0 +1,228 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -destroy -plugin DD4hep_ConditionExample_iovscaling \
+   -iovs 10000 -selects 1000
+
+   Register an increasing number of IOV pools (100, 1000, ... up to -iovs)
+   and compare the interval index of the ConditionsIOVPool with a linear
+   scan over all pools for the selection of the pools valid for a run
+   (select) and of the conditions overlapping a run range (selectRange).
+   Finally new pools are registered while selecting, as it happens if
+   every prepare creates a new pool: one registration before each selection.
+   Both must select the same conditions.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DD4hep/detail/ConditionsInterna.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+
+#include <random>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Reference selection: linear scan over all pools of the IOV type
+  size_t linear_select(const ConditionsIOVPool& pool, const IOV& req, RangeConditions& result)  {
+    size_t num_selected = 0;
+    for( const auto& e : pool.elements )  {
+      if ( IOV::key_contains_range(e.first, req.keyData) )
+        num_selected += e.second->select_all(result);
+    }
+    return num_selected;
+  }
+
+  /// Reference range selection: linear scan over all pools of the IOV type
+  size_t linear_select_range(const ConditionsIOVPool& pool, Condition::key_type key,
+                             const IOV& req, RangeConditions& result)  {
+    size_t len = result.size();
+    const IOV::Key& range = req.keyData;
+    for( const auto& e : pool.elements )  {
+      const IOV::Key& k = e.first;
+      if ( IOV::key_is_contained(k,range) ||
+           IOV::key_overlaps_lower_end(k,range) ||
+           IOV::key_overlaps_higher_end(k,range) )
+        e.second->select(key, result);
+    }
+    return result.size() - len;
+  }
+
+  /// Check that two selections contain the same conditions in the same order
+  bool same_selection(const RangeConditions& a, const RangeConditions& b)  {
+    return a.size() == b.size() &&
+      equal(a.begin(), a.end(), b.begin(), [](Condition x, Condition y) { return x.ptr() == y.ptr(); });
+  }
+
+  /// Register a new pool with one condition. Every 10th pool is valid for 1000 runs.
+  void register_pool(ConditionsManager& manager, const IOVType* iov_typ, int num)  {
+    long first = 1 + long(num)*10;
+    IOV::Key key = (num%10) == 0 ? IOV::Key(first,first+999) : IOV::Key(first,first+9);
+    ConditionsPool* pool = manager.registerIOV(*iov_typ, key);
+    Condition cond("iov_"+to_string(num), "iovscaling");
+    cond->hash = Condition::key_type(num);
+    manager.registerUnlocked(*pool, cond);
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_iovscaling
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  int    num_iov = 10000, num_select = 1000;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-selects",argv[i],4) )
+      num_select = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || num_iov <= 0 || num_select <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_iovscaling              \n"
+      "     -iovs     <number>       Maximal number of IOV pools.                    \n"
+      "     -selects  <number>       Number of selections per step.                  \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+  ConditionsIOVPool* iov_pool = manager.iovPool(*iov_typ);
+
+  mt19937 generator(12345);
+  long    errors = 0;
+  int     registered = 0;
+  for(int step = 100; ; step *= 10)  {
+    int count = min(step, num_iov);
+    // Run ranges of 10 runs each. Every 10th pool in addition is valid for 1000 runs.
+    for( ; registered < count; ++registered )
+      register_pool(manager, iov_typ, registered);
+    vector<IOV> requests, ranges;
+    vector<Condition::key_type> keys;
+    uniform_int_distribution<long> run(1, 10*count);
+    for(int i=0; i<num_select; ++i)  {
+      long r = run(generator);
+      requests.push_back(IOV(iov_typ, r));
+      ranges.push_back(IOV(iov_typ, IOV::Key(r, r+50)));
+      // The condition of the pool starting at the beginning of the range
+      keys.push_back(Condition::key_type((r-1)/10));
+    }
+
+    RangeConditions linear, indexed;
+    size_t num_linear = 0, num_indexed = 0;
+    TTimeStamp start;
+    for( const auto& req : requests )  {
+      linear.clear();
+      num_linear += linear_select(*iov_pool, req, linear);
+    }
+    TTimeStamp middle;
+    for( const auto& req : requests )  {
+      IOV cond_iov(iov_typ);
+      cond_iov.reset().invert();
+      indexed.clear();
+      num_indexed += iov_pool->select(req, indexed, cond_iov);
+    }
+    TTimeStamp stop;
+    // Compare the content of the last selection and the totals
+    if ( num_linear != num_indexed || !same_selection(linear, indexed) )  {
+      printout(ERROR,"IOVScaling","+++ Selection mismatch for %d IOV pools: linear:%ld indexed:%ld",
+               count, num_linear, num_indexed);
+      ++errors;
+    }
+    double t_linear  = middle.AsDouble()-start.AsDouble();
+    double t_indexed = stop.AsDouble()-middle.AsDouble();
+    printout(INFO,"Statistics",
+             "+  IOV pools:%7d  Selected:%8ld  Linear:%9.3f us/select  Indexed:%9.3f us/select  Speedup:%7.2f",
+             count, num_indexed, 1e6*t_linear/num_select, 1e6*t_indexed/num_select,
+             t_indexed > 0e0 ? t_linear/t_indexed : 0e0);
+
+    // Range selection of single conditions
+    size_t num_range_linear = 0, num_range_indexed = 0;
+    TTimeStamp range_start;
+    for( int i=0; i<num_select; ++i )  {
+      linear.clear();
+      num_range_linear += linear_select_range(*iov_pool, keys[i], ranges[i], linear);
+    }
+    TTimeStamp range_middle;
+    for( int i=0; i<num_select; ++i )  {
+      indexed.clear();
+      num_range_indexed += iov_pool->selectRange(keys[i], ranges[i], indexed);
+    }
+    TTimeStamp range_stop;
+    if ( num_range_linear != num_range_indexed || !same_selection(linear, indexed) )  {
+      printout(ERROR,"IOVScaling","+++ Range selection mismatch for %d IOV pools: linear:%ld indexed:%ld",
+               count, num_range_linear, num_range_indexed);
+      ++errors;
+    }
+    t_linear  = range_middle.AsDouble()-range_start.AsDouble();
+    t_indexed = range_stop.AsDouble()-range_middle.AsDouble();
+    printout(INFO,"Statistics",
+             "+  IOV pools:%7d  Selected:%8ld  Linear:%9.3f us/range   Indexed:%9.3f us/range   Speedup:%7.2f",
+             count, num_range_indexed, 1e6*t_linear/num_select, 1e6*t_indexed/num_select,
+             t_indexed > 0e0 ? t_linear/t_indexed : 0e0);
+    if ( count == num_iov ) break;
+  }
+
+  // Interleaved registration and selection: the index is updated, not rebuilt
+  double t_linear = 0e0, t_indexed = 0e0, t_register = 0e0;
+  long   num_mismatch = 0;
+  for( int i=0; i<num_select; ++i, ++registered )  {
+    TTimeStamp start;
+    register_pool(manager, iov_typ, registered);
+    TTimeStamp middle;
+    IOV req(iov_typ, 1 + long(registered)*10);
+    IOV cond_iov(iov_typ);
+    cond_iov.reset().invert();
+    RangeConditions linear, indexed;
+    iov_pool->select(req, indexed, cond_iov);
+    TTimeStamp stop;
+    linear_select(*iov_pool, req, linear);
+    TTimeStamp last;
+    if ( !same_selection(linear, indexed) ) ++num_mismatch;
+    t_register += middle.AsDouble()-start.AsDouble();
+    t_indexed  += stop.AsDouble()-middle.AsDouble();
+    t_linear   += last.AsDouble()-stop.AsDouble();
+  }
+  if ( num_mismatch > 0 )  {
+    printout(ERROR,"IOVScaling","+++ %ld interleaved selections mismatch.", num_mismatch);
+    ++errors;
+  }
+  printout(INFO,"Statistics",
+           "+  Interleaved: IOV pools:%7d  Register:%9.3f us  Linear:%9.3f us/select  Indexed:%9.3f us/select",
+           registered, 1e6*t_register/num_select, 1e6*t_linear/num_select, 1e6*t_indexed/num_select);
+  printout(INFO,"Statistics","+  %s: Num.Errors:%ld", errors ? "FAILED" : "PASSED", errors);
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_iovscaling,condition_example)
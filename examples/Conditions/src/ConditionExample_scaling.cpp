@@ -0,0 +1,263 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_scaling \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -threads 4
+
+   Populate the conditions store by hand for a set of IOVs.
+   Then prepare slices for changing IOVs concurrently with 1,2,4,...
+   threads and measure the throughput of the slice preparation.
+
+   With the option -load the store is not populated beforehand. The
+   conditions are created on demand by a conditions data loader while
+   the slices are prepared. Other threads select from the same IOV pools
+   at the same time. The store is cleared before every step.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DDCond/ConditionsDataLoader.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Conditions data loader creating the example conditions on demand
+  /**
+   *  The conditions of one IOV slot [1+10*n,10*(n+1)] are created for all
+   *  detector elements required by the slice. Calls are serialized by the
+   *  user pool, the registration locks the IOV pool.
+   */
+  class ScalingLoader : public cond::ConditionsDataLoader  {
+  public:
+    /// Slice giving access to the conditions manager
+    ConditionsSlice*                             slice = 0;
+    /// Detector elements by their key
+    map<Condition::detkey_type, DetElement>      elements;
+    /// Number of detector elements, for which conditions were created
+    atomic<long>                                 num_created {0};
+
+  public:
+    /// Standard constructor
+    ScalingLoader(Detector& description, ConditionsManager mgr, const string& nam)
+      : cond::ConditionsDataLoader(description, mgr, nam)  {}
+    /// Collect all detector elements of the tree starting at de
+    void collect(DetElement de)   {
+      elements[de.key()] = de;
+      for(const auto& c : de.children())
+        collect(c.second);
+    }
+    /// Create the missing conditions of the required IOV slot
+    virtual size_t load_many(const IOV&     req_validity,
+                             RequiredItems& work,
+                             LoadedItems&   loaded,
+                             IOV&           combined_validity)  override
+    {
+      long            slot = (req_validity.keyData.first-1)/10;
+      IOV::Key        key(1+slot*10, (slot+1)*10);
+      ConditionsPool* pool = m_mgr.registerIOV(*req_validity.iovType, key);
+      cond::ConditionsIOVPool* iov_pool = m_mgr.iovPool(*req_validity.iovType);
+      set<Condition::detkey_type> detectors;
+      size_t len = loaded.size();
+
+      for(const auto& w : work)
+        detectors.insert(ConditionKey::KeyMaker(w.first).values.det_key);
+      for(Condition::detkey_type det_key : detectors)  {
+        auto i = elements.find(det_key);
+        if ( i != elements.end() )   {
+          DetElement de = (*i).second;
+          bool present = false;  {
+            dd4hep_lock_t lock(iov_pool->lock);
+            present = pool->exists(ConditionKey(de,"temperature").hash).isValid();
+          }
+          if ( !present )  {
+            ConditionsCreator(*slice, *pool, DEBUG)(de, 0);
+            ++num_created;
+          }
+        }
+      }
+      for(const auto& w : work)  {
+        Condition cond;  {
+          dd4hep_lock_t lock(iov_pool->lock);
+          cond = pool->exists(w.first);
+        }
+        if ( cond.isValid() ) loaded[w.first] = cond;
+      }
+      combined_validity.iov_intersection(key);
+      return loaded.size()-len;
+    }
+  };
+
+  /// Factory of the example conditions data loader
+  void* create_loader(Detector& description, int argc, char** argv)   {
+    const char* name = argc>0 ? argv[0] : "ScalingLoader";
+    cond::ConditionsManagerObject* mgr = (cond::ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
+    return new ScalingLoader(description,ConditionsManager(mgr),name);
+  }
+
+  /// Prepare a sequence of slices with changing IOVs in a single thread
+  void prepare_slices(ConditionsManager manager, const IOVType* iov_typ, ConditionsSlice* slice,
+                      int identifier, int num_threads, int num_iov, int num_prepare,
+                      atomic<long>* errors)
+  {
+    for(int i=0; i<num_prepare; ++i)  {
+      // Every thread walks through the IOVs with its own offset:
+      // subsequent slices never share the IOV of the previous one.
+      int  slot = (i*num_threads + identifier) % num_iov;
+      IOV  iov(iov_typ, 1 + slot*10 + (i%10));
+      ConditionsManager::Result res = manager.prepare(iov, *slice);
+      if ( res.missing != 0 )  {
+        printout(ERROR,"Scaling","Thread:%3d %ld missing conditions for IOV:%s",
+                 identifier, res.missing, iov.str().c_str());
+        ++(*errors);
+      }
+    }
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_scaling
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 10, num_threads = 4, num_prepare = 50;
+  bool   arg_error = false, do_load = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-load",argv[i],4) )
+      do_load = true;
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-prepares",argv[i],4) )
+      num_prepare = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_threads <= 0 || num_iov <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_scaling                 \n"
+      "     -input    <string>       Geometry file                                   \n"
+      "     -iovs     <number>       Number of IOV slots in the conditions store.    \n"
+      "     -prepares <number>       Number of slice preparations per thread.        \n"
+      "     -threads  <number>       Maximal number of execution threads.            \n"
+      "     -load                    Create the conditions on demand by a loader.    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
+  ConditionsManager manager = ConditionsManager::from(description);
+  manager["PoolType"]       = "DD4hep_ConditionsLinearPool";
+  manager["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+  manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  if ( do_load ) manager["LoaderType"] = "scaling";
+  manager.initialize();
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+
+  /******************** Populate the conditions store *********************/
+  // Have e.g. 10 run-slices [1,10], [11,20] .... [91,100]
+  ScalingLoader* loader = 0;
+  if ( do_load )  {
+    loader = dynamic_cast<ScalingLoader*>(manager->loader());
+    if ( !loader )
+      except("ConditionsPrepare","++ The conditions data loader is not of type ScalingLoader.");
+    loader->slice = slice.get();
+    loader->collect(description.world());
+  }
+  for(int i=0; i<num_iov && !do_load; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* pool = manager.registerIOV(*iov.iovType, iov.key());
+    int count = Scanner().scan(ConditionsCreator(*slice, *pool, DEBUG),description.world());
+    printout(INFO,"Example", "Setup %d conditions for IOV:%s", count, iov.str().c_str());
+  }
+
+  // ++++++++++++++++++++++++ Prepare slices with increasing number of threads
+  atomic<long> errors(0);
+  double reference = 0e0;
+  for(int nthread=1; nthread <= num_threads; nthread *= 2)  {
+    vector<ConditionsSlice*> slices;
+    vector<thread*> threads;
+    for(int i=0; i<nthread; ++i)
+      slices.push_back(new ConditionsSlice(*slice));
+    if ( loader )  {
+      // Every step loads all conditions again while the other threads select
+      manager.clear();
+      loader->num_created = 0;
+    }
+    TTimeStamp start;
+    for(int i=0; i<nthread; ++i)  {
+      threads.push_back(new thread(prepare_slices, manager, iov_typ, slices[i],
+                                   i, nthread, num_iov, num_prepare, &errors));
+    }
+    for(thread* t : threads)  {
+      t->join();
+      delete t;
+    }
+    TTimeStamp stop;
+    for(ConditionsSlice* s : slices)
+      delete s;
+    double elapsed = stop.AsDouble()-start.AsDouble();
+    double rate    = elapsed > 0e0 ? double(nthread*num_prepare)/elapsed : 0e0;
+    if ( nthread == 1 ) reference = rate;
+    printout(INFO,"Statistics",
+             "+  Threads:%3d  Prepares:%6d  Time:%8.3f sec  Rate:%10.1f Hz  Speedup:%6.2f",
+             nthread, nthread*num_prepare, elapsed, rate,
+             reference > 0e0 ? rate/reference : 0e0);
+    if ( loader )  {
+      printout(INFO,"Statistics","+  Threads:%3d  Conditions of %ld detector elements loaded on demand.",
+               nthread, loader->num_created.load());
+      if ( loader->num_created.load() == 0 )  {
+        printout(ERROR,"Statistics","+  No conditions were loaded: the load path was not used.");
+        ++errors;
+      }
+    }
+  }
+  printout(INFO,"Statistics","+  %s: Num.Errors:%ld", errors.load() ? "FAILED" : "PASSED", errors.load());
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_scaling,condition_example)
+DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_scaling_Loader,create_loader)
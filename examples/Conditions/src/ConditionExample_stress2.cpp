@@ -29,6 +29,9 @@
 #include "TStatistic.h"
 #include "TTimeStamp.h"
 
+// C/C++ include files
+#include <sstream>
+
 using namespace std;
 using namespace dd4hep;
 using namespace dd4hep::ConditionExamples;
@@ -43,23 +46,39 @@ using namespace dd4hep::ConditionExamples;
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
-  int    num_iov = 10;
-  bool   arg_error = false;
+  int    num_iov = 10, num_threads = 0, num_prepare = 1;
+  bool   arg_error = false, incremental = false, stable = false, changing = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
     else if ( 0 == ::strncmp("-iovs",argv[i],4) )
       num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-incremental",argv[i],4) )
+      incremental = true;
+    else if ( 0 == ::strncmp("-prepares",argv[i],4) )
+      num_prepare = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-stable",argv[i],4) )
+      stable = true;
+    else if ( 0 == ::strncmp("-changing",argv[i],4) )
+      changing = true;
     else
       arg_error = true;
   }
-  if ( arg_error || input.empty() )   {
+  if ( arg_error || input.empty() || num_prepare < 1 || num_prepare > 10 )   {
     /// Help printout describing the basic command line interface
     cout <<
       "Usage: -plugin <name> -arg [-arg]                                             \n"
       "     name:   factory name     DD4hep_ConditionExample_stress2                 \n"
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of collision loads to be performed.      \n"
+      "     -threads <number>        Number of threads to compute derived conditions.\n"
+      "     -incremental             Reuse still valid conditions of the last IOV.   \n"
+      "     -prepares <number>       Number of slices prepared within each IOV [1-10]\n"
+      "     -stable                  Only one condition changes from IOV to IOV.     \n"
+      "     -changing                With -stable: the conditions of the world change\n"
+      "                              from IOV to IOV, those of the subdetectors not. \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -69,6 +88,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
 
   /******************** Initialize the conditions manager *****************/
   ConditionsManager manager = installManager(description);
+  manager["ComputeThreads"] = num_threads;
+  manager["IncrementalPrepare"] = incremental;
   const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
   if ( 0 == iov_typ )
     except("ConditionsPrepare","++ Unknown IOV type supplied.");
@@ -88,16 +109,44 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       TTimeStamp start;
       IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
       ConditionsPool*   iov_pool = manager.registerIOV(*iov.iovType, iov.key());
-      // Create conditions with all deltas. Use a generic creator
-      int count = Scanner().scan(ConditionsCreator(*slice, *iov_pool, DEBUG),description.world());
+      int count = 0;
+      if ( !stable )  {
+        // Create conditions with all deltas. Use a generic creator
+        count = Scanner().scan(ConditionsCreator(*slice, *iov_pool, DEBUG),description.world());
+      }
+      else  {
+        // The conditions stay valid for all IOVs. Only one condition,
+        // which no derived condition depends on, changes with every IOV.
+        // With -changing also the conditions of the world change.
+        DetElement world = description.world();
+        if ( i == 0 )  {
+          ConditionsPool* stable_pool = manager.registerIOV(*iov.iovType, IOV::Key(1,num_iov*10));
+          ConditionsCreator creator(*slice, *stable_pool, DEBUG);
+          if ( !changing )
+            count = Scanner().scan(creator,world);
+          else
+            for( const auto& c : world.children() ) count += Scanner().scan(creator,c.second);
+        }
+        if ( changing )  {
+          // Only the derived conditions of the world depend on these
+          count += ConditionsCreator(*slice, *iov_pool, DEBUG)(world,0);
+        }
+        Condition  marker(world.path()+"#iov_marker", "iov_marker");
+        marker.bind<int>() = i;
+        marker->hash = ConditionKey::hashCode(world,"iov_marker");
+        manager.registerUnlocked(*iov_pool, marker);
+        ++count;
+      }
       TTimeStamp stop;
       total_created += count;
       cr_stat.Fill(stop.AsDouble()-start.AsDouble());
       printout(INFO,"Creating", "Setup %-6ld conditions for IOV:%-60s  [%8.3f sec]",
                count, iov.str().c_str(), stop.AsDouble()-start.AsDouble());
-    }   {
+    }
+    // Prepare the slices at distinct points inside the validity of the IOV
+    for(int k=0; k<num_prepare; ++k)  {
       TTimeStamp start;
-      IOV req_iov(iov_typ,i*10+5);
+      IOV req_iov(iov_typ,i*10+1+(k+4)%10);
       // Attach the proper set of conditions to the user pool
       ConditionsManager::Result res = manager.prepare(req_iov,*slice);
       TTimeStamp stop;
@@ -116,6 +165,14 @@ static int condition_example (Detector& description, int argc, char** argv)  {
            acc_stat.GetName(), acc_stat.GetMean(), acc_stat.GetMeanErr(), acc_stat.GetRMS(), acc_stat.GetN());
   printout(INFO,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
            total.total(), total.selected, total.loaded, total.computed, total.missing, total_created);
+  size_t num_by_thread = 0;
+  stringstream by_thread;
+  for( size_t i = 0; i < total.computed_by_thread.size(); ++i )  {
+    by_thread << " T" << i << ":" << total.computed_by_thread[i];
+    num_by_thread += total.computed_by_thread[i];
+  }
+  printout(num_by_thread == total.computed ? INFO : ERROR,"Statistics",
+           "+  Computed per thread:%s [Sum:%ld]", by_thread.str().c_str(), num_by_thread);
   printout(INFO,"Statistics","+=========================================================================");
   // All done.
   return 1;